@@ -1,8 +1,21 @@
 #ifndef __DSO_CALENDAR_GENINC_HPP__
 #define __DSO_CALENDAR_GENINC_HPP__
 
+#include "date_batch.hpp"
+#include "datetime_column.hpp"
+#include "datetime_literals.hpp"
 #include "datetime_utc.hpp"
+#include "day_iterator.hpp"
+#include "diff_batch.hpp"
+#include "double_double.hpp"
+#include "epoch_index.hpp"
+#include "epoch_range.hpp"
+#include "epoch_snap.hpp"
+#include "epoch_sort.hpp"
+#include "gnss_time.hpp"
+#include "linear_time.hpp"
 #include "tpdate.hpp"
+#include "tpdate_column.hpp"
 #include "tpdate2.hpp"
 
 namespace dso {
@@ -0,0 +1,155 @@
+/** @file
+ *
+ * A precomputed, MJD-indexed calendar table. For MJDs within a (configurable)
+ * window, the calendar date and the day of year are stored as packed 32-bit
+ * records, so that transforming an MJD to a calendar date (or year and day
+ * of year) is one indexed load.
+ *
+ * The default window spans years 1980 to 2050 (i.e. 25933 days, ~101 KiB),
+ * where most epochs of interest fall; the table is only built on first use.
+ * modified_julian_day::to_ymd and modified_julian_day::to_ydoy use the table
+ * currently in use (see calendar_table::current) if the MJD is within its
+ * window, and fall back to arithmetic otherwise.
+ *
+ * Like leap second tables, calendar tables are immutable once constructed;
+ * setting a new window atomically replaces the table in use, and replaced
+ * tables are never freed (so that any snapshot taken remains valid).
+ */
+
+#ifndef __DSO_DATETIME_CALENDAR_TABLE_HPP__
+#define __DSO_DATETIME_CALENDAR_TABLE_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace dso {
+
+class CalendarTable;
+namespace calendar_table::detail {
+const CalendarTable *install_default() noexcept;
+} /* namespace calendar_table::detail */
+
+/** @brief An immutable, MJD-indexed table of calendar dates.
+ *
+ * Each record packs (from the least significant bit): the day of month (5
+ * bits), the month (4 bits), the day of year (9 bits) and the year, as an
+ * offset from the year of the first MJD in the table (14 bits).
+ */
+class CalendarTable {
+public:
+  /** Max number of days (i.e. records) in a table (~2700 years) */
+  static constexpr const int MAX_DAYS = 1'000'000;
+
+  /** @brief Constructor, given the (inclusive) window of MJDs.
+   *
+   * If \p last_mjd < \p first_mjd, the table is empty, i.e. no MJD is
+   * within its window.
+   *
+   * @throw std::invalid_argument if the window holds more than MAX_DAYS
+   *        days.
+   */
+  CalendarTable(int first_mjd, int last_mjd);
+
+  /* tables are referenced by (snapshot) pointers; never copied */
+  CalendarTable(const CalendarTable &) = delete;
+  CalendarTable &operator=(const CalendarTable &) = delete;
+
+  /** @brief Check if an MJD is within the window of the table. */
+  bool contains(int mjd) const noexcept {
+    return static_cast<std::uint32_t>(mjd - m_first_mjd) <
+           m_size;
+  }
+
+  /** @brief The (packed) record of an MJD; must be within the window. */
+  std::uint32_t record(int mjd) const noexcept {
+    return m_records[mjd - m_first_mjd];
+  }
+
+  /** @brief Year of a record */
+  int year(std::uint32_t r) const noexcept {
+    return m_first_year + static_cast<int>(r >> 18);
+  }
+  /** @brief Day of year of a record */
+  static int doy(std::uint32_t r) noexcept { return (r >> 9) & 0x1FF; }
+  /** @brief Month of a record */
+  static int month(std::uint32_t r) noexcept { return (r >> 5) & 0xF; }
+  /** @brief Day of month of a record */
+  static int dom(std::uint32_t r) noexcept { return r & 0x1F; }
+
+  /** @brief First MJD in the table's window */
+  int first_mjd() const noexcept { return m_first_mjd; }
+  /** @brief Last MJD in the table's window */
+  int last_mjd() const noexcept {
+    return m_first_mjd + static_cast<int>(m_size) - 1;
+  }
+
+private:
+  /** @brief Constructor for a (non-empty) window, with the records stored
+   * in \p buf, i.e. an array of (at least) last_mjd - first_mjd + 1
+   * elements that outlives the table. Does not allocate; used for the
+   * default table.
+   */
+  CalendarTable(int first_mjd, int last_mjd, std::uint32_t *buf) noexcept;
+  friend const CalendarTable *
+  calendar_table::detail::install_default() noexcept;
+
+  /** @brief Fill the records of the window in \p buf */
+  void fill(int last_mjd, std::uint32_t *buf) noexcept;
+
+  /** records, if allocated by the table (else empty) */
+  std::vector<std::uint32_t> m_storage;
+  /** the records, i.e. m_storage or an external buffer */
+  const std::uint32_t *m_records;
+  std::uint32_t m_size;
+  int m_first_mjd;
+  int m_first_year;
+}; /* class CalendarTable */
+
+namespace calendar_table {
+
+/** First MJD of the default window, i.e. 1980/01/01 */
+constexpr const int DEFAULT_FIRST_MJD = 44'239;
+/** Last MJD of the default window, i.e. 2050/12/31 */
+constexpr const int DEFAULT_LAST_MJD = 70'171;
+
+namespace detail {
+/** @brief The table currently in use; nullptr until first use. */
+extern std::atomic<const CalendarTable *> installed;
+
+/** @brief Build and install the table for the default window (if no other
+ * table is installed yet) and return the table in use.
+ *
+ * The default table's records are held in static storage, hence this does
+ * not allocate.
+ */
+const CalendarTable *install_default() noexcept;
+} /* namespace detail */
+
+/** @brief Get a snapshot of the calendar table currently in use.
+ *
+ * This is lock-free (i.e. one atomic load), except for the very first call
+ * which builds the table for the default window.
+ */
+inline const CalendarTable *current() noexcept {
+  const CalendarTable *t = detail::installed.load(std::memory_order_acquire);
+  return t ? t : detail::install_default();
+}
+
+/** @brief Build a table for the given (inclusive) window of MJDs and install
+ * it, replacing the one in use.
+ *
+ * Passing \p last_mjd < \p first_mjd installs an empty table, i.e. disables
+ * table lookups.
+ *
+ * @return A pointer to the (now current) table.
+ * @throw std::invalid_argument if the window is too large (see
+ *        CalendarTable::MAX_DAYS); the current table is left untouched.
+ */
+const CalendarTable *set_window(int first_mjd, int last_mjd);
+
+} /* namespace calendar_table */
+
+} /* namespace dso */
+
+#endif
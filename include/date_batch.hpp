@@ -0,0 +1,161 @@
+/** @file
+ *
+ * Batch (i.e. array) conversions between integral dates. These act on plain
+ * integral arrays, laid out as a "structure of arrays" (e.g. one array for
+ * years, one for months, ...), and are meant for transforming whole columns
+ * of epochs at once.
+ *
+ * Where possible (i.e. AVX2 or AVX-512 is available at compile-time), the
+ * conversions are vectorized; integer divisions by constants are replaced by
+ * (exact, in the domain considered) multiply-shift sequences. Results are
+ * always identical to the ones of the corresponding scalar routines.
+ */
+
+#ifndef __DSO_DATETIME_DATE_BATCH_HPP__
+#define __DSO_DATETIME_DATE_BATCH_HPP__
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace dso {
+
+/** @brief MJD range where batch conversions are vectorized.
+ *
+ * MJDs out of this range are still transformed, using the scalar routines.
+ * This covers dates from (approximately) 4713 BC to 2.7 million AD.
+ */
+constexpr const int BATCH_MJD2YMD_MIN = -2'400'000;
+constexpr const int BATCH_MJD2YMD_MAX = 1'000'000'000;
+
+/** @brief MJD range where batch conversions to year/day-of-year are
+ * vectorized (i.e. dates after 1901/01/01).
+ */
+constexpr const int BATCH_MJD2YDOY_MIN = 15'385;
+constexpr const int BATCH_MJD2YDOY_MAX = 1'000'000'000;
+
+/** @brief Batch transformation of (integral) MJDs to calendar dates.
+ *
+ * For every MJD in the input array, compute year, month and day of month.
+ * Results are identical to core::mjd2ymd (i.e. modified_julian_day::to_ymd).
+ *
+ * @param[in]  mjd   Array of MJDs, of size \p n
+ * @param[out] iyear Array of size \p n; at output, the years
+ * @param[out] imon  Array of size \p n; at output, the months in [1,12]
+ * @param[out] idom  Array of size \p n; at output, the days of month
+ * @param[in]  n     Number of elements in the arrays
+ */
+void mjd2ymd_batch(const int *mjd, int *iyear, int *imon, int *idom,
+                   std::size_t n) noexcept;
+
+/** @brief Batch transformation of (integral) MJDs to year and day of year.
+ *
+ * For every MJD in the input array, compute year and day of year. Results
+ * are identical to modified_julian_day::to_ydoy.
+ *
+ * @param[in]  mjd   Array of MJDs, of size \p n
+ * @param[out] iyear Array of size \p n; at output, the years
+ * @param[out] idoy  Array of size \p n; at output, the days of year
+ * @param[in]  n     Number of elements in the arrays
+ */
+void mjd2ydoy_batch(const int *mjd, int *iyear, int *idoy,
+                    std::size_t n) noexcept;
+
+/** @brief Range of years accepted by the batch calendar to MJD
+ * conversions (i.e. ymd_to_mjd_batch and ydoy_to_mjd_batch).
+ *
+ * Dates with years out of this range are marked as invalid.
+ */
+constexpr const int BATCH_CAL_YEAR_MIN = -4'799;
+constexpr const int BATCH_CAL_YEAR_MAX = 5'000'000;
+
+/** @brief Number of 64-bit words needed to hold a validity bitmask for \p n
+ * elements.
+ */
+constexpr std::size_t batch_mask_words(std::size_t n) noexcept {
+  return (n + 63) / 64;
+}
+
+/** @brief Check the validity bit of element \p i in a bitmask, as filled by
+ * ymd_to_mjd_batch or ydoy_to_mjd_batch.
+ */
+constexpr bool batch_mask_test(const std::uint64_t *valid,
+                               std::size_t i) noexcept {
+  return (valid[i / 64] >> (i % 64)) & 1;
+}
+
+/** @brief Fill word \p w of a bitmask for \p n elements.
+ *
+ * Bit (i % 64) of mask[w] is set if pred(i) is true, for every element i in
+ * [64 * w, min(64 * w + 64, n)); remaining bits are cleared.
+ *
+ * @return The number of bits set in mask[w]
+ */
+template <typename Pred>
+inline std::size_t batch_mask_fill(std::uint64_t *mask, std::size_t w,
+                                   std::size_t n, Pred &&pred) noexcept {
+  const std::size_t start = w * 64;
+  const std::size_t end = (start + 64 < n) ? start + 64 : n;
+  std::uint64_t bits = 0;
+  for (std::size_t i = start; i < end; i++)
+    bits |= static_cast<std::uint64_t>(static_cast<bool>(pred(i)))
+            << (i - start);
+  mask[w] = bits;
+  return std::bitset<64>(bits).count();
+}
+
+/** @brief Batch validation and transformation of calendar dates to MJDs.
+ *
+ * For every date (year, month, day of month) in the input arrays, check if
+ * the date is valid and compute the corresponding MJD. No exceptions are
+ * thrown; instead, bit i of the \p valid bitmask is set if the i-th date is
+ * valid, and cleared otherwise. For valid dates, results are identical to
+ * core::cal2mjd; for invalid ones, the MJD is set to 0.
+ *
+ * A date is valid if its year is within [BATCH_CAL_YEAR_MIN,
+ * BATCH_CAL_YEAR_MAX], the month is within [1,12] and the day of month is
+ * within [1, days in month].
+ *
+ * @param[in]  iyear Array of years, of size \p n
+ * @param[in]  imon  Array of months, of size \p n
+ * @param[in]  idom  Array of days of month, of size \p n
+ * @param[out] mjd   Array of size \p n; at output, the MJDs
+ * @param[out] valid Array of batch_mask_words(n) words; at output, the
+ *                   validity bitmask
+ * @param[in]  n     Number of elements in the arrays
+ * @return The number of invalid dates
+ */
+std::size_t ymd_to_mjd_batch(const int *iyear, const int *imon,
+                             const int *idom, int *mjd, std::uint64_t *valid,
+                             std::size_t n) noexcept;
+
+/** @brief Batch validation and transformation of year/day of year dates to
+ * MJDs.
+ *
+ * For every date (year, day of year) in the input arrays, check if the date
+ * is valid and compute the corresponding MJD. No exceptions are thrown;
+ * instead, bit i of the \p valid bitmask is set if the i-th date is valid,
+ * and cleared otherwise. For invalid dates, the MJD is set to 0.
+ *
+ * A date is valid if its year is within [BATCH_CAL_YEAR_MIN,
+ * BATCH_CAL_YEAR_MAX] and the day of year is within [1, 365] or [1, 366]
+ * for leap years.
+ *
+ * @note The MJDs are computed in the (proleptic) Gregorian calendar; they
+ *       are identical to the ones of core::ydoy2mjd within [1900, 2100],
+ *       i.e. the range of validity of the latter.
+ *
+ * @param[in]  iyear Array of years, of size \p n
+ * @param[in]  idoy  Array of days of year, of size \p n
+ * @param[out] mjd   Array of size \p n; at output, the MJDs
+ * @param[out] valid Array of batch_mask_words(n) words; at output, the
+ *                   validity bitmask
+ * @param[in]  n     Number of elements in the arrays
+ * @return The number of invalid dates
+ */
+std::size_t ydoy_to_mjd_batch(const int *iyear, const int *idoy, int *mjd,
+                              std::uint64_t *valid, std::size_t n) noexcept;
+
+} /* namespace dso */
+
+#endif
@@ -24,9 +24,23 @@
 #ifndef __DSO_DATE_INTEGRAL_TYPES_HPP__
 #define __DSO_DATE_INTEGRAL_TYPES_HPP__
 
+#include "calendar_table.hpp"
 #include "core/fundamental_calendar_utils.hpp"
 #include "core/fundamental_types_generic_utilities.hpp"
+#include "leap_seconds.hpp"
 #include <array>
+#include <cassert>
+#include <cstddef>
+
+/* In header-only mode, functions otherwise compiled in the library are
+ * defined in the headers, as constexpr (see
+ * core/date_integral_types_impl.hpp).
+ */
+#ifdef DATETIME_HEADER_ONLY
+#define DATETIME_CONSTEXPR constexpr
+#else
+#define DATETIME_CONSTEXPR
+#endif
 
 namespace dso {
 
@@ -42,6 +56,9 @@ class ydoy_date;
 
 /** @brief Number of leap seconds up to now; latest: 2017/01/01 */
 constexpr const int TOTAL_LEAP_SEC_INSERTION_DATES = 28;
+static_assert(core::builtin_leap_seconds.size() ==
+                  TOTAL_LEAP_SEC_INSERTION_DATES,
+              "Invalid number of leap second insertion days!");
 
 /** @brief For a given UTC date, calculate delta(AT) = TAI-UTC.
  *
@@ -65,8 +82,8 @@ constexpr const int TOTAL_LEAP_SEC_INSERTION_DATES = 28;
  * @param[in] im The month
  * @return TAI-UTC up to the datetime (\p iy, \p im, 23:59:59)
  */
-int dat(year iy, month im) noexcept;
-int dat(const ymd_date &ymd) noexcept;
+constexpr int dat(year iy, month im) noexcept;
+constexpr int dat(const ymd_date &ymd) noexcept;
 
 /** @brief For a given UTC date, calculate delta(AT) = TAI-UTC.
  *
@@ -86,7 +103,7 @@ int dat(const ymd_date &ymd) noexcept;
  * @param[in] mjd The date as MJD
  * @return TAI-UTC up to the datetime (\p mjd, 23:59:59)
  */
-int dat(modified_julian_day mjd) noexcept;
+constexpr int dat(modified_julian_day mjd) noexcept;
 
 /** @brief For a given UTC date, calculate delta(AT) = TAI-UTC.
  *
@@ -110,7 +127,34 @@ int dat(modified_julian_day mjd) noexcept;
  *            a day which ends with a leap second, then it will be 1.
  * @return TAI-UTC up to the datetime (\p mjd, 23:59:59)
  */
-int dat(modified_julian_day mjd, int &extra_sec_in_day) noexcept;
+constexpr int dat(modified_julian_day mjd, int &extra_sec_in_day) noexcept;
+
+/** @brief For an array of UTC dates, calculate delta(AT) = TAI-UTC.
+ *
+ * Batch version of dso::dat(modified_julian_day). ΔAT is computed for every
+ * (integral) MJD in the input array, via a (vectorized, where AVX2/SSE2 is
+ * available) compare-and-count against the ΔAT changes of the leap second
+ * table in use; there is no per-element branching.
+ *
+ * @param[in]  mjd Array of (integral) MJDs, of size \p n
+ * @param[out] out Array of size \p n; at output, the ΔAT value for each MJD
+ * @param[in]  n   Number of elements in the arrays
+ */
+void dat_batch(const int *mjd, int *out, std::size_t n) noexcept;
+
+/** @brief For an array of UTC dates, calculate delta(AT) = TAI-UTC and the
+ * number of extra seconds in day.
+ *
+ * Batch version of dso::dat(modified_julian_day, int&); see
+ * dso::dat_batch(const int *, int *, std::size_t).
+ *
+ * @param[in]  mjd   Array of (integral) MJDs, of size \p n
+ * @param[out] out   Array of size \p n; at output, the ΔAT value for each MJD
+ * @param[out] extra Array of size \p n; at output, the extra seconds in day
+ *                   for each MJD (i.e. 1 if the day ends with a leap second)
+ * @param[in]  n     Number of elements in the arrays
+ */
+void dat_batch(const int *mjd, int *out, int *extra, std::size_t n) noexcept;
 
 /** @brief A wrapper class for years.
  *
@@ -283,7 +327,7 @@ public:
    * @throw An std::invalid_argument exception is thrown if a) no
    *    match is found, or b) the input string is too short.
    */
-  explicit month(const char *str);
+  explicit DATETIME_CONSTEXPR month(const char *str);
 
   /** Get the month as month::underlying_type */
   constexpr underlying_type as_underlying_type() const noexcept {
@@ -299,7 +343,7 @@ public:
    * @return Returns a pointer to the class's (static member) short_names
    *         string array.
    */
-  const char *short_name() const;
+  DATETIME_CONSTEXPR const char *short_name() const;
 
   /** Return the corresponding long name (i.e. normal month name) e.g.
    * "January".
@@ -311,7 +355,7 @@ public:
    * @return Returns a pointer to the class's (static member) month::long_names
    *         string array.
    */
-  const char *long_name() const;
+  DATETIME_CONSTEXPR const char *long_name() const;
 
   /** Check if the month is within the interval [1,12]. */
   constexpr bool is_valid() const noexcept {
@@ -619,7 +663,7 @@ public:
    * (via ydoy_data::isvalid()) and then constrcuct the corresponding date as
    * ymd_date instance.
    */
-  ymd_date(const ydoy_date &ydoy);
+  DATETIME_CONSTEXPR ymd_date(const ydoy_date &ydoy);
 
   /** @brief Check if the date is a valid calendar date.
    *
@@ -646,7 +690,7 @@ public:
    * because an invalid ymd_date can result in a seamingly valid ydoy_date
    * (e.g. constructing a 29/2 date on a non-leap year).
    */
-  ydoy_date to_ydoy() const;
+  DATETIME_CONSTEXPR ydoy_date to_ydoy() const;
 
   /** get/set year */
   constexpr year &yr() noexcept { return __year; }
@@ -690,7 +734,7 @@ public:
    * In case the input argument ymd is not a valid date, the constructor
    * will throw.
    */
-  ydoy_date(const ymd_date &ymd)
+  DATETIME_CONSTEXPR ydoy_date(const ymd_date &ymd)
       : __year(ymd.yr()), __doy(ymd.to_ydoy().dy()) {}
 
   /** @brief Check if the date is a valid calendar date.
@@ -703,7 +747,7 @@ public:
    *
    * No validation test performed on the calling instance.
    */
-  ymd_date to_ymd() const noexcept;
+  DATETIME_CONSTEXPR ymd_date to_ymd() const noexcept;
 
   /** operator '==' for ydoy_date instances */
   bool operator==(const ydoy_date &d) const noexcept {
@@ -716,9 +760,9 @@ public:
   }
 
   /** get/set year */
-  year &yr() noexcept { return __year; }
+  constexpr year &yr() noexcept { return __year; }
   /** get/set day of year */
-  day_of_year &dy() noexcept { return __doy; }
+  constexpr day_of_year &dy() noexcept { return __doy; }
   /** get year */
   constexpr year yr() const noexcept { return __year; }
   /** get day of year */
@@ -735,24 +779,22 @@ namespace core {
  * Note that the \p mjd parameter, should represent an integral day, i.e. no
  * fractional part (of day) is considered.
  *
+ * The conversion is performed via the Fliegel & Van Flandern algorithm
+ * (mjd2ymd_fvf), or, if DATETIME_EAF_CALENDAR is defined, via the Euclidean
+ * affine algorithm (mjd2ymd_eaf).
+ *
  * @param[in] mjd The MJDay
  * @param[out] iyear The year
  * @param[out] imonth The month
  * @param[out] idom The day of month
  */
 constexpr ymd_date mjd2ymd(long mjd) noexcept {
-  long l = mjd + (68569L + 2400000L + 1);
-  long n = (4L * l) / 146097L;
-  l -= (146097L * n + 3L) / 4L;
-  long i = (4000L * (l + 1L)) / 1461001L;
-  l -= (1461L * i) / 4L - 31L;
-  long k = (80L * l) / 2447L;
-
-  int idom = l - (2447L * k) / 80L;
-  l = k / 11L;
-  int imonth = k + 2L - 12L * l;
-  int iyear = 100L * (n - 49L) + i + l;
-
+  int iyear = 0, imonth = 0, idom = 0;
+#ifdef DATETIME_EAF_CALENDAR
+  mjd2ymd_eaf(mjd, iyear, imonth, idom);
+#else
+  mjd2ymd_fvf(mjd, iyear, imonth, idom);
+#endif
   return ymd_date(year(iyear), month(imonth), day_of_month(idom));
 }
 } /* namespace core */
@@ -935,10 +977,13 @@ public:
    * @warning No check if performed to see if the resulting day of year is
    *          valid! If you want to be sure, check the returned value(s).
    *
+   * If the MJD is within the window of the calendar table currently in use
+   * (see calendar_table::current), the date is read off the table.
+   *
    * @see "Remondi Date/Time Algorithms",
    * http://www.ngs.noaa.gov/gps-toolbox/bwr-02.htm
    */
-  ydoy_date to_ydoy() const noexcept;
+  DATETIME_CONSTEXPR ydoy_date to_ydoy() const noexcept;
 
   /** @brief Convert a Modified Julian Day to Calendar Date.
    *
@@ -948,29 +993,34 @@ public:
    *          month is valid! If you want to be sure, check the returned
    *          value(s).
    *
+   * At run-time, if the MJD is within the window of the calendar table
+   * currently in use (see calendar_table::current), the date is read off
+   * the table; else, it is computed via core::mjd2ymd.
+   *
    * @see "Remondi Date/Time Algorithms",
    *      http://www.ngs.noaa.gov/gps-toolbox/bwr-02.htm
    */
-  constexpr ymd_date to_ymd() const noexcept { return core::mjd2ymd(m_mjd); }
+  constexpr ymd_date to_ymd() const noexcept {
+    if (!core::is_constant_evaluated()) {
+      const CalendarTable *t = calendar_table::current();
+      if (t->contains(m_mjd)) {
+        const std::uint32_t r = t->record(m_mjd);
+        return ymd_date(year(t->year(r)), month(CalendarTable::month(r)),
+                        day_of_month(CalendarTable::dom(r)));
+      }
+    }
+    return core::mjd2ymd(m_mjd);
+  }
 
-  /** @brief Check if given MJDay is on a leap insertion day. */
+  /** @brief Check if given MJDay is on a leap insertion day.
+   *
+   * At compile-time the built-in leap second table is used; at run-time, the
+   * table currently in use (see leap_seconds::current).
+   */
   constexpr int is_leap_insertion_day() const noexcept {
-    constexpr const std::array<int, 28> changes = {
-        /* MJDs when leap seconds change */
-        41317 - 1, 41499 - 1, 41683 - 1, 42048 - 1, 42413 - 1, 42778 - 1,
-        43144 - 1, 43509 - 1, 43874 - 1, 44239 - 1, 44786 - 1, 45151 - 1,
-        45516 - 1, 46247 - 1, 47161 - 1, 47892 - 1, 48257 - 1, 48804 - 1,
-        49169 - 1, 49534 - 1, 50083 - 1, 50630 - 1, 51179 - 1, 53736 - 1,
-        54832 - 1, 56109 - 1, 57204 - 1, 57754 - 1};
-    static_assert(changes.size() == TOTAL_LEAP_SEC_INSERTION_DATES,
-                  "Invalid number of leap second insertion days!");
-    for (int i = changes.size() - 1; i >= 0; i--) {
-      if (m_mjd == changes[i])
-        return 1;
-      if (m_mjd > changes[i])
-        return 0;
-    }
-    return 0;
+    if (core::is_constant_evaluated())
+      return core::builtin_is_leap_insertion_day(m_mjd);
+    return leap_seconds::current()->is_leap_insertion_day(m_mjd);
   }
 
 private:
@@ -978,6 +1028,42 @@ private:
   underlying_type m_mjd;
 }; /* modified_julian_day */
 
+/* Definitions of the dat() family; these are constexpr, so that ΔAT values
+ * can be computed at compile-time (using the built-in leap second table).
+ * At run-time, the leap second table in use is consulted, via its dense
+ * (MJD-indexed) table.
+ */
+constexpr int dat(year iy, month im) noexcept {
+  assert(iy >= year(1972));
+  if (core::is_constant_evaluated())
+    return core::builtin_dat_calendar(iy.as_underlying_type(),
+                                      im.as_underlying_type());
+  return leap_seconds::current()->dat_calendar(iy.as_underlying_type(),
+                                               im.as_underlying_type());
+}
+
+constexpr int dat(const ymd_date &ymd) noexcept {
+  return dat(ymd.yr(), ymd.mn());
+}
+
+constexpr int dat(modified_julian_day mjd) noexcept {
+  if (core::is_constant_evaluated())
+    return core::builtin_dat(mjd.as_underlying_type());
+  return leap_seconds::current()->dat(mjd.as_underlying_type());
+}
+
+constexpr int dat(modified_julian_day mjd, int &extra_sec_in_day) noexcept {
+  assert(mjd >= modified_julian_day(41317));
+  if (core::is_constant_evaluated())
+    return core::builtin_dat(mjd.as_underlying_type(), extra_sec_in_day);
+  return leap_seconds::current()->dat(mjd.as_underlying_type(),
+                                      extra_sec_in_day);
+}
+
 } /* namespace dso */
 
+#ifdef DATETIME_HEADER_ONLY
+#include "core/date_integral_types_impl.hpp"
+#endif
+
 #endif
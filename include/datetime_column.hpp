@@ -0,0 +1,300 @@
+/** @file
+ *
+ * Define a datetime_column<S> container, i.e. a structure-of-arrays
+ * collection of datetime<S> epochs. MJDs and seconds of day are stored in
+ * two separate (64-byte aligned) arrays, so that bulk operations on the
+ * epochs (addition of seconds, differences to a reference epoch, range
+ * filtering, min/max and normalization) are simple loops over contiguous
+ * integers, which the compiler vectorizes.
+ *
+ * Elements are accessed as datetime<S> values, i.e. operator[] returns a
+ * proxy that converts to/from datetime<S>; the raw arrays are also
+ * available (mjd_data and sec_data).
+ *
+ * Example:
+ * dso::datetime_column<dso::nanoseconds> col(epochs.data(), epochs.size());
+ * col.add(dso::nanoseconds(19'000'000'000L));
+ * std::vector<double> dt(col.size());
+ * col.diff(t0, dt.data());
+ */
+
+#ifndef __DSO_DATETIME_COLUMN_HPP__
+#define __DSO_DATETIME_COLUMN_HPP__
+
+#include "core/aligned_allocator.hpp"
+#include "date_batch.hpp"
+#include "dtdatetime.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dso {
+
+/** @brief A structure-of-arrays container of datetime<S> epochs.
+ *
+ * Public methods keep the elements normalized, i.e. seconds of day in the
+ * range [0, S::max_in_day). Only when the raw arrays are modified (via
+ * mjd_data and sec_data) should users call normalize.
+ *
+ * @tparam S Any class of 'second type', i.e. any class S that has a (static)
+ *           member variable S::is_of_sec_type set to true.
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+class datetime_column {
+public:
+  using SecIntType = typename S::underlying_type;
+  using value_type = datetime<S>;
+
+  /** @brief Proxy to an element, converting to/from datetime<S> */
+  class reference {
+  public:
+    /** @brief The element, as a datetime<S> */
+    datetime<S> value() const noexcept {
+      return datetime<S>::non_normalize_construct(
+          modified_julian_day(*m_mjd), S(*m_sec));
+    }
+    operator datetime<S>() const noexcept { return value(); }
+    reference &operator=(const datetime<S> &d) noexcept {
+      *m_mjd = d.imjd().as_underlying_type();
+      *m_sec = d.sec().as_underlying_type();
+      return *this;
+    }
+    reference &operator=(const reference &r) noexcept {
+      return this->operator=(r.value());
+    }
+    reference(const reference &) noexcept = default;
+
+  private:
+    friend class datetime_column;
+    reference(int *mjd, SecIntType *sec) noexcept : m_mjd(mjd), m_sec(sec) {}
+    int *m_mjd;
+    SecIntType *m_sec;
+  }; /* class reference */
+
+  /** @brief Empty column */
+  datetime_column() noexcept = default;
+
+  /** @brief Column of n elements, all set to \p d */
+  explicit datetime_column(std::size_t n,
+                           const datetime<S> &d = datetime<S>())
+      : m_mjd(n, d.imjd().as_underlying_type()),
+        m_sec(n, d.sec().as_underlying_type()) {}
+
+  /** @brief Column from an array of n datetime<S> instances */
+  datetime_column(const datetime<S> *d, std::size_t n) : m_mjd(n), m_sec(n) {
+    for (std::size_t i = 0; i < n; i++) {
+      m_mjd[i] = d[i].imjd().as_underlying_type();
+      m_sec[i] = d[i].sec().as_underlying_type();
+    }
+  }
+
+  /** @brief Copy the elements to an array of (at least) size() datetime<S>
+   * instances.
+   */
+  void to_datetimes(datetime<S> *d) const noexcept {
+    for (std::size_t i = 0; i < size(); i++)
+      d[i] = (*this)[i];
+  }
+
+  /** @brief Number of elements */
+  std::size_t size() const noexcept { return m_mjd.size(); }
+  /** @brief Check if there are no elements */
+  bool empty() const noexcept { return m_mjd.empty(); }
+  void reserve(std::size_t n) {
+    m_mjd.reserve(n);
+    m_sec.reserve(n);
+  }
+  void resize(std::size_t n, const datetime<S> &d = datetime<S>()) {
+    m_mjd.resize(n, d.imjd().as_underlying_type());
+    m_sec.resize(n, d.sec().as_underlying_type());
+  }
+  void clear() noexcept {
+    m_mjd.clear();
+    m_sec.clear();
+  }
+  void push_back(const datetime<S> &d) {
+    m_mjd.push_back(d.imjd().as_underlying_type());
+    m_sec.push_back(d.sec().as_underlying_type());
+  }
+
+  /** @brief Element \p i, as a datetime<S> */
+  datetime<S> operator[](std::size_t i) const noexcept {
+    return datetime<S>::non_normalize_construct(
+        modified_julian_day(m_mjd[i]), S(m_sec[i]));
+  }
+  /** @brief Element \p i, as a proxy (assignable from datetime<S>) */
+  reference operator[](std::size_t i) noexcept {
+    return reference(m_mjd.data() + i, m_sec.data() + i);
+  }
+
+  /** @brief Raw array of MJDs */
+  int *mjd_data() noexcept { return m_mjd.data(); }
+  const int *mjd_data() const noexcept { return m_mjd.data(); }
+  /** @brief Raw array of seconds of day (in units of S) */
+  SecIntType *sec_data() noexcept { return m_sec.data(); }
+  const SecIntType *sec_data() const noexcept { return m_sec.data(); }
+
+  /** @brief Normalize all elements, i.e. move whole days from the seconds
+   * to the MJDs, so that seconds of day are in [0, S::max_in_day).
+   */
+  void normalize() noexcept {
+    int *__restrict__ mjd = m_mjd.data();
+    SecIntType *__restrict__ sec = m_sec.data();
+    constexpr const SecIntType F = S::max_in_day;
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++) {
+      SecIntType days = sec[i] / F;
+      SecIntType s = sec[i] - days * F;
+      const SecIntType neg = (s < 0);
+      mjd[i] += static_cast<int>(days - neg);
+      sec[i] = s + neg * F;
+    }
+  }
+
+  /** @brief Add (algebraically) the same amount of seconds to all elements.
+   */
+  void add(S s) noexcept {
+    SecIntType *__restrict__ sec = m_sec.data();
+    const SecIntType ds = s.as_underlying_type();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      sec[i] += ds;
+    normalize();
+  }
+
+  /** @brief Add (algebraically) seconds to each element, i.e. \p s[i] to
+   * element i; \p s must hold (at least) size() elements.
+   */
+  void add(const S *s) noexcept {
+    SecIntType *__restrict__ sec = m_sec.data();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      sec[i] += s[i].as_underlying_type();
+    normalize();
+  }
+
+  /** @brief Difference of each element to a reference epoch, i.e.
+   * (*this)[i] - ref, in fractional seconds.
+   *
+   * @warning Does not take into account leap seconds.
+   */
+  void diff(const datetime<S> &ref, double *__restrict__ dt) const noexcept {
+    const int *__restrict__ mjd = m_mjd.data();
+    const SecIntType *__restrict__ sec = m_sec.data();
+    const int rmjd = ref.imjd().as_underlying_type();
+    const SecIntType rsec = ref.sec().as_underlying_type();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      dt[i] = static_cast<double>(mjd[i] - rmjd) * SEC_PER_DAY +
+              static_cast<double>(sec[i] - rsec) * S::sec_inv_factor();
+  }
+
+  /** @brief Difference of each element to a reference epoch, i.e.
+   * (*this)[i] - ref, in units of S.
+   *
+   * @warning The results may overflow for differences larger than
+   *          dso::max_days_allowed<S>() days.
+   */
+  void diff(const datetime<S> &ref, S *dt) const noexcept {
+    const int *__restrict__ mjd = m_mjd.data();
+    const SecIntType *__restrict__ sec = m_sec.data();
+    const int rmjd = ref.imjd().as_underlying_type();
+    const SecIntType rsec = ref.sec().as_underlying_type();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      dt[i] = S(static_cast<SecIntType>(mjd[i] - rmjd) * S::max_in_day +
+                (sec[i] - rsec));
+  }
+
+  /** @brief Mark elements within the range [\p lo, \p hi).
+   *
+   * @param[in]  lo   Start of the range (inclusive)
+   * @param[in]  hi   End of the range (exclusive)
+   * @param[out] mask Array of batch_mask_words(size()) words; at output,
+   *                  bit i is set if element i is within the range (use
+   *                  batch_mask_test to query)
+   * @return The number of elements within the range
+   */
+  std::size_t filter(const datetime<S> &lo, const datetime<S> &hi,
+                     std::uint64_t *mask) const noexcept {
+    const int *mjd = m_mjd.data();
+    const SecIntType *sec = m_sec.data();
+    const int lmjd = lo.imjd().as_underlying_type();
+    const SecIntType lsec = lo.sec().as_underlying_type();
+    const int hmjd = hi.imjd().as_underlying_type();
+    const SecIntType hsec = hi.sec().as_underlying_type();
+    const std::size_t n = size();
+    const auto within = [=](std::size_t i) noexcept {
+      const bool ge = (mjd[i] > lmjd) | ((mjd[i] == lmjd) & (sec[i] >= lsec));
+      const bool lt = (mjd[i] < hmjd) | ((mjd[i] == hmjd) & (sec[i] < hsec));
+      return ge & lt;
+    };
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < batch_mask_words(n); w++)
+      count += batch_mask_fill(mask, w, n, within);
+    return count;
+  }
+
+  /** @brief Collect the elements marked in \p mask (e.g. as filled by
+   * filter) to a new column.
+   */
+  datetime_column select(const std::uint64_t *mask) const {
+    datetime_column col;
+    for (std::size_t i = 0; i < size(); i++) {
+      if (batch_mask_test(mask, i)) {
+        col.m_mjd.push_back(m_mjd[i]);
+        col.m_sec.push_back(m_sec[i]);
+      }
+    }
+    return col;
+  }
+
+  /** @brief Index of the (first) minimum element; size() if empty. */
+  std::size_t argmin() const noexcept { return extremum<true>(); }
+
+  /** @brief Index of the (first) maximum element; size() if empty. */
+  std::size_t argmax() const noexcept { return extremum<false>(); }
+
+  /** @brief The minimum element; the column must not be empty. */
+  datetime<S> min() const noexcept { return (*this)[argmin()]; }
+
+  /** @brief The maximum element; the column must not be empty. */
+  datetime<S> max() const noexcept { return (*this)[argmax()]; }
+
+private:
+  /** @brief Index of the min (IsMin = true) or max element.
+   *
+   * Done in three branch-free passes: extreme MJD, extreme seconds among the
+   * elements with that MJD, and the first index matching both.
+   */
+  template <bool IsMin> std::size_t extremum() const noexcept {
+    const std::size_t n = size();
+    if (!n)
+      return n;
+    const int *mjd = m_mjd.data();
+    const SecIntType *sec = m_sec.data();
+    int em = mjd[0];
+    for (std::size_t i = 1; i < n; i++)
+      em = IsMin ? (mjd[i] < em ? mjd[i] : em) : (mjd[i] > em ? mjd[i] : em);
+    SecIntType es = IsMin ? S::max_in_day : -1;
+    for (std::size_t i = 0; i < n; i++) {
+      const SecIntType s = (mjd[i] == em) ? sec[i] : es;
+      es = IsMin ? (s < es ? s : es) : (s > es ? s : es);
+    }
+    std::size_t i = 0;
+    while (mjd[i] != em || sec[i] != es)
+      ++i;
+    return i;
+  }
+
+  std::vector<int, core::aligned_allocator<int>> m_mjd;
+  std::vector<SecIntType, core::aligned_allocator<SecIntType>> m_sec;
+}; /* class datetime_column */
+
+} /* namespace dso */
+
+#endif
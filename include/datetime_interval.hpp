@@ -11,6 +11,9 @@
 
 #include "date_integral_types.hpp"
 #include "hms_time.hpp"
+#if __cplusplus >= 202002L
+#include <concepts>
+#endif
 #ifdef DEBUG
 #include <cassert>
 #endif
@@ -44,11 +47,13 @@ constexpr int sgn(DType val) noexcept {
 
 /** @brief A copysign implementation for *seconds.
  *
- * Returns the magnitude of
- * */
+ * Returns the magnitude of \p val with the sign of \p isgn (where a zero
+ * \p isgn counts as positive). Integer only, i.e. no round trip through
+ * floating point.
+ */
 #if __cplusplus >= 202002L
 template <gconcepts::is_fundamental_and_has_ref DType, typename I>
-  requires integral<I>
+  requires std::integral<I>
 #else
 template <typename DType, typename I,
           typename = std::enable_if_t<DType::is_dt_fundamental_type>,
@@ -62,10 +67,12 @@ constexpr DType copysign(DType val, I isgn) noexcept {
                sgn(isgn)};
 }
 
-/** @brief A copysign implementation for integral types. */
+/** @brief A copysign implementation for integral types; see the overload
+ * for *seconds.
+ */
 #if __cplusplus >= 202002L
-template <typename Iv, Is>
-  requires integral<Iv> && integral<Is>
+template <typename Iv, typename Is>
+  requires std::integral<Iv> && std::integral<Is>
 #else
 template <typename Iv, typename Is,
           typename = std::enable_if_t<std::is_integral_v<Iv>>,
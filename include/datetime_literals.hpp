@@ -0,0 +1,249 @@
+/** @file
+ *
+ * User-defined literals for epochs, parsed at compile time.
+ *
+ * Fixed epochs (e.g. in configuration or test code) can be written as string
+ * literals, which are parsed and validated during compilation:
+ *
+ * | Literal  | Format                          | Result                  |
+ * |----------|---------------------------------|-------------------------|
+ * | _tai_s   | YYYY-MM-DD[Thh:mm:ss]           | datetime<seconds>       |
+ * | _tai_ms  | YYYY-MM-DD[Thh:mm:ss[.fff]]     | datetime<milliseconds>  |
+ * | _tai_us  | YYYY-MM-DD[Thh:mm:ss[.ffffff]]  | datetime<microseconds>  |
+ * | _tai_ns  | YYYY-MM-DD[Thh:mm:ss[.f...f]]   | datetime<nanoseconds>   |
+ * | _ydoy    | YYYY:DDD[:SSSSS[.f...f]]        | datetime<nanoseconds>   |
+ * | _tpd     | YYYY-MM-DD[Thh:mm:ss[.f...f]]   | TwoPartDate             |
+ * | _ydoy_tpd| YYYY:DDD[:SSSSS[.f...f]]        | TwoPartDate             |
+ *
+ * The date/time separator of the ISO format can be either 'T' or a
+ * whitespace. In the year:day-of-year format, SSSSS are the (zero-padded)
+ * seconds of day. Fractional seconds can have any number of digits, but
+ * digits finer than the resolution of the target type must be zero (e.g.
+ * "2017-01-01T00:00:00.0000000001"_tai_ns is rejected).
+ *
+ * Example:
+ * using namespace dso::literals;
+ * constexpr auto t = "2017-01-01T00:00:00.000000001"_tai_ns;
+ * constexpr auto d = "2024:123:00000"_ydoy;
+ *
+ * Under C++20, the literal operators are consteval, hence a malformed
+ * literal is always a compile-time error and there is no run-time cost.
+ * Under C++17, they are constexpr; the same holds when the result
+ * initializes a constexpr variable, otherwise parsing may happen at run-time
+ * and a malformed literal throws an std::invalid_argument.
+ *
+ * Note that no leap seconds are allowed (i.e. seconds must be in [0,60)).
+ */
+
+#ifndef __DSO_DATETIME_LITERALS_HPP__
+#define __DSO_DATETIME_LITERALS_HPP__
+
+#include "dtdatetime.hpp"
+#include "tpdate.hpp"
+#include <cstddef>
+#include <stdexcept>
+
+#if __cplusplus >= 202002L
+#define DATETIME_CONSTEVAL consteval
+#else
+#define DATETIME_CONSTEVAL constexpr
+#endif
+
+namespace dso {
+
+namespace core {
+
+/** @brief Parse exactly ndigits decimal digits, starting at str[pos].
+ *
+ * At output, pos is set to one past the last digit parsed.
+ * @throw std::invalid_argument if less than ndigits digits are available.
+ */
+constexpr long parse_literal_digits(const char *str, std::size_t len,
+                                    std::size_t &pos, int ndigits) {
+  long v = 0;
+  for (int i = 0; i < ndigits; i++, pos++) {
+    if (pos >= len || str[pos] < '0' || str[pos] > '9')
+      throw std::invalid_argument(
+          "[ERROR] Invalid epoch literal; expected a digit\n");
+    v = v * 10 + (str[pos] - '0');
+  }
+  return v;
+}
+
+/** @brief Check that str[pos] is the character c and advance pos. */
+constexpr void parse_literal_char(const char *str, std::size_t len,
+                                  std::size_t &pos, char c) {
+  if (pos >= len || str[pos] != c)
+    throw std::invalid_argument(
+        "[ERROR] Invalid epoch literal; unexpected character\n");
+  ++pos;
+}
+
+/** @brief Parse an (optional) fractional seconds part, i.e. '.' followed by
+ * at least one digit, as a number of ticks of type S.
+ *
+ * If str[pos] is not '.', nothing is parsed and 0 is returned. Digits finer
+ * than the resolution of S must be zero.
+ */
+template <typename S>
+constexpr typename S::underlying_type
+parse_literal_fraction(const char *str, std::size_t len, std::size_t &pos) {
+  using I = typename S::underlying_type;
+  if (pos >= len || str[pos] != '.')
+    return I(0);
+  ++pos;
+  if (pos >= len)
+    throw std::invalid_argument(
+        "[ERROR] Invalid epoch literal; missing fractional seconds\n");
+  I ticks = 0;
+  I place = S::template sec_factor<I>() / 10;
+  for (; pos < len; pos++) {
+    if (str[pos] < '0' || str[pos] > '9')
+      throw std::invalid_argument(
+          "[ERROR] Invalid epoch literal; expected a digit\n");
+    const I d = str[pos] - '0';
+    if (place == 0 && d != 0)
+      throw std::invalid_argument(
+          "[ERROR] Invalid epoch literal; fractional seconds finer than the "
+          "resolution of the target type\n");
+    ticks += d * place;
+    place /= 10;
+  }
+  return ticks;
+}
+
+/** @brief Parse an ISO epoch, i.e. YYYY-MM-DD[Thh:mm:ss[.f...f]] (with 'T'
+ * or ' ' as separator) to a datetime<S>.
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <typename S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+constexpr datetime<S> parse_iso_epoch(const char *str, std::size_t len) {
+  using I = typename S::underlying_type;
+  std::size_t pos = 0;
+  const int iy = static_cast<int>(parse_literal_digits(str, len, pos, 4));
+  parse_literal_char(str, len, pos, '-');
+  const int im = static_cast<int>(parse_literal_digits(str, len, pos, 2));
+  parse_literal_char(str, len, pos, '-');
+  const int id = static_cast<int>(parse_literal_digits(str, len, pos, 2));
+  if (im < 1 || im > 12)
+    throw std::invalid_argument("[ERROR] Invalid epoch literal; month\n");
+  if (id < 1 || id > mtab[im - 1] + ((im == 2) && is_leap(iy)))
+    throw std::invalid_argument(
+        "[ERROR] Invalid epoch literal; day of month\n");
+
+  I sec = 0;
+  if (pos < len) {
+    if (str[pos] != 'T' && str[pos] != ' ')
+      throw std::invalid_argument(
+          "[ERROR] Invalid epoch literal; expected date/time separator\n");
+    ++pos;
+    const long hh = parse_literal_digits(str, len, pos, 2);
+    parse_literal_char(str, len, pos, ':');
+    const long mm = parse_literal_digits(str, len, pos, 2);
+    parse_literal_char(str, len, pos, ':');
+    const long ss = parse_literal_digits(str, len, pos, 2);
+    if (hh > 23 || mm > 59 || ss > 59)
+      throw std::invalid_argument(
+          "[ERROR] Invalid epoch literal; time of day\n");
+    sec = static_cast<I>((hh * 60 + mm) * 60 + ss) *
+              S::template sec_factor<I>() +
+          parse_literal_fraction<S>(str, len, pos);
+  }
+  if (pos != len)
+    throw std::invalid_argument(
+        "[ERROR] Invalid epoch literal; trailing characters\n");
+
+  return datetime<S>::non_normalize_construct(
+      modified_julian_day(static_cast<int>(cal2mjd(iy, im, id))), S(sec));
+}
+
+/** @brief Parse a year:day-of-year epoch, i.e. YYYY:DDD[:SSSSS[.f...f]],
+ * where SSSSS are seconds of day, to a datetime<S>.
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <typename S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+constexpr datetime<S> parse_ydoy_epoch(const char *str, std::size_t len) {
+  using I = typename S::underlying_type;
+  std::size_t pos = 0;
+  const int iy = static_cast<int>(parse_literal_digits(str, len, pos, 4));
+  parse_literal_char(str, len, pos, ':');
+  const int idoy = static_cast<int>(parse_literal_digits(str, len, pos, 3));
+  if (idoy < 1 || idoy > 365 + is_leap(iy))
+    throw std::invalid_argument(
+        "[ERROR] Invalid epoch literal; day of year\n");
+
+  I sec = 0;
+  if (pos < len) {
+    parse_literal_char(str, len, pos, ':');
+    const long ss = parse_literal_digits(str, len, pos, 5);
+    if (ss >= 86400L)
+      throw std::invalid_argument(
+          "[ERROR] Invalid epoch literal; seconds of day\n");
+    sec = static_cast<I>(ss) * S::template sec_factor<I>() +
+          parse_literal_fraction<S>(str, len, pos);
+  }
+  if (pos != len)
+    throw std::invalid_argument(
+        "[ERROR] Invalid epoch literal; trailing characters\n");
+
+  return datetime<S>::non_normalize_construct(
+      modified_julian_day(static_cast<int>(cal2mjd(iy, 1, 1)) + idoy - 1),
+      S(sec));
+}
+} /* namespace core */
+
+namespace literals {
+
+/** @brief ISO epoch literal to datetime<seconds> */
+DATETIME_CONSTEVAL datetime<seconds> operator""_tai_s(const char *str,
+                                                      std::size_t len) {
+  return core::parse_iso_epoch<seconds>(str, len);
+}
+
+/** @brief ISO epoch literal to datetime<milliseconds> */
+DATETIME_CONSTEVAL datetime<milliseconds> operator""_tai_ms(const char *str,
+                                                            std::size_t len) {
+  return core::parse_iso_epoch<milliseconds>(str, len);
+}
+
+/** @brief ISO epoch literal to datetime<microseconds> */
+DATETIME_CONSTEVAL datetime<microseconds> operator""_tai_us(const char *str,
+                                                            std::size_t len) {
+  return core::parse_iso_epoch<microseconds>(str, len);
+}
+
+/** @brief ISO epoch literal to datetime<nanoseconds> */
+DATETIME_CONSTEVAL datetime<nanoseconds> operator""_tai_ns(const char *str,
+                                                           std::size_t len) {
+  return core::parse_iso_epoch<nanoseconds>(str, len);
+}
+
+/** @brief Year:day-of-year epoch literal to datetime<nanoseconds> */
+DATETIME_CONSTEVAL datetime<nanoseconds> operator""_ydoy(const char *str,
+                                                         std::size_t len) {
+  return core::parse_ydoy_epoch<nanoseconds>(str, len);
+}
+
+/** @brief ISO epoch literal to TwoPartDate */
+DATETIME_CONSTEVAL TwoPartDate operator""_tpd(const char *str,
+                                              std::size_t len) {
+  return TwoPartDate(core::parse_iso_epoch<nanoseconds>(str, len));
+}
+
+/** @brief Year:day-of-year epoch literal to TwoPartDate */
+DATETIME_CONSTEVAL TwoPartDate operator""_ydoy_tpd(const char *str,
+                                                   std::size_t len) {
+  return TwoPartDate(core::parse_ydoy_epoch<nanoseconds>(str, len));
+}
+
+} /* namespace literals */
+
+} /* namespace dso */
+
+#endif
@@ -257,7 +257,7 @@ public:
     /* note that id days are 0 and the sign is negative, it must be applied to
      * the seconds part */
     return datetime_interval<S>(
-        days * sgn, S(std::copysign(secs + ddat, (days == 0) * sgn)));
+        days * sgn, S(core::copysign(secs + ddat, (days == 0) * sgn)));
   }
 
   /** @brief Normalize a datetime_utc instance.
@@ -265,26 +265,29 @@ public:
    * Split the date and time parts such that the time part is always less
    * than one day (i.e. make it time-of-day) and positive (i.e.>=0).
    * Remove whole days of from the time part and add them to the date part.
+   * The time part can be negative, in which case whole days are removed from
+   * the date part.
+   *
+   * This is computed in closed form (see normalize_impl), i.e. the cost does
+   * not depend on the number of days crossed.
    */
   constexpr void normalize() noexcept {
     if (m_sec >= S(0) && m_sec < S(S::max_in_day))
       return;
-    /* TODO handle case when m_sec < 0 */
-    assert(m_sec >= S(0));
-    int extra_sec_in_day = 0;
-    dat(m_mjd, extra_sec_in_day);
-    /* for each MJD, remove integral days. Each MJD may have a different
-     * number of seconds, since we are in UTC time scale. Hence, iteratively
-     * remove whole days using the number of seconds for each day
-     */
-    S daysec;
-    while (m_sec >= (daysec = S(S::max_in_day +
-                                extra_sec_in_day *
-                                    S::template sec_factor<SecIntType>()))) {
-      m_sec -= daysec;
-      ++m_mjd;
-      dat(m_mjd, extra_sec_in_day);
-    }
+    normalize_impl([](modified_julian_day mjd) { return dat(mjd); });
+  }
+
+  /** @brief Normalize a datetime_utc instance, using a LeapCursor.
+   *
+   * Same as normalize(), but ΔAT values are resolved via the \p cursor (see
+   * LeapCursor), instead of searching the leap second table.
+   */
+  void normalize(LeapCursor &cursor) noexcept {
+    if (m_sec >= S(0) && m_sec < S(S::max_in_day))
+      return;
+    normalize_impl([&cursor](modified_julian_day mjd) {
+      return cursor.dat(mjd.as_underlying_type());
+    });
   }
 
   /** @brief Add seconds of any type (T). */
@@ -299,7 +302,58 @@ public:
     return __add_seconds_impl<T>(nsec, std::integral_constant<bool, TT>{});
   }
 
+  /** @brief Add seconds of any type (T), using a LeapCursor.
+   *
+   * ΔAT values (if needed) are resolved via the \p cursor (see LeapCursor).
+   */
+#if __cplusplus >= 202002L
+  template <gconcepts::is_sec_dt T>
+#else
+  template <class T, typename = std::enable_if_t<T::is_of_sec_type>>
+#endif
+  void add_seconds(T nsec, LeapCursor &cursor) noexcept {
+    m_sec += dso::cast_to<T, S>(nsec);
+    this->normalize(cursor);
+  }
+
 private:
+  /** @brief Normalize the instance, given a function to compute ΔAT.
+   *
+   * The (UTC) time elapsed from the start of day m_mjd to the start of day
+   * m_mjd + d, is T(d) = d * 86400 + ΔAT(m_mjd + d) - ΔAT(m_mjd) [sec]. We
+   * need the day d for which T(d) <= m_sec < T(d+1); a first guess ignoring
+   * leap seconds (i.e. a floor division) can only be off by one day, since
+   * leap seconds accumulated are far less than a day. Hence, the number of
+   * ΔAT evaluations is constant, regardless of the days crossed.
+   *
+   * @param[in] dat_fn A callable with signature int(modified_julian_day mjd),
+   *                   returning ΔAT for \p mjd.
+   */
+  template <typename DatFn>
+  constexpr void normalize_impl(DatFn &&dat_fn) noexcept {
+    constexpr const SecIntType F = S::template sec_factor<SecIntType>();
+    const SecIntType sec = m_sec.as_underlying_type();
+    const DaysIntType mjd0 = m_mjd.as_underlying_type();
+    const int dat0 = dat_fn(m_mjd);
+    /* time elapsed from the start of m_mjd to the start of m_mjd + d */
+    auto elapsed = [&](DaysIntType d) -> SecIntType {
+      return static_cast<SecIntType>(d) * S::max_in_day +
+             (dat_fn(modified_julian_day(mjd0 + d)) - dat0) * F;
+    };
+    /* first guess: floor division, ignoring leap seconds */
+    DaysIntType days = sec / S::max_in_day - (sec % S::max_in_day < 0);
+    SecIntType t = elapsed(days);
+    while (t > sec)
+      t = elapsed(--days);
+    SecIntType tnext = 0;
+    while ((tnext = elapsed(days + 1)) <= sec) {
+      ++days;
+      t = tnext;
+    }
+    m_mjd = modified_julian_day(mjd0 + days);
+    m_sec = S(sec - t);
+  }
+
   /** @brief Add any second type T where S is of higher resolution than T
    *
    * This is the implementation for adding any type of seconds (T), where T is
@@ -384,7 +438,7 @@ template <gconcepts::is_sec_dt T>
 #else
 template <typename T, typename = std::enable_if_t<T::is_of_sec_type>>
 #endif
-inline int dat(const datetime<T> &t) noexcept {
+inline constexpr int dat(const datetime<T> &t) noexcept {
   return dso::dat(t.imjd());
 }
 
@@ -0,0 +1,213 @@
+/** @file
+ *
+ * Iterate over a range of (integral) days, producing the calendar fields of
+ * each day (calendar date, day of year, GPS week and day of week, ΔAT and
+ * leap second flag).
+ *
+ * Fields are computed once, for the first day of the range; each step then
+ * carries them forward (e.g. the day of month is incremented and wraps at
+ * the end of the month), so that advancing costs a few additions and
+ * comparisons instead of a full MJD to calendar transformation.
+ *
+ * Example:
+ * for (const auto &day : dso::day_range(modified_julian_day(first),
+ *                                       modified_julian_day(last))) {
+ *   printf("%04d/%03d %d\n", day.yr().as_underlying_type(),
+ *          day.dy().as_underlying_type(), day.dat());
+ * }
+ */
+
+#ifndef __DSO_DATETIME_DAY_ITERATOR_HPP__
+#define __DSO_DATETIME_DAY_ITERATOR_HPP__
+
+#include "date_integral_types.hpp"
+#include "leap_seconds.hpp"
+#include <cstddef>
+#include <iterator>
+
+namespace dso {
+
+/** @brief The calendar fields of an (integral) day, as produced by a
+ * day_iterator.
+ */
+class calendar_day {
+public:
+  /** @brief The MJD */
+  constexpr modified_julian_day mjd() const noexcept {
+    return modified_julian_day(m_mjd);
+  }
+  /** @brief The year */
+  constexpr year yr() const noexcept { return year(m_year); }
+  /** @brief The month */
+  constexpr month mn() const noexcept { return month(m_month); }
+  /** @brief The day of month */
+  constexpr day_of_month dm() const noexcept { return day_of_month(m_dom); }
+  /** @brief The day of year */
+  constexpr day_of_year dy() const noexcept { return day_of_year(m_doy); }
+  /** @brief Calendar date */
+  constexpr ymd_date ymd() const noexcept {
+    return ymd_date(yr(), mn(), dm());
+  }
+  /** @brief Year and day of year */
+  constexpr ydoy_date ydoy() const noexcept { return ydoy_date(yr(), dy()); }
+
+  /** @brief The GPS week.
+   *
+   * Weeks are counted from 1980/01/06; for days after that, this is
+   * identical to the week returned by datetime<S>::gps_wsow.
+   */
+  constexpr gps_week gps_wk() const noexcept { return gps_week(m_gps_week); }
+
+  /** @brief Day of (GPS) week, in the range [0, 6], with 0 being Sunday. */
+  constexpr int gps_dow() const noexcept { return m_gps_dow; }
+
+  /** @brief ΔAT = TAI - UTC at the start of the day, in [sec]. */
+  constexpr int dat() const noexcept { return m_dat; }
+
+  /** @brief True if the day ends with a leap second. */
+  constexpr bool is_leap_insertion_day() const noexcept { return m_extra; }
+
+  /** @brief Number of extra seconds in the (UTC) day, i.e. 1 if the day ends
+   * with a leap second, 0 otherwise.
+   */
+  constexpr int extra_seconds() const noexcept { return m_extra; }
+
+private:
+  friend class day_iterator;
+  int m_mjd;
+  int m_year;
+  int m_month;
+  int m_dom;
+  int m_doy;
+  int m_mlen; /** days in current month */
+  long m_gps_week;
+  int m_gps_dow;
+  int m_dat;
+  int m_extra;
+}; /* class calendar_day */
+
+/** @brief A forward iterator over (integral) days.
+ *
+ * Dereferencing yields the calendar_day of the current day. Iterators
+ * compare equal if they point to the same MJD.
+ *
+ * ΔAT values are read off a leap second table snapshot (by default, the one
+ * currently in use), via a LeapCursor; note that ΔAT is only meaningful for
+ * days after 1972/01/01.
+ */
+class day_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = calendar_day;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const calendar_day *;
+  using reference = const calendar_day &;
+
+  /** @brief Constructor; fields are computed for the given day. */
+  explicit day_iterator(
+      modified_julian_day mjd = modified_julian_day(JAN61980),
+      const LeapSecondTable *table = leap_seconds::current()) noexcept
+      : m_cursor(table) {
+    const ymd_date ymd = mjd.to_ymd();
+    m_day.m_mjd = mjd.as_underlying_type();
+    m_day.m_year = ymd.yr().as_underlying_type();
+    m_day.m_month = ymd.mn().as_underlying_type();
+    m_day.m_dom = ymd.dm().as_underlying_type();
+    const int leap = core::is_leap(m_day.m_year);
+    m_day.m_doy = core::month_day[leap][m_day.m_month - 1] + m_day.m_dom;
+    m_day.m_mlen = month_length(m_day.m_month, leap);
+    /* floor division, so that the day of week is always in [0,6] */
+    const long days = static_cast<long>(m_day.m_mjd) - JAN61980;
+    m_day.m_gps_week = days / 7 - (days % 7 < 0);
+    m_day.m_gps_dow = static_cast<int>(days - m_day.m_gps_week * 7);
+    m_day.m_dat = m_cursor.dat(m_day.m_mjd, m_day.m_extra);
+  }
+
+  reference operator*() const noexcept { return m_day; }
+  pointer operator->() const noexcept { return &m_day; }
+
+  /** @brief Advance to the next day. */
+  day_iterator &operator++() noexcept {
+    ++m_day.m_mjd;
+    ++m_day.m_doy;
+    if (++m_day.m_gps_dow == 7) {
+      m_day.m_gps_dow = 0;
+      ++m_day.m_gps_week;
+    }
+    if (++m_day.m_dom > m_day.m_mlen) {
+      m_day.m_dom = 1;
+      if (++m_day.m_month > 12) {
+        m_day.m_month = 1;
+        m_day.m_doy = 1;
+        ++m_day.m_year;
+      }
+      m_day.m_mlen = month_length(m_day.m_month, core::is_leap(m_day.m_year));
+    }
+    m_day.m_dat = m_cursor.dat(m_day.m_mjd, m_day.m_extra);
+    return *this;
+  }
+
+  day_iterator operator++(int) noexcept {
+    day_iterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  bool operator==(const day_iterator &other) const noexcept {
+    return m_day.m_mjd == other.m_day.m_mjd;
+  }
+  bool operator!=(const day_iterator &other) const noexcept {
+    return !(*this == other);
+  }
+
+private:
+  friend class day_range;
+  struct sentinel_tag {};
+
+  /** @brief Past-the-end iterator; only the MJD is set, which is all that
+   * operator== compares. Must not be dereferenced.
+   */
+  day_iterator(sentinel_tag, modified_julian_day mjd,
+               const LeapSecondTable *table) noexcept
+      : m_day(), m_cursor(table) {
+    m_day.m_mjd = mjd.as_underlying_type();
+  }
+
+  static constexpr int month_length(int im, int leap) noexcept {
+    return core::mtab[im - 1] + (im == 2) * leap;
+  }
+
+  calendar_day m_day;
+  LeapCursor m_cursor;
+}; /* class day_iterator */
+
+/** @brief A range of (integral) days, i.e. [first, last). */
+class day_range {
+public:
+  /** @brief Constructor; the range is [first, last) */
+  day_range(modified_julian_day first, modified_julian_day last,
+            const LeapSecondTable *table = leap_seconds::current()) noexcept
+      : m_first(first), m_last(last < first ? first : last), m_table(table) {}
+
+  day_iterator begin() const noexcept {
+    return day_iterator(m_first, m_table);
+  }
+  day_iterator end() const noexcept {
+    return day_iterator(day_iterator::sentinel_tag{}, m_last, m_table);
+  }
+
+  /** @brief Number of days in the range */
+  std::size_t size() const noexcept {
+    return static_cast<std::size_t>(m_last.as_underlying_type() -
+                                    m_first.as_underlying_type());
+  }
+
+private:
+  modified_julian_day m_first;
+  modified_julian_day m_last;
+  const LeapSecondTable *m_table;
+}; /* class day_range */
+
+} /* namespace dso */
+
+#endif
@@ -0,0 +1,157 @@
+/** @file
+ *
+ * Batch differences of epochs to a reference epoch, i.e. out[i] = epochs[i]
+ * - ref, as fractional seconds, days or (Julian) years, for datetime<S> and
+ * TwoPartDate arrays.
+ *
+ * This is equivalent to calling diff<DT>(ref) on each epoch, but without the
+ * intermediate datetime_interval (and its sign handling); each element costs
+ * a few (branch-free) floating point operations, so that the loops are
+ * vectorized.
+ *
+ * Results are compensated: the integral parts of the difference (days and,
+ * for datetime<S>, whole seconds) are combined exactly, and the rounding
+ * errors of the fractional part and of the final summation are recovered via
+ * error-free transformations (TwoSum and FMA) and added back. Hence, the
+ * results are (at worst) within one ulp of the exact difference and
+ * typically correctly rounded.
+ */
+
+#ifndef __DSO_DATETIME_DIFF_BATCH_HPP__
+#define __DSO_DATETIME_DIFF_BATCH_HPP__
+
+#include "double_double.hpp"
+#include "dtdatetime.hpp"
+#include "tpdate.hpp"
+#include <cmath>
+#include <cstddef>
+
+namespace dso {
+
+namespace core {
+/** @brief Compensated hi + (num + num_lo) / den, where hi, num and den are
+ * exact and num_lo is a (small) correction to num.
+ */
+inline double sum_quotient(double hi, double num, double den,
+                           double num_lo = 0e0) noexcept {
+  const double q = num / den;
+  /* exact residual of the division */
+  const double r = std::fma(-q, den, num);
+  double s, e;
+  two_sum(hi, q, s, e);
+  return s + (e + (r + num_lo) / den);
+}
+} /* namespace core */
+
+/** @brief Differences of epochs to a reference epoch, for datetime<S>.
+ *
+ * @tparam DT The type of the differences, i.e. fractional seconds, days or
+ *            years
+ * @param[in]  epochs Array of n epochs
+ * @param[in]  n      Number of epochs
+ * @param[in]  ref    The reference epoch
+ * @param[out] out    Array of n elements; at output, out[i] = epochs[i] -
+ *                    ref (in units according to DT)
+ *
+ * @warning Does not take into account leap seconds.
+ */
+#if __cplusplus >= 202002L
+template <DateTimeDifferenceType DT, gconcepts::is_sec_dt S>
+#else
+template <DateTimeDifferenceType DT, class S,
+          typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+void diff_batch(const datetime<S> *epochs, std::size_t n,
+                const datetime<S> &ref, double *out) noexcept {
+  using I = typename S::underlying_type;
+  const int rmjd = ref.imjd().as_underlying_type();
+  const I rsec = ref.sec().as_underlying_type();
+  constexpr const I F = S::max_in_day;
+  constexpr const I fac = S::template sec_factor<I>();
+
+  if constexpr (DT == DateTimeDifferenceType::FractionalSeconds) {
+    if constexpr (F <= (I(1) << 53)) {
+      /* seconds of day are exact as doubles */
+      for (std::size_t i = 0; i < n; i++) {
+        const I dd = epochs[i].imjd().as_underlying_type() - rmjd;
+        const double big = static_cast<double>(dd * seconds::max_in_day);
+        const I ds = epochs[i].sec().as_underlying_type() - rsec;
+        out[i] = core::sum_quotient(big, static_cast<double>(ds),
+                                    static_cast<double>(fac));
+      }
+    } else {
+      /* split to whole seconds and remainder, so that both are exact */
+      for (std::size_t i = 0; i < n; i++) {
+        const I ds = epochs[i].sec().as_underlying_type() - rsec;
+        const I whole = ds / fac;
+        const I dd = epochs[i].imjd().as_underlying_type() - rmjd;
+        const double big =
+            static_cast<double>(dd * seconds::max_in_day + whole);
+        out[i] = core::sum_quotient(big, static_cast<double>(ds - whole * fac),
+                                    static_cast<double>(fac));
+      }
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      const double big =
+          static_cast<double>(epochs[i].imjd().as_underlying_type() - rmjd);
+      const I ds = epochs[i].sec().as_underlying_type() - rsec;
+      if constexpr (F <= (I(1) << 53)) {
+        out[i] = core::sum_quotient(big, static_cast<double>(ds),
+                                    static_cast<double>(F));
+      } else {
+        /* seconds of day may not be exact as doubles; keep the residual */
+        const double dh = static_cast<double>(ds);
+        const double dl = static_cast<double>(ds - static_cast<I>(dh));
+        out[i] = core::sum_quotient(big, dh, static_cast<double>(F), dl);
+      }
+    }
+    if constexpr (DT == DateTimeDifferenceType::FractionalYears) {
+      for (std::size_t i = 0; i < n; i++)
+        out[i] /= DAYS_IN_JULIAN_YEAR;
+    }
+  }
+}
+
+/** @brief Differences of epochs to a reference epoch, for TwoPartDate.
+ *
+ * @tparam DT The type of the differences, i.e. fractional seconds, days or
+ *            years
+ * @param[in]  epochs Array of n epochs
+ * @param[in]  n      Number of epochs
+ * @param[in]  ref    The reference epoch
+ * @param[out] out    Array of n elements; at output, out[i] = epochs[i] -
+ *                    ref (in units according to DT)
+ *
+ * @warning Does not take into account leap seconds.
+ */
+template <DateTimeDifferenceType DT>
+void diff_batch(const TwoPartDate *epochs, std::size_t n,
+                const TwoPartDate &ref, double *out) noexcept {
+  const int rmjd = ref.imjd();
+  const double rsec = ref.seconds().seconds();
+  for (std::size_t i = 0; i < n; i++) {
+    const double dd = static_cast<double>(epochs[i].imjd() - rmjd);
+    /* exact difference of the seconds of day, as bh + bl */
+    double bh, bl;
+    core::two_sum(epochs[i].seconds().seconds(), -rsec, bh, bl);
+    double s, e;
+    if constexpr (DT == DateTimeDifferenceType::FractionalSeconds) {
+      core::two_sum(dd * SEC_PER_DAY, bh, s, e);
+      out[i] = s + (e + bl);
+    } else {
+      const double q = bh / SEC_PER_DAY;
+      const double r = std::fma(-q, SEC_PER_DAY, bh);
+      core::two_sum(dd, q, s, e);
+      out[i] = s + (e + (r + bl) / SEC_PER_DAY);
+    }
+  }
+  if constexpr (DT == DateTimeDifferenceType::FractionalYears) {
+    for (std::size_t i = 0; i < n; i++)
+      out[i] /= DAYS_IN_JULIAN_YEAR;
+  }
+}
+
+} /* namespace dso */
+
+#endif
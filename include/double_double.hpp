@@ -0,0 +1,232 @@
+/** @file
+ *
+ * Error-free transformations of floating point operations and a
+ * double-double type built on them.
+ *
+ * A DoubleDouble represents a number as the unevaluated sum hi + lo of two
+ * doubles, with |lo| <= ulp(hi)/2; this gives (about) 106 bits of
+ * precision, i.e. seconds of day are resolved down to ~1e-27 sec. Products
+ * use FMA (std::fma), hence operations are (only) a few times slower than
+ * plain double arithmetic on hardware with native FMA.
+ *
+ * The type only offers what is needed to use it as the representation of
+ * seconds in TwoPartDateT, i.e. addition and subtraction (of doubles and
+ * DoubleDoubles), multiplication and division by doubles, and comparisons.
+ */
+
+#ifndef __DSO_DATETIME_DOUBLE_DOUBLE_HPP__
+#define __DSO_DATETIME_DOUBLE_DOUBLE_HPP__
+
+#include <cmath>
+
+namespace dso {
+
+namespace core {
+/** @brief Error-free transformation of a sum, i.e. a + b = s + e exactly
+ * (Knuth's TwoSum).
+ */
+inline void two_sum(double a, double b, double &s, double &e) noexcept {
+  s = a + b;
+  const double bb = s - a;
+  e = (a - (s - bb)) + (b - bb);
+}
+
+/** @brief Error-free transformation of a sum, i.e. a + b = s + e exactly,
+ * assuming |a| >= |b| (Dekker's FastTwoSum).
+ */
+inline void fast_two_sum(double a, double b, double &s, double &e) noexcept {
+  s = a + b;
+  e = b - (s - a);
+}
+
+/** @brief Error-free transformation of a product, i.e. a * b = p + e
+ * exactly (using FMA).
+ */
+inline void two_prod(double a, double b, double &p, double &e) noexcept {
+  p = a * b;
+  e = std::fma(a, b, -p);
+}
+} /* namespace core */
+
+/** @brief A double-double number, i.e. the unevaluated sum hi + lo. */
+class DoubleDouble {
+  double _hi;
+  double _lo;
+
+  /** Construct from a (normalized) pair; no checks */
+  constexpr DoubleDouble(double h, double l,
+                         [[maybe_unused]] char c) noexcept
+      : _hi(h), _lo(l) {}
+
+  /** Normalized hi + lo, assuming |hi| >= |lo| */
+  static DoubleDouble renormalize(double h, double l) noexcept {
+    double s, e;
+    core::fast_two_sum(h, l, s, e);
+    return DoubleDouble(s, e, 'y');
+  }
+
+public:
+  /** @brief Constructor from a double (exact). */
+  constexpr DoubleDouble(double d = 0e0) noexcept : _hi(d), _lo(0e0) {}
+
+  /** @brief The (exact) sum of two doubles. */
+  static DoubleDouble sum(double a, double b) noexcept {
+    double s, e;
+    core::two_sum(a, b, s, e);
+    return DoubleDouble(s, e, 'y');
+  }
+
+  /** @brief The leading part, i.e. the value rounded to double. */
+  constexpr double hi() const noexcept { return _hi; }
+
+  /** @brief The trailing (error) part. */
+  constexpr double lo() const noexcept { return _lo; }
+
+  /** @brief The value rounded to double. */
+  constexpr double to_double() const noexcept { return _hi + _lo; }
+
+  DoubleDouble operator-() const noexcept {
+    return DoubleDouble(-_hi, -_lo, 'y');
+  }
+
+  /** @brief Sum of two DoubleDoubles (IEEE-style, i.e. accurate even when
+   * the operands cancel).
+   */
+  friend DoubleDouble operator+(const DoubleDouble &a,
+                                const DoubleDouble &b) noexcept {
+    double s, e, t, f;
+    core::two_sum(a._hi, b._hi, s, e);
+    core::two_sum(a._lo, b._lo, t, f);
+    e += t;
+    core::fast_two_sum(s, e, s, e);
+    e += f;
+    return renormalize(s, e);
+  }
+
+  friend DoubleDouble operator+(const DoubleDouble &a, double b) noexcept {
+    double s, e;
+    core::two_sum(a._hi, b, s, e);
+    e += a._lo;
+    return renormalize(s, e);
+  }
+
+  friend DoubleDouble operator+(double a, const DoubleDouble &b) noexcept {
+    return b + a;
+  }
+
+  friend DoubleDouble operator-(const DoubleDouble &a,
+                                const DoubleDouble &b) noexcept {
+    return a + (-b);
+  }
+
+  friend DoubleDouble operator-(const DoubleDouble &a, double b) noexcept {
+    return a + (-b);
+  }
+
+  friend DoubleDouble operator-(double a, const DoubleDouble &b) noexcept {
+    return (-b) + a;
+  }
+
+  friend DoubleDouble operator*(const DoubleDouble &a, double b) noexcept {
+    double p, e;
+    core::two_prod(a._hi, b, p, e);
+    e += a._lo * b;
+    return renormalize(p, e);
+  }
+
+  friend DoubleDouble operator*(double a, const DoubleDouble &b) noexcept {
+    return b * a;
+  }
+
+  /** @brief Division by a double (long division, one correction step). */
+  friend DoubleDouble operator/(const DoubleDouble &a, double b) noexcept {
+    const double q1 = a._hi / b;
+    double p, e;
+    core::two_prod(q1, b, p, e);
+    /* remainder a - q1 * b; a._hi - p is exact */
+    const double r = ((a._hi - p) - e) + a._lo;
+    return renormalize(q1, r / b);
+  }
+
+  DoubleDouble &operator+=(const DoubleDouble &b) noexcept {
+    return *this = *this + b;
+  }
+  DoubleDouble &operator+=(double b) noexcept { return *this = *this + b; }
+  DoubleDouble &operator-=(const DoubleDouble &b) noexcept {
+    return *this = *this - b;
+  }
+  DoubleDouble &operator-=(double b) noexcept { return *this = *this - b; }
+
+  /* comparisons are lexicographic, for normalized instances */
+  friend bool operator==(const DoubleDouble &a,
+                         const DoubleDouble &b) noexcept {
+    return a._hi == b._hi && a._lo == b._lo;
+  }
+  friend bool operator!=(const DoubleDouble &a,
+                         const DoubleDouble &b) noexcept {
+    return !(a == b);
+  }
+  friend bool operator<(const DoubleDouble &a,
+                        const DoubleDouble &b) noexcept {
+    return a._hi < b._hi || (a._hi == b._hi && a._lo < b._lo);
+  }
+  friend bool operator>(const DoubleDouble &a,
+                        const DoubleDouble &b) noexcept {
+    return b < a;
+  }
+  friend bool operator<=(const DoubleDouble &a,
+                         const DoubleDouble &b) noexcept {
+    return !(b < a);
+  }
+  friend bool operator>=(const DoubleDouble &a,
+                         const DoubleDouble &b) noexcept {
+    return !(a < b);
+  }
+}; /* class DoubleDouble */
+
+namespace core {
+/** @brief Round a seconds representation to double */
+constexpr double to_double(double d) noexcept { return d; }
+constexpr double to_double(long double d) noexcept {
+  return static_cast<double>(d);
+}
+constexpr double to_double(const DoubleDouble &d) noexcept {
+  return d.to_double();
+}
+
+/** @brief Truncated remainder of a / b, with the (truncated) quotient.
+ *
+ * I.e. a = q * b + r, with r having the sign of a and |r| < b (as
+ * std::fmod), for b > 0. The remainder is exact, as long as q * b is exact
+ * in double (e.g. for integral b and |q| < 2^31).
+ */
+inline DoubleDouble fmod_quo(const DoubleDouble &a, double b,
+                             int &q) noexcept {
+  double qd = std::trunc(a.hi() / b);
+  DoubleDouble r = a - qd * b;
+  /* the quotient of the leading parts may be off by one */
+  if (a >= 0e0) {
+    if (r < 0e0) {
+      r += b;
+      qd -= 1e0;
+    } else if (r >= b) {
+      r -= b;
+      qd += 1e0;
+    }
+  } else {
+    if (r > 0e0) {
+      r -= b;
+      qd += 1e0;
+    } else if (r <= -b) {
+      r += b;
+      qd -= 1e0;
+    }
+  }
+  q = static_cast<int>(qd);
+  return r;
+}
+} /* namespace core */
+
+} /* namespace dso */
+
+#endif
@@ -206,10 +206,8 @@ public:
 
   /** @brief Constructor from GPS Week and Seconds of Week */
   constexpr datetime(gps_week w, S sow) noexcept
-      : m_mjd(w.as_underlying_type() * 7 +
-              sow.as_underlying_type() / S::max_in_day + JAN61980),
-        m_sec(sow) {
-    m_sec.remove_days();
+      : m_mjd(w.as_underlying_type() * 7 + JAN61980), m_sec(sow) {
+    normalize();
   }
 
   /** @brief Get the Modified Julian Day (const). */
@@ -234,7 +232,7 @@ public:
   constexpr datetime<S>
   operator+(const datetime_interval<S> &dt) const noexcept {
     const auto mjd =
-        m_mjd + modified_julian_day(std::copysign(dt.days(), dt.sign()));
+        m_mjd + modified_julian_day(core::copysign(dt.days(), dt.sign()));
     const auto sec = m_sec + dt.signed_sec();
     return datetime<S>(mjd, sec);
   }
@@ -247,7 +245,7 @@ public:
    * from the instance, not added to it.
    */
   constexpr void operator+=(const datetime_interval<S> &dt) noexcept {
-    m_mjd += modified_julian_day(std::copysign(dt.days(), dt.sign()));
+    m_mjd += modified_julian_day(core::copysign(dt.days(), dt.sign()));
     m_sec += dt.signed_sec();
     this->normalize();
   }
@@ -275,7 +273,7 @@ public:
     /* note that if days are 0 and the sign is negative, it must be applied to
      * the seconds part */
     return datetime_interval<S>(days * sgn,
-                                S(std::copysign(secs, (days == 0) * sgn)));
+                                S(core::copysign(secs, (days == 0) * sgn)));
   }
 
   /** @brief Cast to any datetime<T> instance, regardless of what T is.
@@ -331,18 +329,17 @@ public:
   constexpr void normalize() noexcept {
     if (m_sec >= S(0) && m_sec < S(S::max_in_day))
       return;
-    /* number of whole days in seconds (always positive) */
-    const DaysIntType more =
-        std::copysign(m_sec.as_underlying_type(), 1) / S::max_in_day;
-    /* add to current days, with the right sign */
-    const DaysIntType days =
-        m_mjd.as_underlying_type() + std::copysign(more, core::sgn(m_sec));
-    /* leftover seconds (positive) */
-    const SecIntType s =
-        std::copysign(m_sec.as_underlying_type(), 1) - more * S::max_in_day;
-    /* if initial seconds were negative, adjust */
-    m_mjd = modified_julian_day(days - 1 * (m_sec < S(0)));
-    m_sec = S((S::max_in_day - s) * (m_sec < S(0)) + s * (m_sec >= S(0)));
+    /* floor division of the seconds by the day length (integer only, so
+     * that no bits are lost for large tick counts)
+     */
+    const SecIntType sec = m_sec.as_underlying_type();
+    const SecIntType more = sec / S::max_in_day;
+    const SecIntType s = sec - more * S::max_in_day;
+    /* if the leftover seconds are negative, borrow a day */
+    const SecIntType neg = (s < 0);
+    m_mjd = modified_julian_day(m_mjd.as_underlying_type() +
+                                static_cast<DaysIntType>(more - neg));
+    m_sec = S(s + neg * S::max_in_day);
 #ifdef DEBUG
     assert(m_sec >= S(0) && m_sec < S(S::max_in_day));
 #endif
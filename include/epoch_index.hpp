@@ -0,0 +1,326 @@
+/** @file
+ *
+ * An index over a sorted array of epochs (datetime<S> or TwoPartDate), for
+ * nearest-epoch, floor/ceil and tolerance-window lookups.
+ *
+ * Sampled data (e.g. ephemeris records or observations) are almost
+ * uniformly spaced in time, hence the position of an epoch within the array
+ * can be well predicted by (linear) interpolation between the end points of
+ * the search range. Searches use interpolation steps, falling back to a
+ * bisection step whenever an interpolation step fails to (at least) halve
+ * the search range; hence, lookups cost O(log log n) comparisons for
+ * uniform data and never more than O(log n). Interpolation only predicts
+ * positions; results are always decided by exact comparisons of the epochs
+ * (i.e. they are the same as the ones of std::lower_bound/upper_bound).
+ *
+ * Batched queries act on query streams; when queries are sorted, each
+ * search starts from the result of the previous one (galloping forward),
+ * so that a sorted stream of m queries costs O(m) for dense queries.
+ * Unsorted query streams are still handled correctly (just slower).
+ */
+
+#ifndef __DSO_DATETIME_EPOCH_INDEX_HPP__
+#define __DSO_DATETIME_EPOCH_INDEX_HPP__
+
+#include "dtdatetime.hpp"
+#include "tpdate.hpp"
+#include <cstddef>
+#include <utility>
+#ifdef DEBUG
+#include <algorithm>
+#include <cassert>
+#endif
+
+namespace dso {
+
+namespace core {
+
+/** @brief Epoch-type specific operations needed by EpochIndex. */
+template <typename T> struct epoch_index_traits;
+
+/** @brief epoch_index_traits for datetime<S>; tolerances are of type S. */
+template <typename S> struct epoch_index_traits<datetime<S>> {
+  using tolerance_type = S;
+
+  /** (Approximate) seconds from ref to a; only used to predict positions */
+  static double offset(const datetime<S> &a,
+                       const datetime<S> &ref) noexcept {
+    return static_cast<double>(a.imjd().as_underlying_type() -
+                               ref.imjd().as_underlying_type()) *
+               86400e0 +
+           static_cast<double>(a.sec().as_underlying_type() -
+                               ref.sec().as_underlying_type()) *
+               S::sec_inv_factor();
+  }
+
+  /** t + dt */
+  static datetime<S> shift(const datetime<S> &t, S dt) noexcept {
+    datetime<S> r(t);
+    r.add_seconds(dt);
+    return r;
+  }
+
+  /** true if t - f <= c - t, where f <= t <= c */
+  static bool closer_to_floor(const datetime<S> &f, const datetime<S> &t,
+                              const datetime<S> &c) noexcept {
+    return (t - f).signed_total_sec() <= (c - t).signed_total_sec();
+  }
+};
+
+/** @brief epoch_index_traits for TwoPartDate; tolerances are of type
+ * FractionalSeconds.
+ */
+template <> struct epoch_index_traits<TwoPartDate> {
+  using tolerance_type = FractionalSeconds;
+
+  static double offset(const TwoPartDate &a,
+                       const TwoPartDate &ref) noexcept {
+    return static_cast<double>(a.imjd() - ref.imjd()) * 86400e0 +
+           (a.seconds().seconds() - ref.seconds().seconds());
+  }
+
+  static TwoPartDate shift(const TwoPartDate &t,
+                           FractionalSeconds dt) noexcept {
+    TwoPartDate r(t);
+    r.add_seconds(dt);
+    return r;
+  }
+
+  static bool closer_to_floor(const TwoPartDate &f, const TwoPartDate &t,
+                              const TwoPartDate &c) noexcept {
+    return t.diff<DateTimeDifferenceType::FractionalSeconds>(f).seconds() <=
+           c.diff<DateTimeDifferenceType::FractionalSeconds>(t).seconds();
+  }
+};
+
+} /* namespace core */
+
+/** @brief A (non-owning) index over a sorted array of epochs.
+ *
+ * T is either datetime<S> or TwoPartDate. The underlying array must be
+ * sorted in ascending order and must outlive the index.
+ *
+ * All lookups return indexes into the array, or EpochIndex::npos if no
+ * such element exists.
+ */
+template <typename T> class EpochIndex {
+  using traits = core::epoch_index_traits<T>;
+
+public:
+  /** Type of tolerances, i.e. S for datetime<S>, FractionalSeconds for
+   * TwoPartDate.
+   */
+  using tolerance_type = typename traits::tolerance_type;
+
+  /** Returned when no element satisfies a lookup */
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+  /** Ranges smaller than this are scanned linearly */
+  static constexpr std::size_t LINEAR_SCAN = 8;
+
+  const T *m_data;
+  std::size_t m_size;
+
+  /** @brief First index in [lo, hi) such that !less(m_data[i], t), or hi
+   * if none; less is either operator< or operator<=.
+   *
+   * Assumes that (if lo > 0) less(m_data[lo-1], t) and (if hi < size) not
+   * less(m_data[hi], t).
+   */
+  template <bool Strict>
+  std::size_t search(const T &t, std::size_t lo, std::size_t hi) const
+      noexcept {
+    const auto less = [](const T &a, const T &b) noexcept {
+      if constexpr (Strict)
+        return a < b;
+      else
+        return a <= b;
+    };
+    bool interpolate = true;
+    while (hi - lo > LINEAR_SCAN) {
+      const std::size_t len = hi - lo;
+      std::size_t m = lo + len / 2;
+      if (interpolate) {
+        /* predict the position of t in [lo, hi-1] */
+        const double span = traits::offset(m_data[hi - 1], m_data[lo]);
+        const double x = traits::offset(t, m_data[lo]);
+        if (span > 0e0) {
+          double f = x / span;
+          f = (f < 0e0) ? 0e0 : ((f > 1e0) ? 1e0 : f);
+          m = lo + static_cast<std::size_t>(f * static_cast<double>(len - 1));
+        }
+      }
+      if (less(m_data[m], t))
+        lo = m + 1;
+      else
+        hi = m;
+      /* fall back to bisection if the range was not (at least) halved */
+      interpolate = (hi - lo <= len / 2);
+    }
+    while (lo < hi && less(m_data[lo], t))
+      ++lo;
+    return lo;
+  }
+
+  /** @brief As search, but for sorted query streams: start at start
+   * (assuming less(m_data[start-1], t)) and gallop forward to bracket t.
+   */
+  template <bool Strict>
+  std::size_t search_from(const T &t, std::size_t start) const noexcept {
+    const auto less = [](const T &a, const T &b) noexcept {
+      if constexpr (Strict)
+        return a < b;
+      else
+        return a <= b;
+    };
+    /* the query stream went backwards; start over */
+    if (start > m_size || (start > 0 && !less(m_data[start - 1], t)))
+      start = 0;
+    std::size_t step = 1;
+    std::size_t lo = start;
+    std::size_t hi = start;
+    while (hi < m_size && less(m_data[hi], t)) {
+      lo = hi + 1;
+      hi = (m_size - hi > step) ? hi + step : m_size;
+      step *= 2;
+    }
+    return search<Strict>(t, lo, hi);
+  }
+
+  /** @brief Index of the element nearest to t, given its ceil index c */
+  std::size_t nearest_from_ceil(const T &t, std::size_t c) const noexcept {
+    if (!m_size)
+      return npos;
+    if (c == 0)
+      return 0;
+    if (c == m_size)
+      return m_size - 1;
+    return traits::closer_to_floor(m_data[c - 1], t, m_data[c]) ? c - 1 : c;
+  }
+
+public:
+  /** @brief Constructor from a sorted array of n epochs */
+  EpochIndex(const T *sorted, std::size_t n) noexcept
+      : m_data(sorted), m_size(n) {
+#ifdef DEBUG
+    assert(std::is_sorted(sorted, sorted + n));
+#endif
+  }
+
+  /** @brief Number of epochs indexed */
+  std::size_t size() const noexcept { return m_size; }
+
+  /** @brief The underlying (sorted) array */
+  const T *data() const noexcept { return m_data; }
+
+  /** @brief The i-th epoch */
+  const T &operator[](std::size_t i) const noexcept { return m_data[i]; }
+
+  /** @brief First index i such that epoch[i] >= t, or size() if none (as
+   * std::lower_bound).
+   */
+  std::size_t lower_bound(const T &t) const noexcept {
+    return search<true>(t, 0, m_size);
+  }
+
+  /** @brief First index i such that epoch[i] > t, or size() if none (as
+   * std::upper_bound).
+   */
+  std::size_t upper_bound(const T &t) const noexcept {
+    return search<false>(t, 0, m_size);
+  }
+
+  /** @brief Index of the first epoch >= t, or npos if none. */
+  std::size_t ceil(const T &t) const noexcept {
+    const std::size_t i = lower_bound(t);
+    return (i < m_size) ? i : npos;
+  }
+
+  /** @brief Index of the last epoch <= t, or npos if none. */
+  std::size_t floor(const T &t) const noexcept {
+    const std::size_t i = upper_bound(t);
+    return (i > 0) ? i - 1 : npos;
+  }
+
+  /** @brief Index of the epoch nearest to t, or npos if the index is
+   * empty. On ties, the earlier epoch is returned.
+   */
+  std::size_t nearest(const T &t) const noexcept {
+    return nearest_from_ceil(t, lower_bound(t));
+  }
+
+  /** @brief Range [first, last) of epochs within [t - tol, t + tol].
+   *
+   * If no epoch is within the window, first == last.
+   */
+  std::pair<std::size_t, std::size_t> window(const T &t,
+                                             tolerance_type tol) const
+      noexcept {
+    const std::size_t first =
+        lower_bound(traits::shift(t, tolerance_type(0) - tol));
+    const std::size_t last = search<false>(traits::shift(t, tol), first,
+                                           m_size);
+    return {first, last};
+  }
+
+  /** @brief Batch version of ceil, i.e. out[i] = ceil(t[i]).
+   *
+   * Fastest when the queries t are sorted.
+   */
+  void ceil_batch(const T *t, std::size_t n, std::size_t *out) const
+      noexcept {
+    std::size_t prev = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      prev = search_from<true>(t[i], prev);
+      out[i] = (prev < m_size) ? prev : npos;
+    }
+  }
+
+  /** @brief Batch version of floor, i.e. out[i] = floor(t[i]).
+   *
+   * Fastest when the queries t are sorted.
+   */
+  void floor_batch(const T *t, std::size_t n, std::size_t *out) const
+      noexcept {
+    std::size_t prev = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      prev = search_from<false>(t[i], prev);
+      out[i] = (prev > 0) ? prev - 1 : npos;
+    }
+  }
+
+  /** @brief Batch version of nearest, i.e. out[i] = nearest(t[i]).
+   *
+   * Fastest when the queries t are sorted.
+   */
+  void nearest_batch(const T *t, std::size_t n, std::size_t *out) const
+      noexcept {
+    std::size_t prev = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      prev = search_from<true>(t[i], prev);
+      out[i] = nearest_from_ceil(t[i], prev);
+    }
+  }
+
+  /** @brief Batch version of window, i.e. [first[i], last[i]) =
+   * window(t[i], tol).
+   *
+   * Fastest when the queries t are sorted.
+   */
+  void window_batch(const T *t, std::size_t n, tolerance_type tol,
+                    std::size_t *first, std::size_t *last) const noexcept {
+    std::size_t pf = 0, pl = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      pf = search_from<true>(traits::shift(t[i], tolerance_type(0) - tol),
+                             pf);
+      pl = search_from<false>(traits::shift(t[i], tol), (pl > pf) ? pl : pf);
+      first[i] = pf;
+      last[i] = pl;
+    }
+  }
+}; /* class EpochIndex */
+
+} /* namespace dso */
+
+#endif
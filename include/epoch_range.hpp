@@ -0,0 +1,324 @@
+/** @file
+ *
+ * Lazy, random-access views of evenly spaced epochs, i.e. the epochs
+ * start + i * step, for i = 0, 1, ..., count-1.
+ *
+ * Epochs are never computed by repeatedly adding the step to the previous
+ * epoch; the i-th epoch is computed directly from the start epoch and the
+ * (exact, integral) offset i * step. Hence, there is no accumulated error
+ * (neither for TwoPartDate), and random access is O(1), so that e.g.
+ * parallel consumers can split the range at will.
+ *
+ * The step is always an integral second type S; the epochs can be:
+ * - datetime<S>; the result is exact,
+ * - datetime_utc<S>; the result is exact, and accounts for leap seconds
+ *   (i.e. the step is elapsed time), and
+ * - TwoPartDate; the (exact) offset is converted to fractional seconds and
+ *   added to the start epoch, i.e. the error is bounded by a few ulp's of
+ *   the seconds of day, independent of i.
+ *
+ * Example:
+ * // 30-sec grid, one day long
+ * for (const auto &t : epoch_range(t0, nanoseconds(30'000'000'000L), 2880))
+ *   ...
+ * // same, up to (excluding) t1
+ * epoch_range r(t0, t1, nanoseconds(30'000'000'000L));
+ */
+
+#ifndef __DSO_DATETIME_EPOCH_RANGE_HPP__
+#define __DSO_DATETIME_EPOCH_RANGE_HPP__
+
+#include "core/int128.hpp"
+#include "datetime_utc.hpp"
+#include "dtdatetime.hpp"
+#include "tpdate.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+
+namespace dso {
+
+/** @brief A lazy view of the epochs start + i * step, i in [0, count).
+ *
+ * @tparam T The type of the epochs, i.e. datetime<S>, datetime_utc<S> or
+ *           TwoPartDate
+ * @tparam S The (integral) second type of the step
+ *
+ * @warning Epochs are computed without overflow checks; the span of the
+ *          range, i.e. (count - 1) * step, must be within the range of an
+ *          MJD (i.e. of an int, in days).
+ */
+#if __cplusplus >= 202002L
+template <typename T, gconcepts::is_sec_dt S>
+#else
+template <typename T, class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+class epoch_range {
+  static_assert(std::is_same_v<T, datetime<S>> ||
+                    std::is_same_v<T, datetime_utc<S>> ||
+                    std::is_same_v<T, TwoPartDate>,
+                "epoch_range: epochs must be datetime<S>, datetime_utc<S> or "
+                "TwoPartDate");
+  using I = typename S::underlying_type;
+  static constexpr const I F = S::max_in_day;
+
+public:
+  /** @brief A random-access iterator over the range.
+   *
+   * Dereferencing computes (and returns by value) the epoch.
+   */
+  class iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = T;
+
+    iterator() noexcept : m_range(nullptr), m_i(0) {}
+    iterator(const epoch_range *r, std::size_t i) noexcept
+        : m_range(r), m_i(i) {}
+
+    T operator*() const noexcept { return (*m_range)[m_i]; }
+    T operator[](difference_type n) const noexcept {
+      return (*m_range)[m_i + n];
+    }
+    /** @brief Index of the epoch in the range */
+    std::size_t index() const noexcept { return m_i; }
+
+    iterator &operator++() noexcept {
+      ++m_i;
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      iterator t(*this);
+      ++m_i;
+      return t;
+    }
+    iterator &operator--() noexcept {
+      --m_i;
+      return *this;
+    }
+    iterator operator--(int) noexcept {
+      iterator t(*this);
+      --m_i;
+      return t;
+    }
+    iterator &operator+=(difference_type n) noexcept {
+      m_i += n;
+      return *this;
+    }
+    iterator &operator-=(difference_type n) noexcept {
+      m_i -= n;
+      return *this;
+    }
+    iterator operator+(difference_type n) const noexcept {
+      return iterator(m_range, m_i + n);
+    }
+    friend iterator operator+(difference_type n, const iterator &it) noexcept {
+      return it + n;
+    }
+    iterator operator-(difference_type n) const noexcept {
+      return iterator(m_range, m_i - n);
+    }
+    difference_type operator-(const iterator &it) const noexcept {
+      return static_cast<difference_type>(m_i) -
+             static_cast<difference_type>(it.m_i);
+    }
+    bool operator==(const iterator &it) const noexcept {
+      return m_i == it.m_i;
+    }
+    bool operator!=(const iterator &it) const noexcept {
+      return m_i != it.m_i;
+    }
+    bool operator<(const iterator &it) const noexcept { return m_i < it.m_i; }
+    bool operator>(const iterator &it) const noexcept { return m_i > it.m_i; }
+    bool operator<=(const iterator &it) const noexcept {
+      return m_i <= it.m_i;
+    }
+    bool operator>=(const iterator &it) const noexcept {
+      return m_i >= it.m_i;
+    }
+
+  private:
+    const epoch_range *m_range;
+    std::size_t m_i;
+  }; /* class iterator */
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_iterator = iterator;
+
+  /** @brief Range of count epochs, starting at start, every step. */
+  epoch_range(const T &start, S step, std::size_t count) noexcept
+      : m_start(start), m_step(step), m_count(count) {
+    split_step();
+  }
+
+  /** @brief Range of epochs starting at start, every step, up to (and
+   * excluding) stop.
+   *
+   * For a positive step, the range holds all epochs start + i * step that
+   * are < stop; for a negative step, the ones that are > stop. If stop is
+   * not reachable from start (e.g. stop < start for a positive step), the
+   * range is empty.
+   *
+   * @throw std::invalid_argument if step is zero.
+   */
+  epoch_range(const T &start, const T &stop, S step)
+      : m_start(start), m_step(step), m_count(0) {
+    if (step == S(0)) {
+      fprintf(stderr,
+              "[ERROR] Cannot construct an epoch range with zero step "
+              "(traceback: %s)\n",
+              __func__);
+      throw std::invalid_argument(
+          "[ERROR] Cannot construct an epoch range with zero step\n");
+    }
+    split_step();
+    const bool forward = (step > S(0));
+    const auto before = [forward, &stop](const T &t) noexcept {
+      return forward ? (t < stop) : (stop < t);
+    };
+    /* estimate, then correct using the exact epochs */
+    const double x =
+        seconds_between(start, stop) /
+        (static_cast<double>(step.as_underlying_type()) * S::sec_inv_factor());
+    std::size_t n = (x > 0e0) ? static_cast<std::size_t>(std::ceil(x)) : 0;
+    while (n > 0 && !before(at_index(n - 1)))
+      --n;
+    while (before(at_index(n)))
+      ++n;
+    m_count = n;
+  }
+
+  /** @brief Number of epochs in the range */
+  std::size_t size() const noexcept { return m_count; }
+
+  /** @brief true if the range holds no epochs */
+  bool empty() const noexcept { return m_count == 0; }
+
+  /** @brief The first epoch of the range */
+  const T &start() const noexcept { return m_start; }
+
+  /** @brief The step */
+  S step() const noexcept { return m_step; }
+
+  /** @brief The i-th epoch, i.e. start + i * step (no bounds check). */
+  T operator[](std::size_t i) const noexcept { return at_index(i); }
+
+  /** @brief The i-th epoch, i.e. start + i * step.
+   *
+   * @throw std::out_of_range if i >= size()
+   */
+  T at(std::size_t i) const {
+    if (i >= m_count) {
+      fprintf(stderr,
+              "[ERROR] Index %zu out of epoch range of size %zu (traceback: "
+              "%s)\n",
+              i, m_count, __func__);
+      throw std::out_of_range("[ERROR] Index out of epoch range\n");
+    }
+    return at_index(i);
+  }
+
+  /** @brief First epoch; the range must not be empty */
+  T front() const noexcept { return at_index(0); }
+
+  /** @brief Last epoch; the range must not be empty */
+  T back() const noexcept { return at_index(m_count - 1); }
+
+  iterator begin() const noexcept { return iterator(this, 0); }
+  iterator end() const noexcept { return iterator(this, m_count); }
+
+private:
+  T m_start;
+  S m_step;
+  std::size_t m_count;
+  /** the step, as whole days and ticks in [0, F), i.e. step = m_step_days *
+   * F + m_step_rem (floor division) */
+  I m_step_days;
+  I m_step_rem;
+
+  void split_step() noexcept {
+    const I s = m_step.as_underlying_type();
+    m_step_days = s / F;
+    m_step_rem = s - m_step_days * F;
+    if (m_step_rem < 0) {
+      --m_step_days;
+      m_step_rem += F;
+    }
+  }
+
+  /** @brief i * step, as whole days and ticks in [0, F).
+   *
+   * i * m_step_rem is computed in 64 bits when it fits, else via
+   * core::mul_divmod (i.e. without overflow). The whole days, i.e.
+   * i * m_step_days + carry, are computed in I and not checked; they are
+   * only meaningful within the range of an MJD (see epoch_range).
+   */
+  void offset(std::size_t i, I &days, I &rem) const noexcept {
+    const std::uint64_t ui = i;
+    const std::uint64_t sr = static_cast<std::uint64_t>(m_step_rem);
+    const std::uint64_t f = static_cast<std::uint64_t>(F);
+    std::uint64_t q, r;
+    if (sr == 0 || ui <= UINT64_MAX / sr) {
+      /* division by a constant */
+      const std::uint64_t p = ui * sr;
+      q = p / f;
+      r = p - q * f;
+    } else {
+      core::mul_divmod(ui, sr, f, q, r);
+    }
+    days = static_cast<I>(i) * m_step_days + static_cast<I>(q);
+    rem = static_cast<I>(r);
+  }
+
+  /** @brief The i-th epoch */
+  T at_index(std::size_t i) const noexcept {
+    if constexpr (std::is_same_v<T, datetime<S>>) {
+      I days, rem;
+      offset(i, days, rem);
+      I sec = m_start.sec().as_underlying_type() + rem;
+      const int carry = (sec >= F);
+      sec -= carry * F;
+      return datetime<S>::non_normalize_construct(
+          modified_julian_day(m_start.imjd().as_underlying_type() +
+                              static_cast<int>(days) + carry),
+          S(sec));
+    } else if constexpr (std::is_same_v<T, TwoPartDate>) {
+      I days, rem;
+      offset(i, days, rem);
+      return TwoPartDate(m_start.imjd() + static_cast<int>(days),
+                         FractionalSeconds(m_start.seconds().seconds() +
+                                           static_cast<double>(rem) *
+                                               S::sec_inv_factor()));
+    } else {
+      /* UTC: the offset is elapsed time; let add_seconds handle leap
+       * seconds */
+      T t(m_start);
+      t.add_seconds(
+          S(static_cast<I>(i) * m_step.as_underlying_type()));
+      return t;
+    }
+  }
+
+  /** @brief (Approximate) seconds from a to b */
+  static double seconds_between(const T &a, const T &b) noexcept {
+    if constexpr (std::is_same_v<T, TwoPartDate>) {
+      return b.template diff<DateTimeDifferenceType::FractionalSeconds>(a)
+          .seconds();
+    } else {
+      return static_cast<double>(
+                 (b - a).signed_total_sec().as_underlying_type()) *
+             S::sec_inv_factor();
+    }
+  }
+}; /* class epoch_range */
+
+} /* namespace dso */
+
+#endif
@@ -0,0 +1,464 @@
+/** @file
+ *
+ * Snap (i.e. floor, ceil or round) epochs to a regular sampling grid, e.g.
+ * align observations to 30 sec, 5 min or 1 day bins.
+ *
+ * The grid consists of the epochs k * interval (k an integer), counted from
+ * MJD 0 at 00:00:00; hence, for intervals that divide the day (e.g. 30 sec,
+ * 5 min, 1 day) grid epochs are aligned to the start of each day. Leap
+ * seconds are not considered (i.e. every day has 86400 sec).
+ *
+ * For datetime<S>, the interval is of type S and everything is computed in
+ * (exact) integer arithmetic. For TwoPartDate, the interval is given in
+ * FractionalSeconds; the residual (i.e. epoch - snapped epoch) is computed
+ * via error-free transformations (FMA) and is (practically) exact, while
+ * the snapped epoch is correctly rounded.
+ *
+ * Batch versions process arrays of epochs, returning the snapped epochs and
+ * the residuals. The snapping mode is resolved once per batch, and the
+ * (mostly branch-free) kernels avoid integer divisions, so that loops can be
+ * vectorized. Results are identical to the scalar versions.
+ */
+
+#ifndef __DSO_DATETIME_EPOCH_SNAP_HPP__
+#define __DSO_DATETIME_EPOCH_SNAP_HPP__
+
+#include "core/int128.hpp"
+#include "date_batch.hpp"
+#include "diff_batch.hpp"
+#include "dtdatetime.hpp"
+#include "tpdate.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+namespace dso {
+
+/** @brief How to snap an epoch to a grid. */
+enum class SnapMode : char {
+  Floor,  /**< latest grid epoch <= epoch */
+  Ceil,   /**< earliest grid epoch >= epoch */
+  Nearest /**< nearest grid epoch; on ties, the earlier one */
+};
+
+namespace core {
+
+/** @brief 1 if an epoch should be snapped to the next grid epoch, 0 if to
+ * the previous one, given its residual r in [0, interval) from the previous
+ * grid epoch.
+ */
+template <SnapMode M, typename V>
+inline V snap_up(V r, V interval) noexcept {
+  if constexpr (M == SnapMode::Floor) {
+    return V(0);
+  } else if constexpr (M == SnapMode::Ceil) {
+    return static_cast<V>(r > V(0));
+  } else {
+    return static_cast<V>(r > interval - r);
+  }
+}
+
+/** @brief Offset to add to an epoch to snap it to the grid, given its
+ * residual r in [0, interval) from the previous grid epoch.
+ */
+template <SnapMode M, typename V>
+inline V snap_offset(V r, V interval) noexcept {
+  return snap_up<M>(r, interval) * interval - r;
+}
+
+/** @brief Residual of a datetime<S> from the previous grid epoch, in
+ * [0, interval).
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+inline typename S::underlying_type
+snap_residual(const datetime<S> &t,
+              typename S::underlying_type interval) noexcept {
+  using I = typename S::underlying_type;
+  const I sec = t.sec().as_underlying_type();
+  /* whole days are on the grid */
+  if (S::max_in_day % interval == 0)
+    return sec % interval;
+  /* (mjd * max_in_day + sec) mod interval, without a 128-bit product */
+  const long mjd = t.imjd().as_underlying_type();
+  const std::uint64_t iv = static_cast<std::uint64_t>(interval);
+  std::uint64_t q, r;
+  core::mul_divmod(static_cast<std::uint64_t>((mjd < 0) ? -mjd : mjd),
+                   static_cast<std::uint64_t>(S::max_in_day), iv, q, r);
+  if (mjd < 0)
+    r = (iv - r) % iv;
+  return static_cast<I>((r + static_cast<std::uint64_t>(sec) % iv) % iv);
+}
+
+/** @brief Snap a datetime<S> given the offset to add (in ticks of S). */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+inline datetime<S> snap_apply(const datetime<S> &t,
+                              typename S::underlying_type offset,
+                              typename S::underlying_type interval) noexcept {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  I sec = t.sec().as_underlying_type() + offset;
+  if (interval <= F) {
+    /* at most one day crossed */
+    const I more = (sec >= F);
+    const I less = (sec < 0);
+    sec += (less - more) * F;
+    return datetime<S>::non_normalize_construct(
+        modified_julian_day(t.imjd().as_underlying_type() +
+                            static_cast<int>(more - less)),
+        S(sec));
+  }
+  return datetime<S>(t.imjd(), S(sec));
+}
+
+/** @brief Locate a TwoPartDate on a grid of the given interval (in sec).
+ *
+ * The epoch is t = d + q * interval - p + r, where d is the start of its
+ * day, d - p is the latest grid epoch <= d, q is integral and r (the
+ * residual) is in [0, interval). The residual is compensated, i.e. computed
+ * (via error-free transformations) from the exact value of p + seconds of
+ * day, and rounded once.
+ *
+ * @param[in]  day_aligned True if the interval divides the day (i.e. p = 0)
+ * @param[out] q Index of the previous grid epoch, counted from d - p
+ * @param[out] p Offset of the start of the day from the grid
+ * @return The residual r
+ */
+inline double snap_locate(const TwoPartDate &t, double interval,
+                          bool day_aligned, double &q, double &p) noexcept {
+  double hi = t.seconds().seconds();
+  double lo = 0e0;
+  p = 0e0;
+  if (!day_aligned) {
+    /* mjd * 86400 is exact, and so is fmod */
+    p = std::fmod(static_cast<double>(t.imjd()) * 86400e0, interval);
+    p += (p < 0e0) * interval;
+    two_sum(p, t.seconds().seconds(), hi, lo);
+  }
+  q = std::floor(hi / interval);
+  /* exact, for the right quotient (which is off by at most one) */
+  double r = std::fma(-q, interval, hi);
+  q += (r >= interval) - (r < 0e0);
+  r = std::fma(-q, interval, hi) + lo;
+  /* the compensation term may push r (slightly) out of range */
+  const double w = (r >= interval) - (r < 0e0);
+  q += w;
+  return r - w * interval;
+}
+
+/** @brief Snap a TwoPartDate to the grid epoch d + q * interval - p (see
+ * snap_locate); its seconds of day are rounded once.
+ */
+inline TwoPartDate snap_apply(const TwoPartDate &t, double q, double interval,
+                              double p) noexcept {
+  double sec = std::fma(q, interval, -p);
+  int mjd = t.imjd();
+  if (!(sec >= 0e0 && sec < 86400e0)) {
+    /* at most one day crossed, for intervals up to a day; else the
+     * constructor will normalize */
+    const int more = (sec >= 86400e0) && (sec < 2 * 86400e0);
+    const int less = (sec < 0e0) && (sec >= -86400e0);
+    sec += (less - more) * 86400e0;
+    mjd += more - less;
+  }
+  return TwoPartDate(mjd, FractionalSeconds(sec));
+}
+
+/** @brief Snap a TwoPartDate, for a given mode.
+ *
+ * @return The residual, i.e. t - snapped in seconds
+ */
+template <SnapMode M>
+inline double snap_one(const TwoPartDate &t, double interval,
+                       bool day_aligned, TwoPartDate &snapped) noexcept {
+  double q, p;
+  const double r = snap_locate(t, interval, day_aligned, q, p);
+  const double up = snap_up<M>(r, interval);
+  snapped = snap_apply(t, q + up, interval, p);
+  return r - up * interval;
+}
+
+/** @brief True if the interval (in seconds) divides the day. */
+inline bool snap_day_aligned(double interval) noexcept {
+  return std::fmod(86400e0, interval) == 0e0;
+}
+
+/** @brief Check that a grid interval is positive. */
+template <typename V> inline void snap_check_interval(V interval) {
+  if (!(interval > V(0))) {
+    fprintf(stderr,
+            "[ERROR] Grid interval for snapping must be positive "
+            "(traceback: %s)\n",
+            __func__);
+    throw std::invalid_argument(
+        "[ERROR] Grid interval for snapping must be positive\n");
+  }
+}
+
+/** @brief Batch snapping of datetime<S>, for a given mode. */
+template <SnapMode M, typename S>
+void snap_batch_impl(const datetime<S> *t, std::size_t n, S interval,
+                     datetime<S> *snapped, S *residual) noexcept {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  const I iv = interval.as_underlying_type();
+  if ((F % iv == 0) && (F <= (I(1) << 53))) {
+    /* residual from seconds of day only; replace the integer division by a
+     * (double) multiplication, and correct the quotient (which can only be
+     * off by one) */
+    const double inv = 1e0 / static_cast<double>(iv);
+    for (std::size_t i = 0; i < n; i++) {
+      const I sec = t[i].sec().as_underlying_type();
+      const I q = static_cast<I>(static_cast<double>(sec) * inv);
+      I r = sec - q * iv;
+      r += ((r < 0) - (r >= iv)) * iv;
+      const I off = snap_offset<M>(r, iv);
+      I s = sec + off;
+      const I more = (s >= F);
+      const I less = (s < 0);
+      s += (less - more) * F;
+      snapped[i] = datetime<S>::non_normalize_construct(
+          modified_julian_day(t[i].imjd().as_underlying_type() +
+                              static_cast<int>(more - less)),
+          S(s));
+      residual[i] = S(-off);
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      const I off = snap_offset<M>(snap_residual(t[i], iv), iv);
+      snapped[i] = snap_apply(t[i], off, iv);
+      residual[i] = S(-off);
+    }
+  }
+}
+
+/** @brief Batch snapping of TwoPartDate, for a given mode. */
+template <SnapMode M>
+void snap_batch_impl(const TwoPartDate *t, std::size_t n, double interval,
+                     TwoPartDate *snapped, double *residual) noexcept {
+  const bool aligned = snap_day_aligned(interval);
+  for (std::size_t i = 0; i < n; i++)
+    residual[i] = snap_one<M>(t[i], interval, aligned, snapped[i]);
+}
+
+/** @brief Snap a TwoPartDate; returns the residual (in seconds). */
+inline double snap_tpd(const TwoPartDate &t, double interval, SnapMode mode,
+                       TwoPartDate &snapped) {
+  snap_check_interval(interval);
+  const bool aligned = snap_day_aligned(interval);
+  switch (mode) {
+  case SnapMode::Floor:
+    return snap_one<SnapMode::Floor>(t, interval, aligned, snapped);
+  case SnapMode::Ceil:
+    return snap_one<SnapMode::Ceil>(t, interval, aligned, snapped);
+  default:
+    return snap_one<SnapMode::Nearest>(t, interval, aligned, snapped);
+  }
+}
+} /* namespace core */
+
+/** @brief Snap a datetime<S> to a grid of the given interval.
+ *
+ * @param[in] t        The epoch
+ * @param[in] interval The grid interval (must be positive)
+ * @param[in] mode     Floor, ceil or nearest
+ * @return The snapped epoch
+ * @throw std::invalid_argument if the interval is not positive
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+datetime<S> snap(const datetime<S> &t, S interval,
+                 SnapMode mode = SnapMode::Nearest) {
+  using I = typename S::underlying_type;
+  const I iv = interval.as_underlying_type();
+  core::snap_check_interval(iv);
+  const I r = core::snap_residual(t, iv);
+  I off;
+  switch (mode) {
+  case SnapMode::Floor:
+    off = core::snap_offset<SnapMode::Floor>(r, iv);
+    break;
+  case SnapMode::Ceil:
+    off = core::snap_offset<SnapMode::Ceil>(r, iv);
+    break;
+  default:
+    off = core::snap_offset<SnapMode::Nearest>(r, iv);
+  }
+  return core::snap_apply(t, off, iv);
+}
+
+/** @brief Snap a datetime<S> to a grid, if within a tolerance.
+ *
+ * @param[in]  t         The epoch
+ * @param[in]  interval  The grid interval (must be positive)
+ * @param[in]  mode      Floor, ceil or nearest
+ * @param[in]  tolerance Maximum (absolute) residual allowed
+ * @param[out] snapped   The snapped epoch (always set)
+ * @return True if |t - snapped| <= tolerance
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+bool snap(const datetime<S> &t, S interval, SnapMode mode, S tolerance,
+          datetime<S> &snapped) {
+  snapped = snap(t, interval, mode);
+  const auto r = (t - snapped).signed_total_sec();
+  return (r < S(0) ? S(0) - r : r) <= tolerance;
+}
+
+/** @brief Snap a TwoPartDate to a grid of the given interval.
+ *
+ * @param[in] t        The (normalized) epoch
+ * @param[in] interval The grid interval (must be positive)
+ * @param[in] mode     Floor, ceil or nearest
+ * @return The snapped epoch
+ * @throw std::invalid_argument if the interval is not positive
+ */
+inline TwoPartDate snap(const TwoPartDate &t, FractionalSeconds interval,
+                        SnapMode mode = SnapMode::Nearest) {
+  TwoPartDate snapped;
+  core::snap_tpd(t, interval.seconds(), mode, snapped);
+  return snapped;
+}
+
+/** @brief Snap a TwoPartDate to a grid, if within a tolerance.
+ *
+ * See the datetime<S> version.
+ */
+inline bool snap(const TwoPartDate &t, FractionalSeconds interval,
+                 SnapMode mode, FractionalSeconds tolerance,
+                 TwoPartDate &snapped) {
+  return std::abs(core::snap_tpd(t, interval.seconds(), mode, snapped)) <=
+         tolerance.seconds();
+}
+
+/** @brief Batch snapping of datetime<S> epochs to a grid.
+ *
+ * @param[in]  t        Array of n epochs
+ * @param[in]  n        Number of epochs
+ * @param[in]  interval The grid interval (must be positive)
+ * @param[in]  mode     Floor, ceil or nearest
+ * @param[out] snapped  Array of n epochs; at output, the snapped epochs
+ * @param[out] residual Array of n elements; at output, t[i] - snapped[i]
+ * @throw std::invalid_argument if the interval is not positive
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+void snap_batch(const datetime<S> *t, std::size_t n, S interval,
+                SnapMode mode, datetime<S> *snapped, S *residual) {
+  core::snap_check_interval(interval.as_underlying_type());
+  switch (mode) {
+  case SnapMode::Floor:
+    return core::snap_batch_impl<SnapMode::Floor>(t, n, interval, snapped,
+                                                  residual);
+  case SnapMode::Ceil:
+    return core::snap_batch_impl<SnapMode::Ceil>(t, n, interval, snapped,
+                                                 residual);
+  default:
+    return core::snap_batch_impl<SnapMode::Nearest>(t, n, interval, snapped,
+                                                    residual);
+  }
+}
+
+/** @brief Batch snapping of datetime<S> epochs to a grid, with a
+ * tolerance.
+ *
+ * Same as above; in addition, bit i of mask (see batch_mask_words and
+ * batch_mask_test) is set if |residual[i]| <= tolerance.
+ *
+ * @return The number of epochs within tolerance
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+std::size_t snap_batch(const datetime<S> *t, std::size_t n, S interval,
+                       SnapMode mode, S tolerance, datetime<S> *snapped,
+                       S *residual, std::uint64_t *mask) {
+  using I = typename S::underlying_type;
+  snap_batch(t, n, interval, mode, snapped, residual);
+  const I tol = tolerance.as_underlying_type();
+  const auto within = [residual, tol](std::size_t i) noexcept {
+    const I r = residual[i].as_underlying_type();
+    return (r <= tol) & (-r <= tol);
+  };
+  std::size_t count = 0;
+  for (std::size_t w = 0; w < batch_mask_words(n); w++)
+    count += batch_mask_fill(mask, w, n, within);
+  return count;
+}
+
+/** @brief Batch snapping of TwoPartDate epochs to a grid.
+ *
+ * @param[in]  t        Array of n (normalized) epochs
+ * @param[in]  n        Number of epochs
+ * @param[in]  interval The grid interval (must be positive)
+ * @param[in]  mode     Floor, ceil or nearest
+ * @param[out] snapped  Array of n epochs; at output, the snapped epochs
+ * @param[out] residual Array of n elements; at output, t[i] - snapped[i]
+ *                      in seconds
+ * @throw std::invalid_argument if the interval is not positive
+ */
+inline void snap_batch(const TwoPartDate *t, std::size_t n,
+                       FractionalSeconds interval, SnapMode mode,
+                       TwoPartDate *snapped, double *residual) {
+  const double iv = interval.seconds();
+  core::snap_check_interval(iv);
+  switch (mode) {
+  case SnapMode::Floor:
+    return core::snap_batch_impl<SnapMode::Floor>(t, n, iv, snapped,
+                                                  residual);
+  case SnapMode::Ceil:
+    return core::snap_batch_impl<SnapMode::Ceil>(t, n, iv, snapped,
+                                                 residual);
+  default:
+    return core::snap_batch_impl<SnapMode::Nearest>(t, n, iv, snapped,
+                                                    residual);
+  }
+}
+
+/** @brief Batch snapping of TwoPartDate epochs to a grid, with a
+ * tolerance.
+ *
+ * Same as above; in addition, bit i of mask (see batch_mask_words and
+ * batch_mask_test) is set if |residual[i]| <= tolerance.
+ *
+ * @return The number of epochs within tolerance
+ */
+inline std::size_t snap_batch(const TwoPartDate *t, std::size_t n,
+                              FractionalSeconds interval, SnapMode mode,
+                              FractionalSeconds tolerance,
+                              TwoPartDate *snapped, double *residual,
+                              std::uint64_t *mask) {
+  snap_batch(t, n, interval, mode, snapped, residual);
+  const double tol = tolerance.seconds();
+  const auto within = [residual, tol](std::size_t i) noexcept {
+    return std::abs(residual[i]) <= tol;
+  };
+  std::size_t count = 0;
+  for (std::size_t w = 0; w < batch_mask_words(n); w++)
+    count += batch_mask_fill(mask, w, n, within);
+  return count;
+}
+
+} /* namespace dso */
+
+#endif
@@ -0,0 +1,464 @@
+/** @file
+ *
+ * Sorting and merging of (large) arrays of epochs, or of records holding an
+ * epoch.
+ *
+ * radix_sort performs an LSD radix sort, keyed on the (MJD, seconds of day)
+ * pair of each epoch; the epoch of a record is given by a key-extraction
+ * callback, returning a datetime<S> or a TwoPartDate. Where the range of
+ * the input allows (e.g. datetime<nanoseconds> spanning less than ~580
+ * years), the pair is packed in a single 64-bit key; only the key bits that
+ * actually vary within the input are sorted on, using 11-bit digits (so that
+ * e.g. a few years of datetime<nanoseconds> epochs need 6 passes,
+ * independent of the number of elements). The sort is stable.
+ *
+ * merge_sorted performs a stable k-way merge of (already) sorted streams,
+ * e.g. per-station observation records; records with equal epochs are
+ * output in the order of the streams they come from.
+ *
+ * The parallel_ variants split the work among (at most) num_threads
+ * threads and produce exactly the same results as the serial ones.
+ *
+ * Note that TwoPartDate keys must be normalized (i.e. seconds of day in
+ * [0, 86400)); datetime<S> instances are always normalized.
+ */
+
+#ifndef __DSO_DATETIME_EPOCH_SORT_HPP__
+#define __DSO_DATETIME_EPOCH_SORT_HPP__
+
+#include "core/parallel_chunks.hpp"
+#include "dtdatetime.hpp"
+#include "tpdate.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dso {
+
+namespace core {
+
+/** Minimum number of elements per thread, for parallel sorts/merges */
+constexpr const std::size_t EPOCH_SORT_GRAIN = std::size_t(1) << 15;
+
+/** @brief A radix sort key and the index of the element it belongs to. */
+struct epoch_sort_item {
+  std::uint64_t key;
+  std::size_t idx;
+};
+
+/** @brief Radix sort (LSD) an array of unsigned integer keys.
+ *
+ * Keys are sorted on their bits least significant bits (i.e. all keys must
+ * be less than 2^bits). Passes where all keys share the same digit are
+ * skipped.
+ *
+ * @param[in] keys Array of n keys to be sorted
+ * @param[in] buf  Array of n keys, used as scratch space
+ * @return Pointer to the sorted keys, i.e. either keys or buf
+ */
+std::uint64_t *radix_sort_keys(std::uint64_t *keys, std::uint64_t *buf,
+                               std::size_t n, int bits,
+                               unsigned num_threads);
+
+/** @brief Radix sort (LSD) an array of epoch_sort_item, on their keys.
+ *
+ * Same as radix_sort_keys; the sort is stable.
+ */
+epoch_sort_item *radix_sort_items(epoch_sort_item *items,
+                                  epoch_sort_item *buf, std::size_t n,
+                                  int bits, unsigned num_threads);
+
+/** @brief Radix sort key of a datetime<S>, i.e. MJD and seconds of day */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+inline void epoch_sort_key(const datetime<S> &d, int &mjd,
+                           std::uint64_t &lo) noexcept {
+  mjd = d.imjd().as_underlying_type();
+  lo = static_cast<std::uint64_t>(d.sec().as_underlying_type());
+}
+
+/** @brief Radix sort key of a (normalized) TwoPartDate.
+ *
+ * The bit pattern of a non-negative double is ordered as the value itself.
+ */
+inline void epoch_sort_key(const TwoPartDate &d, int &mjd,
+                           std::uint64_t &lo) noexcept {
+  mjd = d.imjd();
+  const double sec = d.seconds().seconds();
+  std::memcpy(&lo, &sec, sizeof(double));
+  /* -0e0 */
+  if (lo >> 63)
+    lo = 0;
+}
+
+/** @brief Number of significant bits in v */
+inline int epoch_sort_bits(std::uint64_t v) noexcept {
+  int b = 0;
+  for (; v; v >>= 1)
+    ++b;
+  return b;
+}
+
+/** @brief true if (hspan * lo_span + lo_span - 1) fits in 64 bits, i.e. the
+ * (MJD, seconds of day) pair can be packed in a single key.
+ */
+inline bool epoch_sort_packs(std::uint64_t hspan,
+                             std::uint64_t lo_span) noexcept {
+  return hspan <= (UINT64_MAX - (lo_span - 1)) / lo_span;
+}
+
+/** @brief Fill in radix sort items for the records of an array and sort
+ * them.
+ *
+ * If the range of the input allows, the (MJD, seconds of day) pair is
+ * packed in a single 64-bit key, i.e. (MJD - min MJD) * (max lo + 1) + lo;
+ * else, items are sorted on seconds of day and then (stably) on MJD.
+ *
+ * @param[in] first Array of n records
+ * @param[in] key   Key extraction callback, i.e. key(first[i]) returns a
+ *                  datetime<S> or a TwoPartDate
+ * @param[in] items Array of n items (filled in)
+ * @param[in] buf   Array of n items, used as scratch space
+ * @return Pointer to the sorted items, i.e. either items or buf
+ */
+template <typename Rec, typename KeyFn>
+epoch_sort_item *sort_epoch_items(const Rec *first, std::size_t n,
+                                  KeyFn &key, epoch_sort_item *items,
+                                  epoch_sort_item *buf,
+                                  unsigned num_threads) {
+  const unsigned p = num_chunks(n, num_threads, EPOCH_SORT_GRAIN);
+  std::unique_ptr<int[]> mjd(new int[n]);
+  std::vector<int> mjd_min(p), mjd_max(p);
+  std::vector<std::uint64_t> lo_max(p);
+  parallel_chunks(n, p, [&](unsigned t, std::size_t b, std::size_t e) {
+    int mn = INT_MAX, mx = INT_MIN;
+    std::uint64_t lmx = 0;
+    for (std::size_t i = b; i < e; i++) {
+      epoch_sort_key(key(first[i]), mjd[i], items[i].key);
+      items[i].idx = i;
+      mn = std::min(mn, mjd[i]);
+      mx = std::max(mx, mjd[i]);
+      lmx = std::max(lmx, items[i].key);
+    }
+    mjd_min[t] = mn;
+    mjd_max[t] = mx;
+    lo_max[t] = lmx;
+  });
+
+  const int mn = *std::min_element(mjd_min.begin(), mjd_min.end());
+  const int mx = *std::max_element(mjd_max.begin(), mjd_max.end());
+  const std::uint64_t lmx = *std::max_element(lo_max.begin(), lo_max.end());
+  const std::uint64_t hspan = static_cast<std::uint64_t>(
+      static_cast<std::int64_t>(mx) - static_cast<std::int64_t>(mn));
+
+  if (lmx < UINT64_MAX && epoch_sort_packs(hspan, lmx + 1)) {
+    /* single key */
+    const std::uint64_t lo_span = lmx + 1;
+    parallel_chunks(n, p, [&](unsigned, std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; i++)
+        items[i].key += static_cast<std::uint64_t>(
+                            static_cast<std::int64_t>(mjd[i]) - mn) *
+                        lo_span;
+    });
+    return radix_sort_items(items, buf, n,
+                            epoch_sort_bits(hspan * lo_span + lmx), p);
+  }
+
+  /* sort on seconds of day, then on MJD */
+  epoch_sort_item *src =
+      radix_sort_items(items, buf, n, epoch_sort_bits(lmx), p);
+  epoch_sort_item *dst = (src == items) ? buf : items;
+  parallel_chunks(n, p, [&](unsigned, std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; i++)
+      src[i].key = static_cast<std::uint64_t>(
+          static_cast<std::int64_t>(mjd[src[i].idx]) - mn);
+  });
+  return radix_sort_items(src, dst, n, epoch_sort_bits(hspan), p);
+}
+
+/** @brief Stable k-way merge of sorted spans, using a binary heap.
+ *
+ * Ties are resolved by the index of the span, so that the merge is stable.
+ */
+template <typename Rec, typename KeyFn>
+void merge_sorted_spans(const Rec *const *first, const std::size_t *len,
+                        std::size_t k, Rec *out, KeyFn &key) {
+  using K = std::decay_t<decltype(key(*first[0]))>;
+  struct head {
+    K key;
+    std::size_t s;
+  };
+  const auto less = [](const head &a, const head &b) noexcept {
+    return (a.key < b.key) || (!(b.key < a.key) && a.s < b.s);
+  };
+  const auto greater = [&less](const head &a, const head &b) noexcept {
+    return less(b, a);
+  };
+
+  std::vector<head> h;
+  std::vector<std::size_t> pos(k, 0);
+  h.reserve(k);
+  for (std::size_t s = 0; s < k; s++)
+    if (len[s])
+      h.push_back(head{key(first[s][0]), s});
+  std::make_heap(h.begin(), h.end(), greater);
+
+  while (h.size() > 1) {
+    const std::size_t s = h[0].s;
+    *out++ = first[s][pos[s]];
+    if (++pos[s] < len[s]) {
+      /* replace the top of the heap and sift it down */
+      h[0].key = key(first[s][pos[s]]);
+      std::size_t i = 0;
+      const std::size_t m = h.size();
+      for (;;) {
+        std::size_t c = 2 * i + 1;
+        if (c >= m)
+          break;
+        if (c + 1 < m && less(h[c + 1], h[c]))
+          ++c;
+        if (!less(h[c], h[i]))
+          break;
+        std::swap(h[c], h[i]);
+        i = c;
+      }
+    } else {
+      std::pop_heap(h.begin(), h.end(), greater);
+      h.pop_back();
+    }
+  }
+  /* one span left; copy the rest of it */
+  if (!h.empty()) {
+    const std::size_t s = h[0].s;
+    std::copy(first[s] + pos[s], first[s] + len[s], out);
+  }
+}
+} /* namespace core */
+
+/** @brief Sort an array of records by epoch, using (at most) num_threads
+ * threads.
+ *
+ * Records are sorted (stably) in ascending order of key(record), where the
+ * key is a datetime<S> or a TwoPartDate. Rec must be move-constructible and
+ * move-assignable.
+ *
+ * @param[in,out] first Array of n records
+ * @param[in] n   Number of records
+ * @param[in] key Key extraction callback
+ * @param[in] num_threads Maximum number of threads to use
+ */
+template <typename Rec, typename KeyFn>
+void parallel_radix_sort(Rec *first, std::size_t n, KeyFn &&key,
+                         unsigned num_threads) {
+  if (n < 2)
+    return;
+  /* note: not value-initialized */
+  std::unique_ptr<core::epoch_sort_item[]> items(
+      new core::epoch_sort_item[n]);
+  std::unique_ptr<core::epoch_sort_item[]> buf(new core::epoch_sort_item[n]);
+  const core::epoch_sort_item *sorted = core::sort_epoch_items(
+      first, n, key, items.get(), buf.get(), num_threads);
+
+  /* permute the records */
+  std::vector<Rec> tmp(std::make_move_iterator(first),
+                       std::make_move_iterator(first + n));
+  core::parallel_chunks(
+      n, core::num_chunks(n, num_threads, core::EPOCH_SORT_GRAIN),
+      [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i++)
+          first[i] = std::move(tmp[sorted[i].idx]);
+      });
+}
+
+/** @brief Sort an array of records by epoch.
+ *
+ * See parallel_radix_sort; this version is single-threaded.
+ */
+template <typename Rec, typename KeyFn>
+void radix_sort(Rec *first, std::size_t n, KeyFn &&key) {
+  parallel_radix_sort(first, n, key, 1);
+}
+
+/** @brief Sort an array of datetime<S>, using (at most) num_threads
+ * threads.
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+void parallel_radix_sort(datetime<S> *first, std::size_t n,
+                         unsigned num_threads) {
+  using I = typename S::underlying_type;
+  constexpr const std::uint64_t F = S::max_in_day;
+  if (n < 2)
+    return;
+  const unsigned p = core::num_chunks(n, num_threads, core::EPOCH_SORT_GRAIN);
+  std::vector<int> mjd_min(p), mjd_max(p);
+  core::parallel_chunks(n, p, [&](unsigned t, std::size_t b, std::size_t e) {
+    int mn = INT_MAX, mx = INT_MIN;
+    for (std::size_t i = b; i < e; i++) {
+      mn = std::min(mn, first[i].imjd().as_underlying_type());
+      mx = std::max(mx, first[i].imjd().as_underlying_type());
+    }
+    mjd_min[t] = mn;
+    mjd_max[t] = mx;
+  });
+  const int mn = *std::min_element(mjd_min.begin(), mjd_min.end());
+  const int mx = *std::max_element(mjd_max.begin(), mjd_max.end());
+  const std::uint64_t hspan = static_cast<std::uint64_t>(
+      static_cast<std::int64_t>(mx) - static_cast<std::int64_t>(mn));
+
+  if (!core::epoch_sort_packs(hspan, F)) {
+    /* huge range; sort as records */
+    return parallel_radix_sort(
+        first, n,
+        [](const datetime<S> &d) -> const datetime<S> & { return d; },
+        num_threads);
+  }
+
+  /* the key is the epoch itself, i.e. (MJD - min MJD) * F + sec; sort keys
+   * only, no need to permute */
+  std::unique_ptr<std::uint64_t[]> keys(new std::uint64_t[n]);
+  std::unique_ptr<std::uint64_t[]> buf(new std::uint64_t[n]);
+  core::parallel_chunks(n, p, [&](unsigned, std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; i++)
+      keys[i] = static_cast<std::uint64_t>(
+                    static_cast<std::int64_t>(
+                        first[i].imjd().as_underlying_type()) -
+                    mn) *
+                    F +
+                static_cast<std::uint64_t>(first[i].sec().as_underlying_type());
+  });
+  const std::uint64_t *sorted = core::radix_sort_keys(
+      keys.get(), buf.get(), n, core::epoch_sort_bits(hspan * F + (F - 1)),
+      p);
+  core::parallel_chunks(n, p, [&](unsigned, std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; i++)
+      first[i] = datetime<S>::non_normalize_construct(
+          modified_julian_day(mn + static_cast<int>(sorted[i] / F)),
+          S(static_cast<I>(sorted[i] % F)));
+  });
+}
+
+/** @brief Sort an array of datetime<S>. */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+void radix_sort(datetime<S> *first, std::size_t n) {
+  parallel_radix_sort(first, n, 1);
+}
+
+/** @brief Sort an array of (normalized) TwoPartDate, using (at most)
+ * num_threads threads.
+ */
+inline void parallel_radix_sort(TwoPartDate *first, std::size_t n,
+                                unsigned num_threads) {
+  parallel_radix_sort(
+      first, n, [](const TwoPartDate &d) -> const TwoPartDate & { return d; },
+      num_threads);
+}
+
+/** @brief Sort an array of (normalized) TwoPartDate. */
+inline void radix_sort(TwoPartDate *first, std::size_t n) {
+  parallel_radix_sort(first, n, 1);
+}
+
+/** @brief Stable k-way merge of sorted streams of records.
+ *
+ * Each of the k input streams must be sorted in ascending order of
+ * key(record), where the key is e.g. a datetime<S> or a TwoPartDate (any
+ * type with an operator< would do). Records of equal keys are output in the
+ * order of the streams.
+ *
+ * @param[in]  streams Array of k pointers to the streams
+ * @param[in]  sizes   Array of k stream sizes
+ * @param[in]  k       Number of streams
+ * @param[out] out     Array of (at least) sum(sizes) records; at output,
+ *                     the merged records
+ * @param[in]  key     Key extraction callback
+ */
+template <typename Rec, typename KeyFn>
+void merge_sorted(const Rec *const *streams, const std::size_t *sizes,
+                  std::size_t k, Rec *out, KeyFn &&key) {
+  core::merge_sorted_spans(streams, sizes, k, out, key);
+}
+
+/** @brief Stable k-way merge of sorted streams of records, using (at most)
+ * num_threads threads.
+ *
+ * The output is split to (roughly) equal parts, using splitter keys sampled
+ * from the streams; each part is merged independently. Results are the same
+ * as the ones of merge_sorted.
+ */
+template <typename Rec, typename KeyFn>
+void parallel_merge_sorted(const Rec *const *streams,
+                           const std::size_t *sizes, std::size_t k, Rec *out,
+                           KeyFn &&key, unsigned num_threads) {
+  using K = std::decay_t<decltype(key(*streams[0]))>;
+  std::size_t total = 0;
+  for (std::size_t s = 0; s < k; s++)
+    total += sizes[s];
+  const unsigned p = core::num_chunks(total, num_threads,
+                                      core::EPOCH_SORT_GRAIN);
+  if (p == 1 || k == 1)
+    return core::merge_sorted_spans(streams, sizes, k, out, key);
+
+  /* splitters, from samples taken at regular intervals of each stream */
+  const std::size_t m = 16 * p;
+  std::vector<K> samples;
+  samples.reserve(m * k);
+  for (std::size_t s = 0; s < k; s++)
+    for (std::size_t j = 1; sizes[s] && j <= m; j++)
+      samples.push_back(key(streams[s][j * sizes[s] / (m + 1)]));
+  std::sort(samples.begin(), samples.end());
+
+  /* cut each stream at the splitters; elements equal to a splitter go to
+   * the right part, in all streams */
+  std::vector<std::size_t> cuts((p + 1) * k);
+  std::vector<std::size_t> offset(p + 1, 0);
+  for (std::size_t s = 0; s < k; s++) {
+    cuts[s] = 0;
+    cuts[p * k + s] = sizes[s];
+  }
+  for (unsigned q = 1; q < p; q++) {
+    const K &split = samples[q * samples.size() / p];
+    for (std::size_t s = 0; s < k; s++) {
+      cuts[q * k + s] = std::lower_bound(streams[s], streams[s] + sizes[s],
+                                         split,
+                                         [&key](const Rec &r, const K &v) {
+                                           return key(r) < v;
+                                         }) -
+                        streams[s];
+      offset[q] += cuts[q * k + s];
+    }
+  }
+
+  core::parallel_chunks(p, p, [&](unsigned, std::size_t b, std::size_t e) {
+    std::vector<const Rec *> first(k);
+    std::vector<std::size_t> len(k);
+    for (std::size_t q = b; q < e; q++) {
+      for (std::size_t s = 0; s < k; s++) {
+        first[s] = streams[s] + cuts[q * k + s];
+        len[s] = cuts[(q + 1) * k + s] - cuts[q * k + s];
+      }
+      core::merge_sorted_spans(first.data(), len.data(), k, out + offset[q],
+                               key);
+    }
+  });
+}
+
+} /* namespace dso */
+
+#endif
@@ -0,0 +1,441 @@
+/** @file
+ *
+ * Week and seconds-of-week representations of GNSS system times (GPS Time,
+ * Galileo System Time, BeiDou Time, QZSS Time and GLONASS Time) and their
+ * transformation to/from TAI.
+ *
+ * Each system is described by a tag type (see namespace dso::gnss), holding
+ * the system's week origin and its offset from TAI (or from UTC), as
+ * compile-time constants:
+ *
+ * | System   | Week 0 starts at    | Offset                |
+ * |----------|---------------------|-----------------------|
+ * | GPS      | 1980/01/06          | TAI - GPST = 19 [sec] |
+ * | Galileo  | 1999/08/22          | TAI - GST  = 19 [sec] |
+ * | BeiDou   | 2006/01/01          | TAI - BDT  = 33 [sec] |
+ * | QZSS     | 1980/01/06          | TAI - QZST = 19 [sec] |
+ * | GLONASS  | 1980/01/06 (*)      | GLONASST - UTC = 3 [h]|
+ *
+ * Galileo weeks are counted from 1999/08/22 (i.e. GPS week 1024), without
+ * the 4096-week rollover of the broadcast 12-bit field.
+ *
+ * (*) GLONASS Time is UTC(SU) + 3h and hence follows UTC leap seconds; it has
+ * no official week count. Here, weeks of GLONASS Time are counted from
+ * 1980/01/06 00:00:00 GLONASS Time, so that weeks and days of week match the
+ * ones of GPS Time. Since GLONASS Time is not a continuous scale, the inserted
+ * leap second (23:59:60 UTC, i.e. 02:59:60 GLONASS Time) cannot be
+ * represented; TAI epochs within a leap second are mapped to the start of
+ * the following UTC day (i.e. 03:00:00 GLONASS Time).
+ *
+ * Batch versions process arrays of epochs with branch-free kernels; for
+ * GLONASS, the leap second table snapshot is taken once per call.
+ */
+
+#ifndef __DSO_DATETIME_GNSS_TIME_HPP__
+#define __DSO_DATETIME_GNSS_TIME_HPP__
+
+#include "dtdatetime.hpp"
+#include "leap_seconds.hpp"
+#include "tpdate.hpp"
+#include <cmath>
+#include <cstddef>
+
+namespace dso {
+
+namespace gnss {
+
+/** @brief GPS Time */
+struct gpst {
+  static constexpr const int epoch_mjd = 44244;
+  static constexpr const bool utc_based = false;
+  static constexpr const int tai_minus_sys = 19;
+};
+
+/** @brief Galileo System Time */
+struct gst {
+  static constexpr const int epoch_mjd = 51412;
+  static constexpr const bool utc_based = false;
+  static constexpr const int tai_minus_sys = 19;
+};
+
+/** @brief BeiDou Time */
+struct bdt {
+  static constexpr const int epoch_mjd = 53736;
+  static constexpr const bool utc_based = false;
+  static constexpr const int tai_minus_sys = 33;
+};
+
+/** @brief QZSS Time */
+struct qzsst {
+  static constexpr const int epoch_mjd = 44244;
+  static constexpr const bool utc_based = false;
+  static constexpr const int tai_minus_sys = 19;
+};
+
+/** @brief GLONASS Time, i.e. UTC(SU) + 3h */
+struct glonasst {
+  static constexpr const int epoch_mjd = 44244;
+  static constexpr const bool utc_based = true;
+  static constexpr const int sys_minus_utc = 10800;
+};
+
+} /* namespace gnss */
+
+/** @brief Week and seconds of week of a GNSS system time.
+ *
+ * Seconds of week are normally in the range [0, 604800) (in units of S);
+ * transformations to TAI accept any (also negative) value though.
+ *
+ * @tparam Sys One of the tag types in dso::gnss.
+ * @tparam S   Seconds type, i.e. any of the *seconds types, or
+ *             FractionalSeconds.
+ */
+template <class Sys, class S> struct gnss_wsow {
+  using system = Sys;
+  long week;
+  S sow;
+}; /* struct gnss_wsow */
+
+namespace gnss::detail {
+
+/** @brief Split integral seconds to days and seconds of day, using floor
+ * division, i.e. the seconds of day are always in [0, F).
+ */
+template <typename I>
+constexpr long split_days(I &sec, I F) noexcept {
+  long days = static_cast<long>(sec / F);
+  sec -= days * F;
+  const int neg = (sec < 0);
+  days -= neg;
+  sec += neg * F;
+  return days;
+}
+
+/** @brief Split MJD to (system) week and seconds of week. */
+template <class Sys, typename I>
+constexpr long to_week(int mjd, I sec, I F, I &sow) noexcept {
+  const long days = static_cast<long>(mjd) - Sys::epoch_mjd;
+  const long week = days / 7 - (days % 7 < 0);
+  sow = static_cast<I>(days - week * 7) * F + sec;
+  return week;
+}
+
+/** @brief Split MJD to (system) week and (fractional) seconds of week. */
+template <class Sys>
+inline long to_week(int mjd, double sec, double &sow) noexcept {
+  const long days = static_cast<long>(mjd) - Sys::epoch_mjd;
+  const long week = days / 7 - (days % 7 < 0);
+  sow = static_cast<double>(days - week * 7) * 86400e0 + sec;
+  return week;
+}
+
+/** @brief Integral offset TAI - Sys, in units of S. */
+template <class Sys, class S>
+constexpr typename S::underlying_type tai_offset() noexcept {
+  return Sys::tai_minus_sys *
+         S::template sec_factor<typename S::underlying_type>();
+}
+
+/** @brief Integral offset Sys - UTC, in units of S. */
+template <class Sys, class S>
+constexpr typename S::underlying_type utc_offset() noexcept {
+  return Sys::sys_minus_utc *
+         S::template sec_factor<typename S::underlying_type>();
+}
+
+/** @brief GLONASS Time (MJD and seconds of day, in units of S) to TAI. */
+template <class S, class DatFn>
+constexpr datetime<S> glo2tai(long mjd, typename S::underlying_type sec,
+                              DatFn &&fdat) noexcept {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  /* UTC, as MJD and seconds of day */
+  sec -= utc_offset<gnss::glonasst, S>();
+  mjd += split_days<I>(sec, F);
+  sec += fdat(static_cast<int>(mjd)) * S::template sec_factor<I>();
+  mjd += split_days<I>(sec, F);
+  return datetime<S>::non_normalize_construct(
+      modified_julian_day(static_cast<int>(mjd)), S(sec));
+}
+
+/** @brief TAI to GLONASS Time (MJD and seconds of day, in units of S). */
+template <class S, class DatFn>
+constexpr int tai2glo(const datetime<S> &tai, typename S::underlying_type &sec,
+                      DatFn &&fdat) noexcept {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  int mjd = tai.imjd().as_underlying_type();
+  const I fac = S::template sec_factor<I>();
+  /* UTC seconds of day; if negative, the epoch is on the previous (UTC) day,
+   * which is when ΔAT changes (or during the inserted leap second).
+   */
+  sec = tai.sec().as_underlying_type() - fdat(mjd) * fac;
+  if (sec < 0) {
+    --mjd;
+    sec = tai.sec().as_underlying_type() + F - fdat(mjd) * fac;
+    /* a leap second; map to the next day */
+    if (sec >= F) {
+      ++mjd;
+      sec = 0;
+    }
+  }
+  sec += utc_offset<gnss::glonasst, S>();
+  mjd += static_cast<int>(split_days<I>(sec, F));
+  return mjd;
+}
+
+/** @brief GLONASS Time (MJD and fractional seconds of day) to TAI. */
+template <class DatFn>
+inline TwoPartDate glo2tai(int mjd, double sec, DatFn &&fdat) noexcept {
+  const TwoPartDate utc(mjd, FractionalSeconds(
+                                 sec - static_cast<double>(
+                                           gnss::glonasst::sys_minus_utc)));
+  return TwoPartDate(utc.imjd(),
+                     FractionalSeconds(utc.seconds().seconds() +
+                                       static_cast<double>(fdat(utc.imjd()))));
+}
+
+/** @brief TAI to GLONASS Time (normalized). */
+template <class DatFn>
+inline TwoPartDate tai2glo(const TwoPartDate &tai, DatFn &&fdat) noexcept {
+  int mjd = tai.imjd();
+  double sec = tai.seconds().seconds() - static_cast<double>(fdat(mjd));
+  if (sec < 0e0) {
+    --mjd;
+    sec = tai.seconds().seconds() + 86400e0 - static_cast<double>(fdat(mjd));
+    /* a leap second; map to the next day */
+    if (sec >= 86400e0) {
+      ++mjd;
+      sec = 0e0;
+    }
+  }
+  return TwoPartDate(
+      mjd, FractionalSeconds(
+               sec + static_cast<double>(gnss::glonasst::sys_minus_utc)));
+}
+
+/** @brief System week and seconds of week to (normalized) system time. */
+template <class Sys>
+inline TwoPartDate sys_date(long week, double sow) noexcept {
+  const double days = std::floor(sow / 86400e0);
+  const int mjd = static_cast<int>(Sys::epoch_mjd + week * 7 + (long)days);
+  return TwoPartDate(mjd, FractionalSeconds(sow - days * 86400e0));
+}
+
+} /* namespace gnss::detail */
+
+/** @brief Transform a GNSS system week and seconds of week to TAI.
+ *
+ * For GLONASS Time, ΔAT is computed via dso::dat, i.e. using the leap second
+ * table currently in use.
+ */
+#if __cplusplus >= 202002L
+template <class Sys, gconcepts::is_sec_dt S>
+#else
+template <class Sys, class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+constexpr datetime<S> gnss2tai(const gnss_wsow<Sys, S> &t) noexcept {
+  using I = typename S::underlying_type;
+  I sec = t.sow.as_underlying_type();
+  long mjd = Sys::epoch_mjd + t.week * 7 +
+             gnss::detail::split_days<I>(sec, S::max_in_day);
+  if constexpr (Sys::utc_based) {
+    return gnss::detail::glo2tai<S>(mjd, sec, [](int m) {
+      return dso::dat(modified_julian_day(m));
+    });
+  } else {
+    sec += gnss::detail::tai_offset<Sys, S>();
+    mjd += gnss::detail::split_days<I>(sec, S::max_in_day);
+    return datetime<S>::non_normalize_construct(
+        modified_julian_day(static_cast<int>(mjd)), S(sec));
+  }
+}
+
+/** @brief Transform a TAI epoch to GNSS system week and seconds of week.
+ *
+ * Seconds of week are always in [0, 604800) (in units of S). For GLONASS
+ * Time, ΔAT is computed via dso::dat, i.e. using the leap second table
+ * currently in use.
+ */
+#if __cplusplus >= 202002L
+template <class Sys, gconcepts::is_sec_dt S>
+#else
+template <class Sys, class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+constexpr gnss_wsow<Sys, S> tai2gnss(const datetime<S> &tai) noexcept {
+  using I = typename S::underlying_type;
+  I sec = 0;
+  int mjd = 0;
+  if constexpr (Sys::utc_based) {
+    mjd = gnss::detail::tai2glo<S>(
+        tai, sec, [](int m) { return dso::dat(modified_julian_day(m)); });
+  } else {
+    sec = tai.sec().as_underlying_type() - gnss::detail::tai_offset<Sys, S>();
+    mjd = tai.imjd().as_underlying_type() +
+          static_cast<int>(gnss::detail::split_days<I>(sec, S::max_in_day));
+  }
+  I sow = 0;
+  const long week =
+      gnss::detail::to_week<Sys, I>(mjd, sec, S::max_in_day, sow);
+  return gnss_wsow<Sys, S>{week, S(sow)};
+}
+
+/** @brief Transform a GNSS system week and (fractional) seconds of week to
+ * TAI.
+ */
+template <class Sys>
+inline TwoPartDate
+gnss2tai(const gnss_wsow<Sys, FractionalSeconds> &t) noexcept {
+  const TwoPartDate sys = gnss::detail::sys_date<Sys>(t.week, t.sow.seconds());
+  if constexpr (Sys::utc_based) {
+    return gnss::detail::glo2tai(sys.imjd(), sys.seconds().seconds(),
+                                 [](int m) {
+                                   return dso::dat(modified_julian_day(m));
+                                 });
+  } else {
+    return TwoPartDate(sys.imjd(),
+                       FractionalSeconds(sys.seconds().seconds() +
+                                         (double)Sys::tai_minus_sys));
+  }
+}
+
+/** @brief Transform a TAI epoch to GNSS system week and (fractional) seconds
+ * of week.
+ */
+template <class Sys>
+inline gnss_wsow<Sys, FractionalSeconds>
+tai2gnss(const TwoPartDate &tai) noexcept {
+  TwoPartDate sys;
+  if constexpr (Sys::utc_based) {
+    sys = gnss::detail::tai2glo(
+        tai, [](int m) { return dso::dat(modified_julian_day(m)); });
+  } else {
+    sys = TwoPartDate(tai.imjd(),
+                      FractionalSeconds(tai.seconds().seconds() -
+                                        (double)Sys::tai_minus_sys));
+  }
+  double sow;
+  const long week =
+      gnss::detail::to_week<Sys>(sys.imjd(), sys.seconds().seconds(), sow);
+  return gnss_wsow<Sys, FractionalSeconds>{week, FractionalSeconds(sow)};
+}
+
+/** @brief Batch version of gnss2tai; transform n pairs of (\p week, \p sow)
+ * to TAI epochs, written in \p tai.
+ */
+#if __cplusplus >= 202002L
+template <class Sys, gconcepts::is_sec_dt S>
+#else
+template <class Sys, class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+void gnss2tai_batch(const long *week, const S *sow, datetime<S> *tai,
+                    std::size_t n) noexcept {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  if constexpr (Sys::utc_based) {
+    const LeapSecondTable *table = leap_seconds::current();
+    const auto fdat = [table](int m) { return table->dat(m); };
+    for (std::size_t i = 0; i < n; i++) {
+      I sec = sow[i].as_underlying_type();
+      const long mjd = Sys::epoch_mjd + week[i] * 7 +
+                       gnss::detail::split_days<I>(sec, F);
+      tai[i] = gnss::detail::glo2tai<S>(mjd, sec, fdat);
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      I sec = sow[i].as_underlying_type() + gnss::detail::tai_offset<Sys, S>();
+      const long mjd = Sys::epoch_mjd + week[i] * 7 +
+                       gnss::detail::split_days<I>(sec, F);
+      tai[i] = datetime<S>::non_normalize_construct(
+          modified_julian_day(static_cast<int>(mjd)), S(sec));
+    }
+  }
+}
+
+/** @brief Batch version of tai2gnss; transform n TAI epochs to GNSS system
+ * week and seconds of week, written in \p week and \p sow.
+ */
+#if __cplusplus >= 202002L
+template <class Sys, gconcepts::is_sec_dt S>
+#else
+template <class Sys, class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+void tai2gnss_batch(const datetime<S> *tai, long *week, S *sow,
+                    std::size_t n) noexcept {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  if constexpr (Sys::utc_based) {
+    const LeapSecondTable *table = leap_seconds::current();
+    const auto fdat = [table](int m) { return table->dat(m); };
+    for (std::size_t i = 0; i < n; i++) {
+      I sec = 0, s = 0;
+      const int mjd = gnss::detail::tai2glo<S>(tai[i], sec, fdat);
+      week[i] = gnss::detail::to_week<Sys, I>(mjd, sec, F, s);
+      sow[i] = S(s);
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      I sec = tai[i].sec().as_underlying_type() -
+              gnss::detail::tai_offset<Sys, S>();
+      const int mjd =
+          tai[i].imjd().as_underlying_type() +
+          static_cast<int>(gnss::detail::split_days<I>(sec, F));
+      I s = 0;
+      week[i] = gnss::detail::to_week<Sys, I>(mjd, sec, F, s);
+      sow[i] = S(s);
+    }
+  }
+}
+
+/** @brief Batch version of gnss2tai for fractional seconds of week; the
+ * results are bit-identical to the scalar version.
+ */
+template <class Sys>
+void gnss2tai_batch(const long *week, const double *sow, TwoPartDate *tai,
+                    std::size_t n) noexcept {
+  if constexpr (Sys::utc_based) {
+    const LeapSecondTable *table = leap_seconds::current();
+    const auto fdat = [table](int m) { return table->dat(m); };
+    for (std::size_t i = 0; i < n; i++) {
+      const TwoPartDate sys = gnss::detail::sys_date<Sys>(week[i], sow[i]);
+      tai[i] =
+          gnss::detail::glo2tai(sys.imjd(), sys.seconds().seconds(), fdat);
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      const TwoPartDate sys = gnss::detail::sys_date<Sys>(week[i], sow[i]);
+      tai[i] = TwoPartDate(sys.imjd(),
+                           FractionalSeconds(sys.seconds().seconds() +
+                                             (double)Sys::tai_minus_sys));
+    }
+  }
+}
+
+/** @brief Batch version of tai2gnss for fractional seconds of week; the
+ * results are bit-identical to the scalar version.
+ */
+template <class Sys>
+void tai2gnss_batch(const TwoPartDate *tai, long *week, double *sow,
+                    std::size_t n) noexcept {
+  if constexpr (Sys::utc_based) {
+    const LeapSecondTable *table = leap_seconds::current();
+    const auto fdat = [table](int m) { return table->dat(m); };
+    for (std::size_t i = 0; i < n; i++) {
+      const TwoPartDate sys = gnss::detail::tai2glo(tai[i], fdat);
+      week[i] = gnss::detail::to_week<Sys>(sys.imjd(), sys.seconds().seconds(),
+                                           sow[i]);
+    }
+  } else {
+    for (std::size_t i = 0; i < n; i++) {
+      const TwoPartDate sys(tai[i].imjd(),
+                            FractionalSeconds(tai[i].seconds().seconds() -
+                                              (double)Sys::tai_minus_sys));
+      week[i] = gnss::detail::to_week<Sys>(sys.imjd(), sys.seconds().seconds(),
+                                           sow[i]);
+    }
+  }
+}
+
+} /* namespace dso */
+
+#endif
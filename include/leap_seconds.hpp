@@ -0,0 +1,303 @@
+/** @file
+ *
+ * A (run-time) provider of leap seconds, i.e. of the history of
+ * ΔAT = TAI - UTC.
+ *
+ * By default, the library uses the table compiled-in (see
+ * core/builtin_leap_seconds.hpp). Long-running applications can however load
+ * a more recent table from a local IERS file (either Leap_Second.dat or the
+ * USNO tai-utc.dat) at start-up and re-load it whenever the file is updated,
+ * without the need to re-build.
+ *
+ * Tables are immutable once constructed; the library always reads ΔAT values
+ * off a snapshot (a pointer to a table) obtained via leap_seconds::current().
+ * Installing a new table atomically replaces the snapshot; readers never
+ * lock, and tables that have been replaced are never freed, so that any
+ * snapshot taken remains valid for the lifetime of the program (RCU-style,
+ * with an infinite grace period; tables are small and re-loads are rare).
+ */
+
+#ifndef __DSO_DATETIME_LEAP_SECONDS_HPP__
+#define __DSO_DATETIME_LEAP_SECONDS_HPP__
+
+#include "core/builtin_leap_seconds.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace dso {
+
+/** @brief An immutable table of ΔAT = TAI - UTC values.
+ *
+ * The table holds the MJDs at which ΔAT changes (these are always the first
+ * day of a month), along with the new values. All ΔAT related quantities,
+ * i.e. ΔAT per MJD, ΔAT per calendar month and leap insertion days, are
+ * derived from this one list.
+ *
+ * For MJDs in the range [first change, expiry], ΔAT and the number of extra
+ * seconds in day are precomputed in a dense, MJD-indexed table, so that a
+ * lookup is one (indexed) load. Outside this range, the list of changes is
+ * searched.
+ *
+ * @warning Only post-1972 ΔAT values are considered (i.e. after UTC started
+ *          using integral offsets from TAI).
+ */
+class LeapSecondTable {
+public:
+  /** A change in ΔAT */
+  using change = core::leap_second_change;
+
+  /** An entry of the dense (MJD-indexed) table */
+  struct dat_entry {
+    /** ΔAT for the day */
+    std::int8_t delat;
+    /** Extra seconds in day, i.e. non-zero for leap insertion days */
+    std::int8_t extra;
+  };
+
+  /** @brief Constructor from a list of changes and an expiry date.
+   *
+   * The changes should be given in chronological order, each change must
+   * occur on the first day of a month and actually change ΔAT. If not, the
+   * constructor will throw.
+   *
+   * @param[in] changes    The ΔAT changes, in chronological order
+   * @param[in] expiry_mjd MJD up to which the table is known to be valid
+   * @throw std::invalid_argument if the table is empty, not ordered, not
+   *        aligned to months or holds out-of-range ΔAT values.
+   */
+  LeapSecondTable(std::vector<change> changes, int expiry_mjd);
+
+  /** @brief The table compiled into the library. */
+  static const LeapSecondTable &builtin() noexcept;
+
+  /** @brief Parse a local IERS leap second file.
+   *
+   * Both the IERS Leap_Second.dat and the USNO tai-utc.dat formats are
+   * recognized. For the latter, only (post-1972) entries with integral
+   * offsets are considered; since the file holds no expiry date, the table
+   * expires at its last ΔAT change.
+   *
+   * @param[in] fn The filename of the leap second file
+   * @return The parsed table
+   * @throw std::runtime_error if the file cannot be opened or parsed.
+   */
+  static LeapSecondTable from_file(const char *fn);
+
+  /** @brief ΔAT for a given (integral) UTC MJD.
+   *
+   * If \p mjd is a day ending with a leap second, the value returned is for
+   * the period leading up to the leap second.
+   */
+  int dat(int mjd) const noexcept {
+    const auto idx = static_cast<unsigned>(mjd - m_dense_mjd);
+    return (idx < m_dense.size()) ? m_dense[idx].delat : search_dat(mjd);
+  }
+
+  /** @brief ΔAT for a given (integral) UTC MJD, and the number of extra
+   * seconds in the day (i.e. 1 if the day ends with a leap second, 0
+   * otherwise).
+   */
+  int dat(int mjd, int &extra_sec_in_day) const noexcept {
+    const auto idx = static_cast<unsigned>(mjd - m_dense_mjd);
+    if (idx < m_dense.size()) {
+      const dat_entry e = m_dense[idx];
+      extra_sec_in_day = e.extra;
+      return e.delat;
+    }
+    return search_dat(mjd, extra_sec_in_day);
+  }
+
+  /** @brief ΔAT for a given calendar month (i.e. year and month).
+   *
+   * @param[in] iy The year
+   * @param[in] im The month, in range [1,12]
+   */
+  int dat_calendar(int iy, int im) const noexcept {
+    const auto idx = static_cast<unsigned>(12 * iy + im - m_dense_month);
+    return (idx < m_dense_calendar.size()) ? m_dense_calendar[idx]
+                                           : search_dat_calendar(iy, im);
+  }
+
+  /** @brief Check if an MJD is a leap insertion day (i.e. day prior to a
+   * ΔAT change). Returns 1 if it is, 0 otherwise.
+   */
+  int is_leap_insertion_day(int mjd) const noexcept {
+    const auto idx = static_cast<unsigned>(mjd - m_dense_mjd);
+    return (idx < m_dense.size()) ? (m_dense[idx].extra != 0)
+                                  : search_is_leap_insertion_day(mjd);
+  }
+
+  /** @brief MJD up to which the table is known to be valid. */
+  int expiry_mjd() const noexcept { return m_expiry_mjd; }
+
+  /** @brief The ΔAT changes, in chronological order. */
+  const std::vector<change> &changes() const noexcept { return m_changes; }
+
+  /** @brief Leap insertion days, i.e. the day prior to each change (but the
+   * first), in chronological order.
+   *
+   * Along with step_dat, this is the table in a form suitable for
+   * compare-and-count: for any MJD, ΔAT is changes().front().delat +
+   * Σ(step_dat()[i] if mjd > step_mjd()[i]), and the extra seconds in day
+   * are Σ(step_dat()[i] if mjd == step_mjd()[i]).
+   */
+  const std::vector<int> &step_mjd() const noexcept { return m_step_mjd; }
+
+  /** @brief Change of ΔAT at each leap insertion day (see step_mjd). */
+  const std::vector<int> &step_dat() const noexcept { return m_step_dat; }
+
+  /** @brief Equality operator; expiry dates are not considered. */
+  bool operator==(const LeapSecondTable &other) const noexcept;
+
+private:
+  /** Search the list of changes (for MJDs out of the dense table) */
+  int search_dat(int mjd) const noexcept;
+  int search_dat(int mjd, int &extra_sec_in_day) const noexcept;
+  int search_dat_calendar(int iy, int im) const noexcept;
+  int search_is_leap_insertion_day(int mjd) const noexcept;
+
+  /** ΔAT changes in chronological order */
+  std::vector<change> m_changes;
+  /** date-ordered integer, i.e. 12 * year + month, of each change */
+  std::vector<int> m_months;
+  /** leap insertion days, i.e. the day prior to each change but the first */
+  std::vector<int> m_step_mjd;
+  /** change of ΔAT at each of m_step_mjd */
+  std::vector<int> m_step_dat;
+  /** dense table, indexed by MJD - m_dense_mjd */
+  std::vector<dat_entry> m_dense;
+  /** dense table of ΔAT, indexed by (12 * year + month) - m_dense_month */
+  std::vector<std::int8_t> m_dense_calendar;
+  /** first MJD in the dense table (i.e. first change) */
+  int m_dense_mjd;
+  /** first date-ordered month in the dense calendar table */
+  int m_dense_month;
+  /** MJD up to which the table is valid */
+  int m_expiry_mjd;
+}; /* class LeapSecondTable */
+
+namespace leap_seconds {
+
+namespace detail {
+/** @brief The table currently in use; nullptr until first use. */
+extern std::atomic<const LeapSecondTable *> installed;
+
+/** @brief Install the built-in table (if no other table is installed yet)
+ * and return the table in use.
+ */
+const LeapSecondTable *install_builtin() noexcept;
+} /* namespace detail */
+
+/** @brief Get a snapshot of the leap second table currently in use.
+ *
+ * This is lock-free (i.e. one atomic load); the returned table will never
+ * change or be freed, even if another table is installed meanwhile.
+ */
+inline const LeapSecondTable *current() noexcept {
+  const LeapSecondTable *t = detail::installed.load(std::memory_order_acquire);
+  return t ? t : detail::install_builtin();
+}
+
+/** @brief Install a leap second table, replacing the one in use.
+ *
+ * @return A pointer to the (now current) table.
+ */
+const LeapSecondTable *install(LeapSecondTable table);
+
+/** @brief Parse a leap second file and install the resulting table.
+ *
+ * The filename is kept, so that the table can later be re-loaded via
+ * leap_seconds::reload. If the file cannot be parsed, the current table is
+ * left untouched and an exception is thrown.
+ *
+ * @param[in] fn The filename of the leap second file (see
+ *            LeapSecondTable::from_file)
+ * @return A pointer to the (now current) table.
+ */
+const LeapSecondTable *load(const char *fn);
+
+/** @brief Re-load the leap second file last loaded via leap_seconds::load.
+ *
+ * A new table is only installed if the file contents have changed.
+ *
+ * @return true if a new table was installed, false otherwise (including the
+ *         case where no file has been loaded).
+ * @throw std::runtime_error if the file cannot be parsed; the current table
+ *        is left untouched.
+ */
+bool reload();
+
+} /* namespace leap_seconds */
+
+/** @brief A cursor over the ΔAT segments of a leap second table.
+ *
+ * A segment is a range of MJDs where ΔAT is constant, i.e. from one change
+ * up to the day before the next one (the leap insertion day). The cursor
+ * remembers the segment of the last lookup; if the next MJD falls in the
+ * same segment (which is the usual case for time-ordered data), the lookup
+ * is a single range check. Otherwise, the cursor moves to the neighbouring
+ * segments, hence for monotonic streams of epochs advancing is amortized
+ * O(1).
+ *
+ * A cursor is bound to a table snapshot (by default the one currently in use)
+ * and is not thread-safe; use one cursor per stream/thread.
+ *
+ * Example:
+ * LeapCursor cursor;
+ * for (const auto &utc : epochs)
+ *   tai.push_back(utc.utc2tai(cursor));
+ */
+class LeapCursor {
+public:
+  /** @brief Constructor; the cursor is placed at the last ΔAT segment. */
+  explicit LeapCursor(
+      const LeapSecondTable *table = leap_seconds::current()) noexcept
+      : m_table(table), m_idx(static_cast<int>(table->changes().size()) - 1) {
+    set_segment();
+  }
+
+  /** @brief ΔAT for a given (integral) UTC MJD. */
+  int dat(int mjd) noexcept {
+    if (mjd < m_first || mjd > m_last)
+      seek(mjd);
+    return m_delat;
+  }
+
+  /** @brief ΔAT for a given (integral) UTC MJD, and the number of extra
+   * seconds in the day (i.e. 1 if the day ends with a leap second, 0
+   * otherwise).
+   */
+  int dat(int mjd, int &extra_sec_in_day) noexcept {
+    if (mjd < m_first || mjd > m_last)
+      seek(mjd);
+    extra_sec_in_day = (mjd == m_last) * m_extra;
+    return m_delat;
+  }
+
+  /** @brief The leap second table the cursor is bound to. */
+  const LeapSecondTable *table() const noexcept { return m_table; }
+
+private:
+  /** @brief Move to the segment \p mjd lies in. */
+  void seek(int mjd) noexcept;
+  /** @brief Set the current segment's limits and values from m_idx. */
+  void set_segment() noexcept;
+
+  /** The table we are iterating */
+  const LeapSecondTable *m_table;
+  /** Index of the change starting the segment; -1 before the first change */
+  int m_idx;
+  /** First MJD of the segment */
+  int m_first;
+  /** Last MJD of the segment (i.e. a leap insertion day) */
+  int m_last;
+  /** ΔAT within the segment */
+  int m_delat;
+  /** Extra seconds in the last day of the segment */
+  int m_extra;
+}; /* class LeapCursor */
+
+} /* namespace dso */
+
+#endif
@@ -0,0 +1,151 @@
+/** @file
+ *
+ * Define a linear_time<S> class, i.e. a time point stored as a single
+ * (signed) count of ticks of S since a fixed epoch, namely 2000/01/01
+ * 00:00:00 in the time scale of the instance.
+ *
+ * Contrary to datetime<S>, which holds an MJD and the seconds of day as
+ * separate fields, arithmetic and comparisons on a linear_time<S> are plain
+ * integer operations (no carries between days and seconds, no
+ * normalization), so that sorting, searching and differencing large arrays
+ * of epochs compiles to straight integer code.
+ *
+ * Ticks are stored as 64-bit integers for S up to dso::nanoseconds (the
+ * range for nanoseconds is approximately +/-292 years around the epoch) and
+ * as 128-bit integers for finer resolutions (i.e. dso::picoseconds); the
+ * latter are only available where the compiler provides __int128 (see
+ * DATETIME_HAS_INT128).
+ * Transformations to/from datetime<S> are lossless within this range.
+ *
+ * Like datetime<S>, linear_time<S> is meant for continuous time scales.
+ */
+
+#ifndef __DSO_DATETIME_LINEAR_TIME_HPP__
+#define __DSO_DATETIME_LINEAR_TIME_HPP__
+
+#include "core/int128.hpp"
+#include "dtdatetime.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace dso {
+
+/** @brief A time point, as a single count of ticks (of type S) since
+ * 2000/01/01 00:00:00.
+ *
+ * @tparam S Any class of 'second type', i.e. any class S that has a (static)
+ *           member variable S::is_of_sec_type set to true.
+ */
+#if __cplusplus >= 202002L
+template <gconcepts::is_sec_dt S>
+#else
+template <class S, typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+class linear_time {
+public:
+#ifdef DATETIME_HAS_INT128
+  /** Type of the tick count; 64-bit up to nanoseconds, else 128-bit */
+  using tick_type =
+      std::conditional_t<(S::template sec_factor<long>() <= 1'000'000'000L),
+                         std::int64_t, core::int128_t>;
+#else
+  static_assert(S::template sec_factor<long>() <= 1'000'000'000L,
+                "linear_time<S> for resolutions finer than nanoseconds needs "
+                "a 128-bit integer type (__int128)");
+  /** Type of the tick count */
+  using tick_type = std::int64_t;
+#endif
+
+  /** MJD of the epoch, i.e. 2000/01/01 */
+  static constexpr const int epoch_mjd = 51544;
+
+  /** @brief Default constructor; the epoch, i.e. 2000/01/01 00:00:00 */
+  constexpr linear_time() noexcept : m_ticks(0) {}
+
+  /** @brief Constructor from a count of ticks since the epoch */
+  constexpr explicit linear_time(tick_type ticks) noexcept : m_ticks(ticks) {}
+
+  /** @brief Constructor from a datetime<S> (lossless). */
+  constexpr explicit linear_time(const datetime<S> &d) noexcept
+      : m_ticks(static_cast<tick_type>(d.imjd().as_underlying_type() -
+                                       epoch_mjd) *
+                    S::max_in_day +
+                d.sec().as_underlying_type()) {}
+
+  /** @brief Transform to datetime<S> (lossless). */
+  constexpr datetime<S> to_datetime() const noexcept {
+    /* floor division, so that seconds of day are in [0, max_in_day) */
+    tick_type days = m_ticks / S::max_in_day;
+    tick_type sec = m_ticks - days * S::max_in_day;
+    const int neg = (sec < 0);
+    days -= neg;
+    sec += neg * static_cast<tick_type>(S::max_in_day);
+    return datetime<S>::non_normalize_construct(
+        modified_julian_day(static_cast<int>(days) + epoch_mjd),
+        S(static_cast<typename S::underlying_type>(sec)));
+  }
+
+  /** @brief Get the tick count, i.e. number of S since the epoch. */
+  constexpr tick_type ticks() const noexcept { return m_ticks; }
+
+  /** @brief Add seconds (of type S). */
+  constexpr linear_time &operator+=(S s) noexcept {
+    m_ticks += s.as_underlying_type();
+    return *this;
+  }
+
+  /** @brief Subtract seconds (of type S). */
+  constexpr linear_time &operator-=(S s) noexcept {
+    m_ticks -= s.as_underlying_type();
+    return *this;
+  }
+
+  /** @brief Add seconds (of type S) to an instance. */
+  constexpr linear_time operator+(S s) const noexcept {
+    return linear_time(m_ticks + s.as_underlying_type());
+  }
+
+  /** @brief Subtract seconds (of type S) from an instance. */
+  constexpr linear_time operator-(S s) const noexcept {
+    return linear_time(m_ticks - s.as_underlying_type());
+  }
+
+  /** @brief Difference between two instances, i.e. *this - t, in ticks. */
+  constexpr tick_type operator-(const linear_time &t) const noexcept {
+    return m_ticks - t.m_ticks;
+  }
+
+  /** @brief Difference between two instances, i.e. *this - t, in fractional
+   * seconds.
+   */
+  constexpr double diff_sec(const linear_time &t) const noexcept {
+    return static_cast<double>(m_ticks - t.m_ticks) * S::sec_inv_factor();
+  }
+
+  /** @brief Comparison operators; single integer comparisons. */
+  constexpr bool operator==(const linear_time &t) const noexcept {
+    return m_ticks == t.m_ticks;
+  }
+  constexpr bool operator!=(const linear_time &t) const noexcept {
+    return m_ticks != t.m_ticks;
+  }
+  constexpr bool operator<(const linear_time &t) const noexcept {
+    return m_ticks < t.m_ticks;
+  }
+  constexpr bool operator<=(const linear_time &t) const noexcept {
+    return m_ticks <= t.m_ticks;
+  }
+  constexpr bool operator>(const linear_time &t) const noexcept {
+    return m_ticks > t.m_ticks;
+  }
+  constexpr bool operator>=(const linear_time &t) const noexcept {
+    return m_ticks >= t.m_ticks;
+  }
+
+private:
+  tick_type m_ticks;
+}; /* class linear_time */
+
+} /* namespace dso */
+
+#endif
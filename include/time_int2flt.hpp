@@ -21,7 +21,7 @@ template <gconcepts::is_sec_dt S>
 #else
 template <typename S, typename = std::enable_if_t<S::is_of_sec_type>>
 #endif
-FractionalDays to_fractional_days(S nsec) noexcept {
+constexpr FractionalDays to_fractional_days(S nsec) noexcept {
   const double sec = static_cast<double>(nsec.__member_ref__());
   return FractionalDays(sec / S::max_in_day);
 }
@@ -32,7 +32,7 @@ template <gconcepts::is_sec_dt S>
 #else
 template <typename S, typename = std::enable_if_t<S::is_of_sec_type>>
 #endif
-FractionalSeconds to_fractional_seconds(S nsec) noexcept {
+constexpr FractionalSeconds to_fractional_seconds(S nsec) noexcept {
   const double sec = nsec.S::template cast_to<double>() * S::sec_inv_factor();
   return FractionalSeconds(sec);
 }
@@ -16,12 +16,80 @@
 #define __DSO_DATETIME_TWOPARTDATES_HPP__
 
 #include "datetime_utc.hpp"
+#include "double_double.hpp"
+#include <cstddef>
 #include <random>
+#include <type_traits>
 
 namespace dso {
 
 /** forward decleration */
-class TwoPartDate;
+template <typename R> class TwoPartDateT;
+
+/** TwoPartDate, with seconds of day stored as double. */
+using TwoPartDate = TwoPartDateT<double>;
+
+namespace core {
+/** @brief Seconds of day in a given representation (double, long double or
+ * DoubleDouble), from integral seconds of type S.
+ *
+ * For DoubleDouble, whole seconds are exact and the fractional part is
+ * correctly rounded (to ~106 bits); for double, this is the same as
+ * to_fractional_seconds.
+ */
+#if __cplusplus >= 202002L
+template <typename R, gconcepts::is_sec_dt S>
+#else
+template <typename R, typename S,
+          typename = std::enable_if_t<S::is_of_sec_type>>
+#endif
+constexpr R seconds_to_rep(S sec) noexcept {
+  if constexpr (std::is_same_v<R, DoubleDouble>) {
+    const auto ticks = sec.as_underlying_type();
+    const auto f = S::template sec_factor<typename S::underlying_type>();
+    return DoubleDouble(static_cast<double>(ticks / f)) +
+           DoubleDouble(static_cast<double>(ticks % f)) /
+               static_cast<double>(f);
+  } else if constexpr (std::is_same_v<R, long double>) {
+    return static_cast<long double>(sec.as_underlying_type()) /
+           S::template sec_factor<long double>();
+  } else {
+    return to_fractional_seconds<S>(sec).seconds();
+  }
+}
+
+/** @brief Normalize a (MJD, seconds of day) pair, without std::fmod.
+ *
+ * Whole days are removed from \p sec via a floor-multiply by 1/86400; the
+ * (rounded) quotient is corrected by (at most) one day using exact
+ * comparisons, so the result is the exact floor division (std::fmod and a
+ * double to int cast would truncate instead). At output, \p sec is in
+ * [0, 86400) and \p mjd is updated accordingly. As for TwoPartDate
+ * intervals, negative seconds (in (-86400, 0)) are kept only if the whole
+ * days sum to zero, i.e. the resulting MJD would be 0.
+ *
+ * The function is branch-free, so that loops calling it can be vectorized;
+ * it is used by both TwoPartDate::normalize and tpdate_column, so that
+ * scalar and batch results are bit-identical.
+ */
+template <typename F>
+inline void normalize_sec_of_day(int &mjd, F &sec) noexcept {
+  constexpr const F D = 86400;
+  constexpr const F INV = F(1) / D;
+  F k = std::floor(sec * INV);
+  /* exact, since k * D and (k + 1) * D are exact */
+  k += static_cast<F>(sec >= (k + 1) * D) - static_cast<F>(sec < k * D);
+  const bool inexact = (sec < F(0)) & (sec != k * D);
+  /* truncated quotient, for intervals */
+  const F kt = k + static_cast<F>(inexact);
+  const bool neg = inexact & (mjd + static_cast<int>(kt) == 0);
+  /* exact if neg; else rounded, possibly up to D for (tiny) negative sec */
+  const F r = sec - (neg ? kt : k) * D;
+  const bool wrap = !neg & (r >= D);
+  sec = wrap ? F(0) : r;
+  mjd = neg ? 0 : mjd + static_cast<int>(k) + static_cast<int>(wrap);
+}
+} /* namespace core */
 
 /** A datetime class to represent epochs in UTC time system.
  *
@@ -64,6 +132,15 @@ private:
     return _mjd;
   }
 
+  /** @brief Transform a UTC date to a TAI date, using a LeapCursor for ΔAT.
+   *
+   * @see utc2tai(FDOUBLE &)
+   */
+  int utc2tai(FDOUBLE &taisec, LeapCursor &cursor) const noexcept {
+    taisec = _fsec + cursor.dat(_mjd);
+    return _mjd;
+  }
+
   /** @brief Transform a UTC date to a TT date.
    *
    * The TT date is returned in two parts:
@@ -99,6 +176,40 @@ private:
     this->normalize();
   }
 
+  /** @brief Normalize the instance, given a function to compute ΔAT.
+   *
+   * @param[in] dat_fn A callable with signature int(int mjd, int &extra),
+   *                   returning ΔAT and the extra seconds in day for
+   *                   \p mjd.
+   */
+  template <typename DatFn> void normalize_impl(DatFn &&dat_fn) noexcept {
+    int extra_sec_in_day;
+    dat_fn(_mjd, extra_sec_in_day);
+    /* for each MJD, remove integral days. Each MJD may have a different
+     * number of seconds, since we are in UTC time scale. Hence, iteratively
+     * remove whole days using the number of seconds for each day.
+     */
+    while (_fsec >= 86400e0 + extra_sec_in_day) {
+      _fsec -= (86400e0 + extra_sec_in_day);
+      ++_mjd;
+      dat_fn(_mjd, extra_sec_in_day);
+    }
+    while (_fsec < 0e0) {
+      --_mjd;
+      _fsec += 86400e0;
+      dat_fn(_mjd, extra_sec_in_day);
+      _fsec += 1e0 * extra_sec_in_day;
+    }
+#ifdef DEBUG
+    if (_mjd)
+      assert(_fsec >= 0e0 && _fsec < 86400e0 + extra_sec_in_day);
+    else
+      assert(_fsec < 0e0 && _fsec > -86400e0);
+#endif
+    /* all done */
+    return;
+  }
+
 public:
   /** Constructor from datetime<T> */
 #if __cplusplus >= 202002L
@@ -180,6 +291,15 @@ public:
     this->add_seconds(fsec.seconds());
   }
 
+  /** @brief Add seconds to instance, taking into account leap seconds.
+   *
+   * ΔAT values (if needed) are resolved via the \p cursor (see LeapCursor).
+   */
+  void add_seconds(FractionalSeconds fsec, LeapCursor &cursor) noexcept {
+    _fsec += fsec.seconds();
+    this->normalize(cursor);
+  }
+
   /** Add seconds to instance and return the "Kahan summation" error.
    *
    * This function implements a "Kahan summation" scheme to iteratively add
@@ -235,6 +355,13 @@ public:
    */
   TwoPartDate operator-(const TwoPartDateUTC &d) const noexcept;
 
+  /** @brief Difference between two UTC dates, using a LeapCursor.
+   *
+   * Same as operator-, but ΔAT values are resolved via the \p cursor (see
+   * LeapCursor).
+   */
+  TwoPartDate diff(const TwoPartDateUTC &d, LeapCursor &cursor) const noexcept;
+
   /** @brief Normalize an instance.
    *
    * Normalize here is meant in the sense that the fractional seconds of day
@@ -244,36 +371,33 @@ public:
   void normalize() noexcept {
     if (_fsec >= 0e0 && _fsec < 86400e0)
       return;
-    int extra_sec_in_day;
-    dat(modified_julian_day(_mjd), extra_sec_in_day);
-    /* for each MJD, remove integral days. Each MJD may have a different
-     * number of seconds, since we are in UTC time scale. Hence, iteratively
-     * remove whole days using the number of seconds for each day.
-     */
-    while (_fsec >= 86400e0 + extra_sec_in_day) {
-      _fsec -= (86400e0 + extra_sec_in_day);
-      ++_mjd;
-      dat(modified_julian_day(_mjd), extra_sec_in_day);
-    }
-    while (_fsec < 0e0) {
-      --_mjd;
-      _fsec += 86400e0;
-      dat(modified_julian_day(_mjd), extra_sec_in_day);
-      _fsec += 1e0 * extra_sec_in_day;
-    }
-#ifdef DEBUG
-    if (_mjd)
-      assert(_fsec >= 0e0 && _fsec < 86400e0 + extra_sec_in_day);
-    else
-      assert(_fsec < 0e0 && _fsec > -86400e0);
-#endif
-    /* all done */
-    return;
+    normalize_impl([](int mjd, int &extra) {
+      return dat(modified_julian_day(mjd), extra);
+    });
+  }
+
+  /** @brief Normalize an instance, using a LeapCursor for ΔAT lookups.
+   *
+   * Same as normalize(), but the leap second table is not searched; ΔAT
+   * values are resolved via the \p cursor (see LeapCursor).
+   */
+  void normalize(LeapCursor &cursor) noexcept {
+    if (_fsec >= 0e0 && _fsec < 86400e0)
+      return;
+    normalize_impl(
+        [&cursor](int mjd, int &extra) { return cursor.dat(mjd, extra); });
   }
 
   /** @brief Transform a UTC date to a TAI date, via TAI = UTC + ΔAT. */
   TwoPartDate utc2tai() const noexcept;
 
+  /** @brief Transform a UTC date to a TAI date, via TAI = UTC + ΔAT.
+   *
+   * ΔAT is resolved via the \p cursor (see LeapCursor); for time-ordered
+   * epochs, this avoids searching the leap second table.
+   */
+  TwoPartDate utc2tai(LeapCursor &cursor) const noexcept;
+
   /** @brief Transform a UTC date to a TT date */
   TwoPartDate utc2tt() const noexcept;
 
@@ -319,10 +443,28 @@ public:
  * The methods of the class, including constructors, take special care to
  * always keep the seconds as seconds of day, i.e. in the range [0,86400) and
  * correspondingly increase/decrease the day count.
+ *
+ * The seconds of day are stored in the floating point representation R,
+ * i.e. one of:
+ * - double (TwoPartDate); fastest, resolution of ~1e-11 sec,
+ * - long double (TwoPartDateLD); resolution of ~1e-14 sec on x86, same as
+ *   double on platforms where long double is double, and
+ * - DoubleDouble (TwoPartDateDD); a few times slower than double, but
+ *   arithmetic on the seconds (normalize, add_seconds, operator+,
+ *   operator- and diff) is error-free to far below a picosecond, even for
+ *   epochs decades apart.
+ * Accessors that return FractionalSeconds/Days/Years (e.g. seconds() or
+ * diff()) are rounded (once) to double; seconds_rep() and diff_seconds()
+ * return the seconds in the full precision of R.
  */
-class TwoPartDate {
+template <typename R> class TwoPartDateT {
+  static_assert(std::is_same_v<R, double> || std::is_same_v<R, long double> ||
+                    std::is_same_v<R, DoubleDouble>,
+                "TwoPartDateT: seconds must be double, long double or "
+                "DoubleDouble");
+
 private:
-  using FDOUBLE = /*long*/ double;
+  using FDOUBLE = R;
   int _mjd;      /** Mjd */
   FDOUBLE _fsec; /** fractional seconds of day in [0, 86400) */
 
@@ -333,7 +475,7 @@ private:
    * avoid misconceptions (i.e. avoid ambiguous parameters, fractional seconds
    * or fractional days, or ...).
    */
-  TwoPartDate(int mjd, FDOUBLE secday) noexcept : _mjd(mjd), _fsec(secday) {
+  TwoPartDateT(int mjd, FDOUBLE secday) noexcept : _mjd(mjd), _fsec(secday) {
     normalize();
   }
 
@@ -358,8 +500,8 @@ protected:
    * @wanrning Will not call nomralize, given secday should be in range
    *           [0. 86400)
    */
-  constexpr TwoPartDate(int mjd, FDOUBLE secday,
-                        [[maybe_unused]] char c) noexcept
+  constexpr TwoPartDateT(int mjd, FDOUBLE secday,
+                         [[maybe_unused]] char c) noexcept
       : _mjd(mjd), _fsec(secday) {}
 
 public:
@@ -373,20 +515,19 @@ public:
 #else
   template <typename T, typename = std::enable_if_t<T::is_of_sec_type>>
 #endif
-  constexpr explicit TwoPartDate(const datetime<T> &d) noexcept
+  constexpr explicit TwoPartDateT(const datetime<T> &d) noexcept
       : _mjd(d.imjd().as_underlying_type()),
-        _fsec(to_fractional_seconds<T>(d.sec()).seconds()) {
-  }
+        _fsec(core::seconds_to_rep<FDOUBLE>(d.sec())) {}
 
   /** @brief Reference epoch (J2000.0), as a Modified Julian Date. */
-  static constexpr TwoPartDate j2000_mjd() noexcept {
-    return TwoPartDate(51544, 86400e0 / 2e0, 'y');
+  static constexpr TwoPartDateT j2000_mjd() noexcept {
+    return TwoPartDateT(51544, 86400e0 / 2e0, 'y');
   }
 
   /** @brief Random Date within some MJD limits
    * @todo transfer this into a .cpp file
    */
-  static TwoPartDate
+  static TwoPartDateT
   random(modified_julian_day from = modified_julian_day::min(),
          modified_julian_day to = modified_julian_day::max()) noexcept {
     int istart = (int)from.as_underlying_type();
@@ -395,55 +536,61 @@ public:
     std::mt19937 gen(rd());
     std::uniform_int_distribution<int> distr(istart, istop);
     std::uniform_real_distribution<double> unif(0, 86400e0);
-    return TwoPartDate(distr(gen), unif(gen), 'y');
+    return TwoPartDateT(distr(gen), unif(gen), 'y');
   }
 
   /** @brief Min date. This is the same as datetime<T>::min(). */
-  static constexpr TwoPartDate min() noexcept {
-    return TwoPartDate(datetime<nanoseconds>::min());
+  static constexpr TwoPartDateT min() noexcept {
+    return TwoPartDateT(datetime<nanoseconds>::min());
   }
 
   /** @brief Max date. This is the same as datetime<T>::max(). */
-  static constexpr TwoPartDate max() noexcept {
-    return TwoPartDate(datetime<nanoseconds>::max());
+  static constexpr TwoPartDateT max() noexcept {
+    return TwoPartDateT(datetime<nanoseconds>::max());
   }
 
   /** @brief Constructor from MJDay and FractionalSeconds.  */
-  explicit TwoPartDate(int b = 0,
-                       FractionalSeconds s = FractionalSeconds{0}) noexcept
+  explicit TwoPartDateT(int b = 0,
+                        FractionalSeconds s = FractionalSeconds{0}) noexcept
       : _mjd(b), _fsec(s.seconds()) {
     this->normalize();
   }
 
   /** @brief Constructor from MJDay; FractionalSeconds are set to 0.  */
-  constexpr explicit TwoPartDate(modified_julian_day mjd) noexcept
+  constexpr explicit TwoPartDateT(modified_julian_day mjd) noexcept
       : _mjd(mjd.as_underlying_type()), _fsec(0) {};
 
   /** @brief Constructor from calendar date. */
-  explicit TwoPartDate(year y, month m, day_of_month d, double sec_of_day = 0e0)
+  explicit TwoPartDateT(year y, month m, day_of_month d,
+                        double sec_of_day = 0e0)
       : _mjd(modified_julian_day(y, m, d).as_underlying_type()),
         _fsec(sec_of_day) {
     this->normalize();
   }
 
   /** @brief Constructor from year, day of year and time of day. */
-  explicit TwoPartDate(year y, day_of_year d, double sec_of_day = 0e0)
+  explicit TwoPartDateT(year y, day_of_year d, double sec_of_day = 0e0)
       : _mjd(modified_julian_day(y, d).as_underlying_type()),
         _fsec(sec_of_day) {
     this->normalize();
   }
 
   /** @brief Get the MJD as an intgral number, i.e. no fractional part. */
-  int imjd() const noexcept { return _mjd; }
+  constexpr int imjd() const noexcept { return _mjd; }
 
   /** @brief Get the (fractional) seconds of the MJD. Always in [0, 86400). */
-  FractionalSeconds seconds() const noexcept {
-    return FractionalSeconds(_fsec);
+  constexpr FractionalSeconds seconds() const noexcept {
+    return FractionalSeconds(core::to_double(_fsec));
   }
 
+  /** @brief Get the seconds of the MJD in the full precision of the
+   * representation R. Always in [0, 86400).
+   */
+  constexpr FDOUBLE seconds_rep() const noexcept { return _fsec; }
+
   /** @brief Get the seconds of the MJD as fractional day. Always in [0,1). */
   FractionalDays fractional_days() const noexcept {
-    return FractionalDays(_fsec / 86400e0);
+    return FractionalDays(core::to_double(_fsec / 86400e0));
   }
 
   /** @brief Get the fractional seconds of day as some multiple of seconds.
@@ -465,8 +612,8 @@ public:
 #else
   template <typename T, typename = std::enable_if_t<T::is_of_sec_type>>
 #endif
-  FDOUBLE sec_of_day() const noexcept {
-    return seconds().seconds() * T::template sec_factor<FDOUBLE>();
+  double sec_of_day() const noexcept {
+    return seconds().seconds() * T::template sec_factor<double>();
   }
 
   /** @brief Transform the (integral part of the) date to Year Month Day */
@@ -527,18 +674,18 @@ public:
    * This means that the number of days can be negative, but the fractional
    * day will always be positive
    */
-  TwoPartDate operator-(const TwoPartDate &d) const noexcept {
-    return TwoPartDate(_mjd - d._mjd, _fsec - d._fsec);
+  TwoPartDateT operator-(const TwoPartDateT &d) const noexcept {
+    return TwoPartDateT(_mjd - d._mjd, _fsec - d._fsec);
   }
 
   /** @brief Remove (subtract) whole days. */
-  TwoPartDate operator-(const modified_julian_day days) const noexcept {
-    return TwoPartDate(_mjd - days.as_underlying_type(), _fsec);
+  TwoPartDateT operator-(const modified_julian_day days) const noexcept {
+    return TwoPartDateT(_mjd - days.as_underlying_type(), _fsec);
   }
 
   /** @brief Add integral days. */
-  TwoPartDate operator+(const modified_julian_day days) const noexcept {
-    return TwoPartDate(_mjd + days.as_underlying_type(), _fsec);
+  TwoPartDateT operator+(const modified_julian_day days) const noexcept {
+    return TwoPartDateT(_mjd + days.as_underlying_type(), _fsec);
   }
 
   /** @brief Add two instances.
@@ -547,8 +694,8 @@ public:
    * (rather than an actual datetime instance). The right operand can be a
    * negative interval, which means that we are going backwards in time.
    */
-  TwoPartDate operator+(const TwoPartDate &d) const noexcept {
-    return TwoPartDate(_mjd + d._mjd, _fsec + d._fsec);
+  TwoPartDateT operator+(const TwoPartDateT &d) const noexcept {
+    return TwoPartDateT(_mjd + d._mjd, _fsec + d._fsec);
   }
 
   /** @brief Get the difference between two datetime instances as a floating
@@ -563,14 +710,14 @@ public:
    */
   template <DateTimeDifferenceType DT>
   typename DateTimeDifferenceTypeTraits<DT>::dif_type
-  diff(const TwoPartDate &d) const noexcept {
+  diff(const TwoPartDateT &d) const noexcept {
     if constexpr (DT == DateTimeDifferenceType::FractionalDays) {
       /* difference as fractional days */
-      return FractionalDays{(_mjd - d._mjd) + (_fsec - d._fsec) / SEC_PER_DAY};
+      return FractionalDays{core::to_double(
+          (_mjd - d._mjd) + (_fsec - d._fsec) / SEC_PER_DAY)};
     } else if constexpr (DT == DateTimeDifferenceType::FractionalSeconds) {
       /* difference as fractional seconds */
-      return FractionalSeconds{(_fsec - d._fsec) +
-                               (_mjd - d._mjd) * SEC_PER_DAY};
+      return FractionalSeconds{core::to_double(diff_seconds(d))};
     } else {
       /* difference as fractional (julian) years */
       return FractionalYears{
@@ -579,9 +726,20 @@ public:
     }
   }
 
+  /** @brief Get the difference between two datetime instances in seconds,
+   * in the full precision of the representation R.
+   *
+   * If called as d1.diff_seconds(d2), the computation is d1-d2.
+   *
+   * @warning Does not take into account leap seconds.
+   */
+  FDOUBLE diff_seconds(const TwoPartDateT &d) const noexcept {
+    return (_fsec - d._fsec) + (_mjd - d._mjd) * SEC_PER_DAY;
+  }
+
   /** @brief Get the date as (fractional) Julian Date. */
-  FDOUBLE julian_date() const noexcept {
-    return _fsec / SEC_PER_DAY + (_mjd + dso::MJD0_JD);
+  double julian_date() const noexcept {
+    return core::to_double(_fsec / SEC_PER_DAY + (_mjd + dso::MJD0_JD));
   }
 
   /** @brief Transform instance to TT, assuming it is in TAI.
@@ -589,9 +747,9 @@ public:
    * The two time scales are connected by the formula:
    * \f$ TT = TAI + ΔT \$ where \f$ ΔT = TT - TAI = 32.184 [sec] \f$
    */
-  TwoPartDate tai2tt() const noexcept {
+  TwoPartDateT tai2tt() const noexcept {
     constexpr const FDOUBLE dtat = TT_MINUS_TAI;
-    return TwoPartDate(_mjd, _fsec + dtat);
+    return TwoPartDateT(_mjd, _fsec + dtat);
   }
 
   /** @brief Transform an instance to TAI assuming it is in TT.
@@ -599,9 +757,9 @@ public:
    * The two time scales are connected by the formula:
    * \f$ TT = TAI + ΔT \$ where \f$ ΔT = TT - TAI = 32.184 [sec] \f$
    */
-  TwoPartDate tt2tai() const noexcept {
+  TwoPartDateT tt2tai() const noexcept {
     constexpr const FDOUBLE dtat = TT_MINUS_TAI;
-    return TwoPartDate(_mjd, _fsec - dtat);
+    return TwoPartDateT(_mjd, _fsec - dtat);
   }
 
   /** @brief Transform an instance to GPS Time assuming it is in TAI.
@@ -609,13 +767,13 @@ public:
    * The two time scales are connected by the formula:
    * \f$ TAI = GPSTime + 19 [sec] \f$
    */
-  TwoPartDate tai2gps() const noexcept {
-    return TwoPartDate(_mjd, _fsec - TAI_MINUS_GPS);
+  TwoPartDateT tai2gps() const noexcept {
+    return TwoPartDateT(_mjd, _fsec - TAI_MINUS_GPS);
   }
 
   /** @brief Transform an instance to TAI Time assuming it is in GPS Time. */
-  TwoPartDate gps2tai() const noexcept {
-    return TwoPartDate(_mjd, _fsec + TAI_MINUS_GPS);
+  TwoPartDateT gps2tai() const noexcept {
+    return TwoPartDateT(_mjd, _fsec + TAI_MINUS_GPS);
   }
 
   /** @brief Transform an instance to UTC assuming it is in TAI. */
@@ -623,7 +781,7 @@ public:
     FDOUBLE utcsec = _fsec - (double)dat(modified_julian_day(_mjd));
     int utcmjd = _mjd;
     /* let the TwoPartDateUTC constructor normalize the instance */
-    return TwoPartDateUTC(utcmjd, FractionalSeconds{utcsec});
+    return TwoPartDateUTC(utcmjd, FractionalSeconds{core::to_double(utcsec)});
   }
 
   /** @brief Transform an instance to UTC assuming it is in GPS Time. */
@@ -645,59 +803,62 @@ public:
    * @return The corresponding UT1 MJD, computed using:
    *         ∆T = TT − UT1 = 32.184[sec] + ∆AT − ∆UT1
    */
-  TwoPartDate tt2ut1(FDOUBLE dut1) const noexcept {
+  TwoPartDateT tt2ut1(FDOUBLE dut1) const noexcept {
     /* note that ΔUT1 = UT1 − UTC hence UT1 = ΔUT1 + UTC
      * UT1 = TT - 32.184[sec] - ΔAT + ΔUT1
      *     = TAI - ΔAT + ΔUT1
      */
     const auto utc = this->tt2utc();
-    TwoPartDate ut1(utc.imjd(), utc.seconds());
+    TwoPartDateT ut1(utc.imjd(), utc.seconds());
     ut1.add_seconds(dut1);
     return ut1;
   }
 
   /** @brief TAI to UT1 MJD. */
-  TwoPartDate tai2ut1(FDOUBLE dut1) const noexcept {
+  TwoPartDateT tai2ut1(FDOUBLE dut1) const noexcept {
     /* UT1 = TAI + ΔUT1 - ΔAT
      *     = UTC + ΔUT1
      */
     const auto utc = this->tai2utc();
-    TwoPartDate ut1(utc.imjd(), utc.seconds());
+    TwoPartDateT ut1(utc.imjd(), utc.seconds());
     ut1.add_seconds(dut1);
     return ut1;
   }
 
   /** @brief Return instance as fractional MJD. */
-  FDOUBLE as_mjd() const noexcept { return _fsec / SEC_PER_DAY + _mjd; }
+  double as_mjd() const noexcept {
+    return core::to_double(_fsec / SEC_PER_DAY + _mjd);
+  }
 
   /** @brief Return Julian Centuries since J2000.0 */
-  FDOUBLE jcenturies_sinceJ2000() const noexcept {
-    return ((static_cast<FDOUBLE>(_mjd) - J2000_MJD) + _fsec / SEC_PER_DAY) /
-           DAYS_IN_JULIAN_CENT;
+  double jcenturies_sinceJ2000() const noexcept {
+    return core::to_double(
+        ((static_cast<FDOUBLE>(_mjd) - J2000_MJD) + _fsec / SEC_PER_DAY) /
+        DAYS_IN_JULIAN_CENT);
   }
 
   /** @brief Convert to Julian Epoch, assuming the TT time-scale. */
-  FDOUBLE epj() const noexcept {
+  double epj() const noexcept {
     return core::mjd2epj((double)imjd(), seconds().seconds() / SEC_PER_DAY);
   }
 
   /** @brief Overload the '>' operator. */
-  bool operator>(const TwoPartDate &d) const noexcept {
+  bool operator>(const TwoPartDateT &d) const noexcept {
     return (_mjd > d._mjd) || ((_mjd == d._mjd) && (_fsec > d._fsec));
   }
 
   /** @brief Overload the '>=' operator. */
-  bool operator>=(const TwoPartDate &d) const noexcept {
+  bool operator>=(const TwoPartDateT &d) const noexcept {
     return (_mjd > d._mjd) || ((_mjd == d._mjd) && (_fsec >= d._fsec));
   }
 
   /** @brief Overload the '<' operator. */
-  bool operator<(const TwoPartDate &d) const noexcept {
+  bool operator<(const TwoPartDateT &d) const noexcept {
     return (_mjd < d._mjd) || ((_mjd == d._mjd) && (_fsec < d._fsec));
   }
 
   /** @brief Overload the '<=' operator. */
-  bool operator<=(const TwoPartDate &d) const noexcept {
+  bool operator<=(const TwoPartDateT &d) const noexcept {
     return (_mjd < d._mjd) || ((_mjd == d._mjd) && (_fsec <= d._fsec));
   }
 
@@ -713,16 +874,22 @@ public:
   void normalize() noexcept {
     if (_fsec >= 0e0 && _fsec < 86400e0)
       return;
-    /* remove whole days from seconds and compute signed remainder */
-    auto srem = std::fmod(_fsec, seconds::max_in_day);
-    int extradays = _fsec / seconds::max_in_day;
-    /* only allow negative seconds if whole days are zero */
-    if ((srem < 0e0) && (_mjd + extradays)) {
-      --extradays;
-      srem += seconds::max_in_day;
+    if constexpr (std::is_floating_point_v<FDOUBLE>) {
+      /* no std::fmod; this is the same kernel as tpdate_column's */
+      core::normalize_sec_of_day(_mjd, _fsec);
+    } else {
+      /* remove whole days from seconds and compute signed remainder (exact)
+       */
+      int extradays;
+      FDOUBLE srem = core::fmod_quo(_fsec, SEC_PER_DAY, extradays);
+      /* only allow negative seconds if whole days are zero */
+      if ((srem < 0e0) && (_mjd + extradays)) {
+        --extradays;
+        srem += seconds::max_in_day;
+      }
+      _fsec = srem;
+      _mjd += extradays;
     }
-    _fsec = srem;
-    _mjd += extradays;
 #ifdef DEBUG
     if (_mjd) {
       assert(_fsec >= 0e0 && _fsec < 86400e0);
@@ -739,17 +906,82 @@ public:
   }
 
   /** @brief Overload equality operator. */
-  bool operator==(const TwoPartDate &d) const noexcept {
+  bool operator==(const TwoPartDateT &d) const noexcept {
     return (_mjd == d._mjd) && (_fsec == d._fsec);
   }
 
   /** @brief Overload in-equality operator */
-  bool operator!=(const TwoPartDate &d) const noexcept {
+  bool operator!=(const TwoPartDateT &d) const noexcept {
     return !(this->operator==(d));
   }
 
   friend class TwoPartDateUTC;
-}; /* class TwoPartDate */
+}; /* class TwoPartDateT */
+
+/** TwoPartDate, with seconds of day stored as long double. */
+using TwoPartDateLD = TwoPartDateT<long double>;
+
+/** TwoPartDate, with seconds of day stored as DoubleDouble. */
+using TwoPartDateDD = TwoPartDateT<DoubleDouble>;
+
+namespace core {
+/** Minimum number of elements per thread, for parallel UTC conversions */
+constexpr const std::size_t LEAP_BATCH_GRAIN = std::size_t(1) << 14;
+} /* namespace core */
+
+/** @brief Transform an array of UTC dates to TAI, via TAI = UTC + ΔAT.
+ *
+ * Batch version of TwoPartDateUTC::utc2tai, i.e. out[i] = utc[i].utc2tai(),
+ * with identical results. The array is processed in one pass, resolving ΔAT
+ * via a LeapCursor; for (roughly) time-ordered input, the leap second table
+ * is only searched when the epochs cross into another ΔAT segment.
+ *
+ * @param[in]  utc Array of n UTC dates
+ * @param[in]  n   Number of elements in the arrays
+ * @param[out] out Array of n elements; at output, the TAI dates
+ */
+void utc2tai_batch(const TwoPartDateUTC *utc, std::size_t n,
+                   TwoPartDate *out) noexcept;
+
+/** @brief Transform an array of UTC dates to TT; batch version of
+ * TwoPartDateUTC::utc2tt (see utc2tai_batch).
+ */
+void utc2tt_batch(const TwoPartDateUTC *utc, std::size_t n,
+                  TwoPartDate *out) noexcept;
+
+/** @brief Transform an array of TAI dates to UTC; batch version of
+ * TwoPartDate::tai2utc (see utc2tai_batch).
+ */
+void tai2utc_batch(const TwoPartDate *tai, std::size_t n,
+                   TwoPartDateUTC *out) noexcept;
+
+/** @brief Transform an array of GPS Time dates to UTC; batch version of
+ * TwoPartDate::gps2utc (see utc2tai_batch).
+ */
+void gps2utc_batch(const TwoPartDate *gps, std::size_t n,
+                   TwoPartDateUTC *out) noexcept;
+
+/** @brief Same as utc2tai_batch, using (at most) num_threads threads.
+ *
+ * The arrays are split in contiguous chunks (of at least
+ * core::LEAP_BATCH_GRAIN elements), each processed by its own thread with
+ * its own LeapCursor. All threads use the same leap second table (i.e. the
+ * one in use at the time of the call).
+ */
+void parallel_utc2tai_batch(const TwoPartDateUTC *utc, std::size_t n,
+                            TwoPartDate *out, unsigned num_threads);
+
+/** @brief Same as utc2tt_batch, using (at most) num_threads threads. */
+void parallel_utc2tt_batch(const TwoPartDateUTC *utc, std::size_t n,
+                           TwoPartDate *out, unsigned num_threads);
+
+/** @brief Same as tai2utc_batch, using (at most) num_threads threads. */
+void parallel_tai2utc_batch(const TwoPartDate *tai, std::size_t n,
+                            TwoPartDateUTC *out, unsigned num_threads);
+
+/** @brief Same as gps2utc_batch, using (at most) num_threads threads. */
+void parallel_gps2utc_batch(const TwoPartDate *gps, std::size_t n,
+                            TwoPartDateUTC *out, unsigned num_threads);
 
 /** @brief Julian Epoch to two-part Modified Julian Date (TT).
  *
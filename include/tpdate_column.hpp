@@ -0,0 +1,224 @@
+/** @file
+ *
+ * Define a tpdate_column container, i.e. a structure-of-arrays collection
+ * of TwoPartDate epochs. MJDs and (fractional) seconds of day are stored in
+ * two separate (64-byte aligned) arrays, so that bulk operations on the
+ * epochs (addition of seconds, normalization and differences) are simple,
+ * branch-free loops which the compiler vectorizes.
+ *
+ * This is meant for e.g. propagating many (satellite) epochs at once, where
+ * epochs cross day boundaries all the time. Normalization does not use
+ * std::fmod; it uses the floor-multiply kernel core::normalize_sec_of_day,
+ * which is also used by TwoPartDate::normalize, hence all results are
+ * bit-identical to the ones of the corresponding scalar (TwoPartDate)
+ * operations.
+ *
+ * Example:
+ * dso::tpdate_column col(epochs.data(), epochs.size());
+ * col.add_seconds(dso::FractionalSeconds(30e0));
+ * std::vector<double> dt(col.size());
+ * col.diff<dso::DateTimeDifferenceType::FractionalSeconds>(t0, dt.data());
+ */
+
+#ifndef __DSO_DATETIME_TPDATE_COLUMN_HPP__
+#define __DSO_DATETIME_TPDATE_COLUMN_HPP__
+
+#include "core/aligned_allocator.hpp"
+#include "tpdate.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace dso {
+
+/** @brief A structure-of-arrays container of TwoPartDate epochs.
+ *
+ * Public methods keep the elements normalized (as TwoPartDate does). Only
+ * when the raw arrays are modified (via mjd_data and sec_data) should users
+ * call normalize.
+ */
+class tpdate_column {
+public:
+  using value_type = TwoPartDate;
+
+  /** @brief Proxy to an element, converting to/from TwoPartDate */
+  class reference {
+  public:
+    /** @brief The element, as a TwoPartDate */
+    TwoPartDate value() const noexcept {
+      return TwoPartDate(*m_mjd, FractionalSeconds(*m_sec));
+    }
+    operator TwoPartDate() const noexcept { return value(); }
+    reference &operator=(const TwoPartDate &d) noexcept {
+      *m_mjd = d.imjd();
+      *m_sec = d.seconds().seconds();
+      return *this;
+    }
+    reference &operator=(const reference &r) noexcept {
+      return this->operator=(r.value());
+    }
+    reference(const reference &) noexcept = default;
+
+  private:
+    friend class tpdate_column;
+    reference(int *mjd, double *sec) noexcept : m_mjd(mjd), m_sec(sec) {}
+    int *m_mjd;
+    double *m_sec;
+  }; /* class reference */
+
+  /** @brief Empty column */
+  tpdate_column() noexcept = default;
+
+  /** @brief Column of n elements, all set to \p d */
+  explicit tpdate_column(std::size_t n, const TwoPartDate &d = TwoPartDate())
+      : m_mjd(n, d.imjd()), m_sec(n, d.seconds().seconds()) {}
+
+  /** @brief Column from an array of n TwoPartDate instances */
+  tpdate_column(const TwoPartDate *d, std::size_t n) : m_mjd(n), m_sec(n) {
+    for (std::size_t i = 0; i < n; i++) {
+      m_mjd[i] = d[i].imjd();
+      m_sec[i] = d[i].seconds().seconds();
+    }
+  }
+
+  /** @brief Copy the elements to an array of (at least) size() TwoPartDate
+   * instances.
+   */
+  void to_dates(TwoPartDate *d) const noexcept {
+    for (std::size_t i = 0; i < size(); i++)
+      d[i] = (*this)[i];
+  }
+
+  /** @brief Number of elements */
+  std::size_t size() const noexcept { return m_mjd.size(); }
+  /** @brief Check if there are no elements */
+  bool empty() const noexcept { return m_mjd.empty(); }
+  void reserve(std::size_t n) {
+    m_mjd.reserve(n);
+    m_sec.reserve(n);
+  }
+  void resize(std::size_t n, const TwoPartDate &d = TwoPartDate()) {
+    m_mjd.resize(n, d.imjd());
+    m_sec.resize(n, d.seconds().seconds());
+  }
+  void clear() noexcept {
+    m_mjd.clear();
+    m_sec.clear();
+  }
+  void push_back(const TwoPartDate &d) {
+    m_mjd.push_back(d.imjd());
+    m_sec.push_back(d.seconds().seconds());
+  }
+
+  /** @brief Element \p i, as a TwoPartDate */
+  TwoPartDate operator[](std::size_t i) const noexcept {
+    return TwoPartDate(m_mjd[i], FractionalSeconds(m_sec[i]));
+  }
+  /** @brief Element \p i, as a proxy (assignable from TwoPartDate) */
+  reference operator[](std::size_t i) noexcept {
+    return reference(m_mjd.data() + i, m_sec.data() + i);
+  }
+
+  /** @brief Raw array of MJDs */
+  int *mjd_data() noexcept { return m_mjd.data(); }
+  const int *mjd_data() const noexcept { return m_mjd.data(); }
+  /** @brief Raw array of (fractional) seconds of day */
+  double *sec_data() noexcept { return m_sec.data(); }
+  const double *sec_data() const noexcept { return m_sec.data(); }
+
+  /** @brief Normalize all elements, i.e. move whole days from the seconds
+   * to the MJDs, so that seconds of day are in [0, 86400).
+   *
+   * Same as TwoPartDate::normalize, for each element.
+   */
+  void normalize() noexcept {
+    int *__restrict__ mjd = m_mjd.data();
+    double *__restrict__ sec = m_sec.data();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      core::normalize_sec_of_day(mjd[i], sec[i]);
+  }
+
+  /** @brief Add (algebraically) the same amount of seconds to all elements.
+   *
+   * Same as TwoPartDate::add_seconds, for each element.
+   */
+  void add_seconds(FractionalSeconds s) noexcept {
+    int *__restrict__ mjd = m_mjd.data();
+    double *__restrict__ sec = m_sec.data();
+    const double ds = s.seconds();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++) {
+      sec[i] += ds;
+      core::normalize_sec_of_day(mjd[i], sec[i]);
+    }
+  }
+
+  /** @brief Add (algebraically) seconds to each element, i.e. \p s[i]
+   * seconds to element i; \p s must hold (at least) size() elements.
+   */
+  void add_seconds(const double *__restrict__ s) noexcept {
+    int *__restrict__ mjd = m_mjd.data();
+    double *__restrict__ sec = m_sec.data();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++) {
+      sec[i] += s[i];
+      core::normalize_sec_of_day(mjd[i], sec[i]);
+    }
+  }
+
+  /** @brief Difference of each element to a reference epoch, i.e.
+   * (*this)[i].diff<DT>(ref), as fractional seconds, days or years.
+   *
+   * @warning Does not take into account leap seconds.
+   */
+  template <DateTimeDifferenceType DT>
+  void diff(const TwoPartDate &ref, double *__restrict__ dt) const noexcept {
+    const int *__restrict__ mjd = m_mjd.data();
+    const double *__restrict__ sec = m_sec.data();
+    const int rmjd = ref.imjd();
+    const double rsec = ref.seconds().seconds();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      dt[i] = diff_one<DT>(mjd[i], sec[i], rmjd, rsec);
+  }
+
+  /** @brief Element-wise difference of two columns, i.e.
+   * (*this)[i].diff<DT>(other[i]); \p other must hold (at least) size()
+   * elements.
+   *
+   * @warning Does not take into account leap seconds.
+   */
+  template <DateTimeDifferenceType DT>
+  void diff(const tpdate_column &other, double *__restrict__ dt) const
+      noexcept {
+    const int *__restrict__ mjd = m_mjd.data();
+    const double *__restrict__ sec = m_sec.data();
+    const int *__restrict__ omjd = other.m_mjd.data();
+    const double *__restrict__ osec = other.m_sec.data();
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+      dt[i] = diff_one<DT>(mjd[i], sec[i], omjd[i], osec[i]);
+  }
+
+private:
+  /** @brief Same computation as TwoPartDate::diff<DT> */
+  template <DateTimeDifferenceType DT>
+  static double diff_one(int mjd, double sec, int rmjd,
+                         double rsec) noexcept {
+    if constexpr (DT == DateTimeDifferenceType::FractionalDays) {
+      return (mjd - rmjd) + (sec - rsec) / SEC_PER_DAY;
+    } else if constexpr (DT == DateTimeDifferenceType::FractionalSeconds) {
+      return (sec - rsec) + (mjd - rmjd) * SEC_PER_DAY;
+    } else {
+      return ((mjd - rmjd) + (sec - rsec) / SEC_PER_DAY) /
+             DAYS_IN_JULIAN_YEAR;
+    }
+  }
+
+  std::vector<int, core::aligned_allocator<int>> m_mjd;
+  std::vector<double, core::aligned_allocator<double>> m_sec;
+}; /* class tpdate_column */
+
+} /* namespace dso */
+
+#endif
@@ -0,0 +1,54 @@
+/** @file
+ *
+ * A minimal allocator returning storage aligned to a given boundary, so that
+ * std::vector can be used for the columns of structure-of-arrays containers
+ * (aligned for SIMD loads/stores).
+ */
+
+#ifndef __DSO_DATETIME_CORE_ALIGNED_ALLOCATOR_HPP__
+#define __DSO_DATETIME_CORE_ALIGNED_ALLOCATOR_HPP__
+
+#include <cstddef>
+#include <new>
+
+namespace dso::core {
+
+/** Default alignment of columns, in bytes (i.e. a cache line/ZMM register) */
+constexpr const std::size_t COLUMN_ALIGNMENT = 64;
+
+/** @brief Allocator for T aligned at A bytes. */
+template <typename T, std::size_t A = COLUMN_ALIGNMENT>
+struct aligned_allocator {
+  static_assert(A >= alignof(T) && (A & (A - 1)) == 0);
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = aligned_allocator<U, A>;
+  };
+
+  constexpr aligned_allocator() noexcept = default;
+  template <typename U>
+  constexpr aligned_allocator(const aligned_allocator<U, A> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(A)));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(A));
+  }
+
+  template <typename U>
+  constexpr bool operator==(const aligned_allocator<U, A> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  constexpr bool operator!=(const aligned_allocator<U, A> &) const noexcept {
+    return false;
+  }
+}; /* struct aligned_allocator */
+
+} /* namespace dso::core */
+
+#endif
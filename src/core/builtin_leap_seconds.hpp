@@ -0,0 +1,103 @@
+/** @file
+ *
+ * The built-in (compiled) history of ΔAT = TAI - UTC, as published by the
+ * IERS (Bulletin C). This is the single compiled-in copy of the leap second
+ * table; every ΔAT and leap-insertion lookup of the library is driven by it,
+ * unless a more recent table is loaded at run-time (see leap_seconds.hpp).
+ *
+ * The functions in here act on plain integral MJDs (no dso types), so that
+ * they can be used by the date classes themselves.
+ */
+
+#ifndef __DSO_BUILTIN_LEAP_SECONDS_CORE_HPP__
+#define __DSO_BUILTIN_LEAP_SECONDS_CORE_HPP__
+
+#include "fundamental_calendar_utils.hpp"
+#include <array>
+
+namespace dso::core {
+
+/** @brief A change in ΔAT, i.e. the MJD ΔAT changes and its new value. */
+struct leap_second_change {
+  /** MJD at which ΔAT takes the value \p delat (always 1st of month) */
+  int mjd;
+  /** ΔAT = TAI - UTC in [sec], from \p mjd onwards */
+  int delat;
+};
+
+/** @brief MJD up to which the built-in table is known to be valid.
+ *
+ * This is the expiry date of the IERS Leap_Second.dat file the table was
+ * last synchronized with (28 June 2026, IERS Bulletin C 70).
+ */
+constexpr const int BUILTIN_LEAP_SECONDS_EXPIRY_MJD = 61219;
+
+/** @brief MJDs where ΔAT has changed, along with the new ΔAT values. */
+constexpr const std::array<leap_second_change, 28> builtin_leap_seconds = {
+    {{41317, 10}, {41499, 11}, {41683, 12}, {42048, 13}, {42413, 14},
+     {42778, 15}, {43144, 16}, {43509, 17}, {43874, 18}, {44239, 19},
+     {44786, 20}, {45151, 21}, {45516, 22}, {46247, 23}, {47161, 24},
+     {47892, 25}, {48257, 26}, {48804, 27}, {49169, 28}, {49534, 29},
+     {50083, 30}, {50630, 31}, {51179, 32}, {53736, 33}, {54832, 34},
+     {56109, 35}, {57204, 36}, {57754, 37}}};
+
+/** @brief Check if an MJD is a leap insertion day, using the built-in table.
+ *
+ * A leap insertion day is the day prior to a ΔAT change (i.e. the day which
+ * ends with a leap second).
+ *
+ * @param[in] mjd The date as (integral) MJD
+ * @return 1 if \p mjd is a leap insertion day, 0 otherwise
+ */
+constexpr int builtin_is_leap_insertion_day(int mjd) noexcept {
+  for (int i = builtin_leap_seconds.size() - 1; i >= 0; i--) {
+    if (mjd == builtin_leap_seconds[i].mjd - 1)
+      return 1;
+    if (mjd > builtin_leap_seconds[i].mjd - 1)
+      return 0;
+  }
+  return 0;
+}
+
+/** @brief ΔAT for a given (integral) UTC MJD, using the built-in table.
+ *
+ * For MJDs prior to the first change, the first ΔAT value is returned.
+ *
+ * @param[in] mjd The date as (integral) MJD
+ * @param[out] extra_sec_in_day Extra seconds in day, i.e. 1 if \p mjd is a
+ *             day ending with a leap second, 0 otherwise
+ * @return ΔAT = TAI - UTC in [sec] up to (\p mjd, 23:59:59)
+ */
+constexpr int builtin_dat(int mjd, int &extra_sec_in_day) noexcept {
+  extra_sec_in_day = 0;
+  for (int i = builtin_leap_seconds.size() - 1; i >= 0; i--) {
+    if (mjd >= builtin_leap_seconds[i].mjd) {
+      if (i + 1 < static_cast<int>(builtin_leap_seconds.size()) &&
+          mjd == builtin_leap_seconds[i + 1].mjd - 1)
+        extra_sec_in_day =
+            builtin_leap_seconds[i + 1].delat - builtin_leap_seconds[i].delat;
+      return builtin_leap_seconds[i].delat;
+    }
+  }
+  return builtin_leap_seconds[0].delat;
+}
+
+/** @brief ΔAT for a given (integral) UTC MJD, using the built-in table. */
+constexpr int builtin_dat(int mjd) noexcept {
+  int extra = 0;
+  return builtin_dat(mjd, extra);
+}
+
+/** @brief ΔAT for a given calendar month, using the built-in table.
+ *
+ * @param[in] iy The year
+ * @param[in] im The month, in range [1,12]
+ */
+constexpr int builtin_dat_calendar(int iy, int im) {
+  /* changes always occur on the first day of a month */
+  return builtin_dat(static_cast<int>(cal2mjd(iy, im, 1)));
+}
+
+} /* namespace dso::core */
+
+#endif
@@ -0,0 +1,157 @@
+/** @file
+ *
+ * Definitions of (non-template) member functions of the classes declared in
+ * date_integral_types.hpp.
+ *
+ * By default, these are compiled in the library (see
+ * src/lib/date_integral_types.cpp). If DATETIME_HEADER_ONLY is defined, this
+ * file is included at the end of date_integral_types.hpp instead, and the
+ * functions are inline (constexpr where possible), so that calls can be
+ * inlined without link-time optimization.
+ */
+
+#ifndef __DSO_DATE_INTEGRAL_TYPES_IMPL_HPP__
+#define __DSO_DATE_INTEGRAL_TYPES_IMPL_HPP__
+
+#include "date_integral_types.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+namespace dso {
+
+namespace core {
+/** @brief Lower-case version of an (ASCII) character. */
+constexpr char ascii_tolower(char c) noexcept {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/** @brief Case-insensitive comparison of (ASCII) c-strings, i.e.
+ * strcasecmp(a, b) == 0.
+ */
+constexpr bool ascii_iequal(const char *a, const char *b) noexcept {
+  for (; *a && *b; ++a, ++b)
+    if (ascii_tolower(*a) != ascii_tolower(*b))
+      return false;
+  return *a == *b;
+}
+
+/** @brief Length of a c-string, i.e. std::strlen. */
+constexpr std::size_t cstr_length(const char *str) noexcept {
+  std::size_t len = 0;
+  while (str[len])
+    ++len;
+  return len;
+}
+} /* namespace core */
+
+DATETIME_CONSTEXPR month::month(const char *str) : m_month(0) {
+  if (core::cstr_length(str) == 3) {
+    for (int i = 0; i < SHORT_NAMES_LEN; i++) {
+      if (core::ascii_iequal(str, short_names[i])) {
+        m_month = i + 1;
+        break;
+      }
+    }
+  } else if (core::cstr_length(str) > 3) {
+    for (int i = 0; i < LONG_NAMES_LEN; ++i) {
+      if (core::ascii_iequal(str, long_names[i])) {
+        m_month = i + 1;
+        break;
+      }
+    }
+  }
+
+  if (!m_month) {
+    throw std::invalid_argument("Failed to set month from string \"" +
+                                std::string(str) + "\"");
+  }
+}
+
+DATETIME_CONSTEXPR const char *month::short_name() const {
+  if (!this->is_valid()) {
+    fprintf(stderr,
+            "[ERROR] Invalid month; cannot translate to str (traceback: %s)\n",
+            __func__);
+    throw std::runtime_error(
+        "[ERROR] Invalid month; cannot translate to str\n");
+  }
+  return short_names[m_month - 1];
+}
+
+DATETIME_CONSTEXPR const char *month::long_name() const {
+  if (!this->is_valid()) {
+    fprintf(stderr,
+            "[ERROR] Invalid month; cannot translate to str (traceback: %s)\n",
+            __func__);
+    throw std::runtime_error(
+        "[ERROR] Invalid month; cannot translate to str\n");
+  }
+  return long_names[m_month - 1];
+}
+
+DATETIME_CONSTEXPR ymd_date ydoy_date::to_ymd() const noexcept {
+  const int guess = __doy.as_underlying_type() * 0.032;
+  const int leap = yr().is_leap();
+  const int more =
+      ((dy().as_underlying_type() - core::month_day[leap][guess + 1]) > 0);
+  /* assign */
+  ymd_date yd;
+  yd.yr() = yr();
+  yd.mn() = month(guess + more + 1);
+  yd.dm() = day_of_month(dy().as_underlying_type() -
+                         core::month_day[leap][guess + more]);
+  return yd;
+}
+
+DATETIME_CONSTEXPR ymd_date::ymd_date(const ydoy_date &ydoy) {
+  if (!ydoy.is_valid()) {
+    throw std::invalid_argument(
+        "[ERROR] Tring to compute year/month/day from an invalid "
+        "year/day_of_year instance (traceback:" +
+        std::string(__func__) + ")\n");
+  }
+  const auto ymd = ydoy.to_ymd();
+  __year = ymd.yr();
+  __month = ymd.mn();
+  __dom = ymd.dm();
+}
+
+DATETIME_CONSTEXPR ydoy_date ymd_date::to_ydoy() const {
+  if (!is_valid()) {
+    throw std::invalid_argument(
+        "[ERROR] Trying to compute year/day_of_year from an invalid "
+        "year/month/day instance (traceback:" +
+        std::string(__func__) + ")\n");
+  }
+  const int leap = yr().is_leap();
+  const int md = mn().as_underlying_type() - 1;
+  return {yr(),
+          day_of_year(core::month_day[leap][md] + dm().as_underlying_type())};
+}
+
+DATETIME_CONSTEXPR ydoy_date modified_julian_day::to_ydoy() const noexcept {
+  /* avoid magic numbers */
+  constexpr const int DAYS_IN_YEAR = 365;
+
+  if (!core::is_constant_evaluated()) {
+    const CalendarTable *t = calendar_table::current();
+    if (t->contains(m_mjd)) {
+      const std::uint32_t r = t->record(m_mjd);
+      return {year(t->year(r)), day_of_year(CalendarTable::doy(r))};
+    }
+  }
+
+  const int days_fr_jan1_1901 = m_mjd - JAN11901;
+  const int num_four_yrs = days_fr_jan1_1901 / 1461;
+  const int years_so_far = 1901 + 4 * num_four_yrs;
+  const int days_left = days_fr_jan1_1901 - 1461 * num_four_yrs;
+  const int delta_yrs = days_left / DAYS_IN_YEAR - days_left / 1460;
+
+  return {year(years_so_far + delta_yrs),
+          day_of_year(days_left - DAYS_IN_YEAR * delta_yrs + 1)};
+}
+
+} /* namespace dso */
+
+#endif
@@ -14,9 +14,25 @@
 
 #include "cdatetime.hpp"
 #include <cmath>
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 
 namespace dso::core {
+/** @brief Check if the function call occurs within a constant-evaluated
+ * context (i.e. at compile-time).
+ *
+ * This is std::is_constant_evaluated for C++20; for C++17 we resort to the
+ * (equivalent) compiler built-in provided by gcc and clang.
+ */
+inline constexpr bool is_constant_evaluated() noexcept {
+#if __cplusplus >= 202002L
+  return std::is_constant_evaluated();
+#else
+  return __builtin_is_constant_evaluated();
+#endif
+}
+
 /** Number of days past at the end of non-leap and leap years. */
 constexpr const int month_day[2][13] = {
     {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
@@ -25,12 +41,131 @@ constexpr const int month_day[2][13] = {
 /** Month lengths in days */
 constexpr const int mtab[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
+/** @brief Check if year is leap.
+ *
+ * @param[in] iy The year to check (int).
+ * @return true if year is leap, false otherwise.
+ */
+inline constexpr bool is_leap(int iy) noexcept {
+  return !(iy % 4) && (iy % 100 || !(iy % 400));
+}
+
+/** @brief Calendar date to Modified Julian Day (SOFA algorithm).
+ *
+ * No validation of the input date is performed.
+ *
+ * @note The algorithm used is valid from -4800 March 1
+ * @see IAU SOFA iauCal2jd
+ */
+inline constexpr long ymd2mjd_sofa(int iy, int im, int id) noexcept {
+  const int my = (im - 14) / 12;
+  const long iypmy = static_cast<long>(iy + my);
+
+  return (1461L * (iypmy + 4800L)) / 4L +
+         (367L * static_cast<long>(im - 2 - 12 * my)) / 12L -
+         (3L * ((iypmy + 4900L) / 100L)) / 4L + static_cast<long>(id) -
+         2432076L;
+}
+
+/** @brief Modified Julian Day to calendar date (Fliegel & Van Flandern).
+ *
+ * @note The algorithm used is valid for MJD >= -2400001 (i.e. JD >= 0)
+ */
+inline constexpr void mjd2ymd_fvf(long mjd, int &iyear, int &imonth,
+                                  int &idom) noexcept {
+  long l = mjd + (68569L + 2400000L + 1);
+  long n = (4L * l) / 146097L;
+  l -= (146097L * n + 3L) / 4L;
+  long i = (4000L * (l + 1L)) / 1461001L;
+  l -= (1461L * i) / 4L - 31L;
+  long k = (80L * l) / 2447L;
+
+  idom = l - (2447L * k) / 80L;
+  l = k / 11L;
+  imonth = k + 2L - 12L * l;
+  iyear = 100L * (n - 49L) + i + l;
+}
+
+/** @brief Constants for the Euclidean affine calendar algorithms.
+ *
+ * The algorithms work on unsigned day counts, starting at 0000/03/01
+ * (so that February is the last month of the "computational" year). To
+ * cover negative MJDs, the day count is shifted by an integral number of
+ * 400-year cycles (EAF_CYCLES), enough to cover the whole range of a
+ * modified_julian_day (i.e. int).
+ */
+constexpr const std::uint64_t EAF_CYCLES = 14'700;
+/** MJD of 0000/03/01 is -678881, plus the 400-year cycles shift */
+constexpr const long EAF_MJD_SHIFT = 678'881L + 146'097L * EAF_CYCLES;
+/** Year shift corresponding to EAF_MJD_SHIFT */
+constexpr const long EAF_YEAR_SHIFT = 400L * EAF_CYCLES;
+
+/** @brief Calendar date to Modified Julian Day (Euclidean affine functions).
+ *
+ * No validation of the input date is performed.
+ *
+ * @note The algorithm is valid for years > -EAF_YEAR_SHIFT, i.e. for all
+ *       dates with an MJD representable as int.
+ * @see C. Neri and L. Schneider, "Euclidean affine functions and their
+ *      application to calendar algorithms", Softw Pract Exper. 2023;53(4)
+ */
+inline constexpr long ymd2mjd_eaf(int iy, int im, int id) noexcept {
+  /* map to computational calendar (year starting at March) */
+  const std::uint64_t j = (im <= 2);
+  const std::uint64_t y =
+      static_cast<std::uint64_t>(static_cast<long>(iy) + EAF_YEAR_SHIFT) - j;
+  const std::uint64_t m = j ? im + 12 : im;
+  const std::uint64_t d = id - 1;
+  /* days at the start of the year and of the month */
+  const std::uint64_t c = y / 100;
+  const std::uint64_t ystar = 1461 * y / 4 - c + c / 4;
+  const std::uint64_t mstar = (979 * m - 2919) / 32;
+  return static_cast<long>(ystar + mstar + d) - EAF_MJD_SHIFT;
+}
+
+/** @brief Modified Julian Day to calendar date (Euclidean affine
+ * functions).
+ *
+ * @note The algorithm is valid for MJDs in the range of int (i.e. the range
+ *       of a modified_julian_day).
+ * @see C. Neri and L. Schneider, "Euclidean affine functions and their
+ *      application to calendar algorithms", Softw Pract Exper. 2023;53(4)
+ */
+inline constexpr void mjd2ymd_eaf(long mjd, int &iyear, int &imonth,
+                                  int &idom) noexcept {
+  const std::uint64_t n = static_cast<std::uint64_t>(mjd + EAF_MJD_SHIFT);
+  /* century and day of century */
+  const std::uint64_t n1 = 4 * n + 3;
+  const std::uint64_t c = n1 / 146097;
+  const std::uint32_t nc = static_cast<std::uint32_t>(n1 % 146097) / 4;
+  /* year of century and day of year */
+  const std::uint32_t n2 = 4 * nc + 3;
+  const std::uint64_t p2 = std::uint64_t(2939745) * n2;
+  const std::uint32_t z = static_cast<std::uint32_t>(p2 >> 32);
+  const std::uint32_t ny = static_cast<std::uint32_t>(p2) / 2939745 / 4;
+  /* month and day of month */
+  const std::uint32_t n3 = 2141 * ny + 197913;
+  const std::uint32_t m = n3 >> 16;
+  const std::uint32_t d = (n3 & 0xFFFF) / 2141;
+  /* map back to the gregorian calendar */
+  const std::uint32_t j = (ny >= 306);
+  iyear = static_cast<int>(static_cast<long>(100 * c + z) - EAF_YEAR_SHIFT +
+                           static_cast<long>(j));
+  imonth = static_cast<int>(j ? m - 12 : m);
+  idom = static_cast<int>(d + 1);
+}
+
 /** @brief Calendar date to Modified Julian Day.
  *
  * Given a calendar date (i.e. year, month and day of month), compute the
  * corresponding Modified Julian Day. The input date is checked and an
  * exception is thrown if it is invalid.
  *
+ * The conversion is performed via the SOFA algorithm (ymd2mjd_sofa), or,
+ * if DATETIME_EAF_CALENDAR is defined, via the Euclidean affine algorithm
+ * (ymd2mjd_eaf). Results are identical within the range of validity of the
+ * SOFA algorithm.
+ *
  * @param[in] iy The year (int).
  * @param[in] im The month (int).
  * @param[in] id The day of month (int).
@@ -47,7 +182,7 @@ constexpr long cal2mjd(int iy, int im, int id) {
   }
 
   /* If February in a leap year, 1, otherwise 0 */
-  int ly = ((im == 2) && !(iy % 4) && (iy % 100 || !(iy % 400)));
+  int ly = ((im == 2) && is_leap(iy));
 
   /* Validate day, taking into account leap years */
   if ((id < 1) || (id > (mtab[im - 1] + ly))) {
@@ -56,22 +191,11 @@ constexpr long cal2mjd(int iy, int im, int id) {
   }
 
   /* Compute mjd */
-  const int my = (im - 14) / 12;
-  const long iypmy = static_cast<long>(iy + my);
-
-  return (1461L * (iypmy + 4800L)) / 4L +
-         (367L * static_cast<long>(im - 2 - 12 * my)) / 12L -
-         (3L * ((iypmy + 4900L) / 100L)) / 4L + static_cast<long>(id) -
-         2432076L;
-}
-
-/** @brief Check if year is leap.
- *
- * @param[in] iy The year to check (int).
- * @return true if year is leap, false otherwise.
- */
-inline constexpr bool is_leap(int iy) noexcept {
-  return !(iy % 4) && (iy % 100 || !(iy % 400));
+#ifdef DATETIME_EAF_CALENDAR
+  return ymd2mjd_eaf(iy, im, id);
+#else
+  return ymd2mjd_sofa(iy, im, id);
+#endif
 }
 
 /** @brief Convert a pair of Year, Day of year to MJDay.
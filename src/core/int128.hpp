@@ -0,0 +1,66 @@
+/** @file
+ *
+ * 128-bit integer types (where available) and 64-bit multiply/divide
+ * helpers that do not overflow the (128-bit) product.
+ */
+
+#ifndef __DSO_DATETIME_CORE_INT128_HPP__
+#define __DSO_DATETIME_CORE_INT128_HPP__
+
+#include <cstdint>
+
+/* 128-bit integers are a GCC/Clang extension, only available on 64-bit
+ * targets; DATETIME_HAS_INT128 is defined if they are. */
+#if defined(__SIZEOF_INT128__)
+#define DATETIME_HAS_INT128
+#endif
+
+namespace dso::core {
+#ifdef DATETIME_HAS_INT128
+/** 128-bit signed integer; __extension__ silences -pedantic */
+__extension__ typedef __int128 int128_t;
+/** 128-bit unsigned integer */
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/** @brief Compute a * b = q * d + r, for 64-bit unsigned integers, without
+ * overflowing the (128-bit) product.
+ *
+ * The remainder \p r is always exact; the quotient \p q is only exact if
+ * it fits in 64 bits (otherwise, its low 64 bits are returned).
+ *
+ * @param[in] d The divisor; must be in range (0, 2^63)
+ */
+inline void mul_divmod(std::uint64_t a, std::uint64_t b, std::uint64_t d,
+                       std::uint64_t &q, std::uint64_t &r) noexcept {
+#ifdef DATETIME_HAS_INT128
+  const uint128_t p = static_cast<uint128_t>(a) * b;
+  q = static_cast<std::uint64_t>(p / d);
+  r = static_cast<std::uint64_t>(p % d);
+#else
+  /* 128-bit product as hi:lo, from 32-bit halves */
+  constexpr const std::uint64_t M = 0xffffffffULL;
+  const std::uint64_t ll = (a & M) * (b & M);
+  const std::uint64_t lh = (a & M) * (b >> 32);
+  const std::uint64_t hl = (a >> 32) * (b & M);
+  const std::uint64_t hh = (a >> 32) * (b >> 32);
+  const std::uint64_t mid = (ll >> 32) + (lh & M) + (hl & M);
+  const std::uint64_t lo = (mid << 32) | (ll & M);
+  const std::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  /* shift-subtract division; d < 2^63, so 2 * r + 1 never overflows */
+  q = 0;
+  r = 0;
+  for (int i = 127; i >= 0; i--) {
+    const std::uint64_t bit = (i >= 64) ? (hi >> (i - 64)) & 1 : (lo >> i) & 1;
+    r = (r << 1) | bit;
+    q <<= 1;
+    if (r >= d) {
+      r -= d;
+      q |= 1;
+    }
+  }
+#endif
+}
+} /* namespace dso::core */
+
+#endif
@@ -0,0 +1,76 @@
+/** @file
+ *
+ * Minimal fork-join helper, splitting an index range [0, n) into contiguous
+ * chunks processed by (at most) a given number of threads.
+ */
+
+#ifndef __DSO_DATETIME_CORE_PARALLEL_CHUNKS_HPP__
+#define __DSO_DATETIME_CORE_PARALLEL_CHUNKS_HPP__
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace dso::core {
+
+/** @brief Number of chunks that [0, n) is split to, using (at most)
+ * num_threads threads and chunks of (at least) grain elements; never zero.
+ */
+inline unsigned num_chunks(std::size_t n, unsigned num_threads,
+                           std::size_t grain = 1) noexcept {
+  const std::size_t max_chunks = (grain > 1) ? n / grain : n;
+  if (num_threads < 1)
+    num_threads = 1;
+  if (max_chunks < num_threads)
+    num_threads = (max_chunks > 0) ? static_cast<unsigned>(max_chunks) : 1;
+  return num_threads;
+}
+
+/** @brief First index of chunk t, when [0, n) is split to nchunks chunks.
+ *
+ * Chunks are contiguous and of (almost) equal size; chunk_begin(n, nchunks,
+ * nchunks) == n.
+ */
+inline std::size_t chunk_begin(std::size_t n, unsigned nchunks,
+                               unsigned t) noexcept {
+  const std::size_t q = n / nchunks;
+  const std::size_t r = n % nchunks;
+  return t * q + ((t < r) ? t : r);
+}
+
+/** @brief Call fn(t, begin, end) for every chunk t of [0, n), each on its
+ * own thread.
+ *
+ * The range is split to num_chunks(n, num_threads) chunks; chunk 0 is
+ * processed by the calling thread. Returns when all chunks are processed.
+ * fn should not throw.
+ *
+ * If a thread cannot be started (i.e. std::thread throws std::system_error),
+ * the threads already started are joined and the exception is re-thrown;
+ * in this case, (some of) the chunks may not have been processed.
+ */
+template <typename Fn>
+void parallel_chunks(std::size_t n, unsigned num_threads, Fn &&fn) {
+  /* joins all (started) threads on scope exit, including unwinding */
+  struct joiner {
+    std::vector<std::thread> pool;
+    ~joiner() {
+      for (auto &th : pool)
+        if (th.joinable())
+          th.join();
+    }
+  };
+  const unsigned p = num_chunks(n, num_threads);
+  joiner threads;
+  threads.pool.reserve(p - 1);
+  for (unsigned t = 1; t < p; t++) {
+    const std::size_t b = chunk_begin(n, p, t);
+    const std::size_t e = chunk_begin(n, p, t + 1);
+    threads.pool.emplace_back([&fn, t, b, e]() { fn(t, b, e); });
+  }
+  fn(0u, chunk_begin(n, p, 0), chunk_begin(n, p, 1));
+}
+
+} /* namespace dso::core */
+
+#endif
@@ -0,0 +1,83 @@
+#include "calendar_table.hpp"
+#include "date_integral_types.hpp"
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+/** Tables that have been installed via calendar_table::set_window. These
+ * are never freed, so that snapshots handed out by calendar_table::current()
+ * never dangle.
+ */
+std::vector<const dso::CalendarTable *> tables;
+/** Guards the above */
+std::mutex writer_mtx;
+} /* unnamed namespace */
+
+dso::CalendarTable::CalendarTable(int first_mjd, int last_mjd)
+    : m_records(nullptr), m_size(0), m_first_mjd(first_mjd),
+      m_first_year(0) {
+  if (last_mjd < first_mjd)
+    return;
+  if (static_cast<long>(last_mjd) - first_mjd + 1 > MAX_DAYS) {
+    fprintf(stderr,
+            "[ERROR] Calendar table window [%d, %d] exceeds max size of %d "
+            "days (traceback: %s)\n",
+            first_mjd, last_mjd, MAX_DAYS, __func__);
+    throw std::invalid_argument("[ERROR] Calendar table window too large\n");
+  }
+  m_storage.resize(last_mjd - first_mjd + 1);
+  fill(last_mjd, m_storage.data());
+}
+
+dso::CalendarTable::CalendarTable(int first_mjd, int last_mjd,
+                                  std::uint32_t *buf) noexcept
+    : m_records(nullptr), m_size(0), m_first_mjd(first_mjd),
+      m_first_year(0) {
+  fill(last_mjd, buf);
+}
+
+void dso::CalendarTable::fill(int last_mjd, std::uint32_t *buf) noexcept {
+  m_first_year = core::mjd2ymd(m_first_mjd).yr().as_underlying_type();
+  std::uint32_t *r = buf;
+  for (long mjd = m_first_mjd; mjd <= last_mjd; mjd++) {
+    const auto ymd = core::mjd2ymd(mjd);
+    const int iy = ymd.yr().as_underlying_type();
+    const int im = ymd.mn().as_underlying_type();
+    const int id = ymd.dm().as_underlying_type();
+    const int idoy = core::month_day[core::is_leap(iy)][im - 1] + id;
+    *r++ = (static_cast<std::uint32_t>(iy - m_first_year) << 18) |
+           (static_cast<std::uint32_t>(idoy) << 9) |
+           (static_cast<std::uint32_t>(im) << 5) |
+           static_cast<std::uint32_t>(id);
+  }
+  m_records = buf;
+  m_size = static_cast<std::uint32_t>(r - buf);
+}
+
+std::atomic<const dso::CalendarTable *>
+    dso::calendar_table::detail::installed{nullptr};
+
+const dso::CalendarTable *
+dso::calendar_table::detail::install_default() noexcept {
+  static std::uint32_t
+      default_records[DEFAULT_LAST_MJD - DEFAULT_FIRST_MJD + 1];
+  static const CalendarTable default_table(DEFAULT_FIRST_MJD,
+                                           DEFAULT_LAST_MJD, default_records);
+  const CalendarTable *expected = nullptr;
+  /* on failure, expected holds the table installed meanwhile */
+  if (installed.compare_exchange_strong(expected, &default_table,
+                                        std::memory_order_acq_rel))
+    return &default_table;
+  return expected;
+}
+
+const dso::CalendarTable *dso::calendar_table::set_window(int first_mjd,
+                                                          int last_mjd) {
+  /* build first, so that the current table is untouched on failure */
+  auto *table = new CalendarTable(first_mjd, last_mjd);
+  std::lock_guard<std::mutex> lock(writer_mtx);
+  tables.push_back(table);
+  detail::installed.store(table, std::memory_order_release);
+  return table;
+}
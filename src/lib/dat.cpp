@@ -1,108 +1,91 @@
 #include "date_integral_types.hpp"
-#include <algorithm>
-#include <array>
-#include <cassert>
-#include <cstdio>
+#include "leap_seconds.hpp"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace {
-/** just so we do not have magic numbers */
-constexpr const int MONTHS_IN_YEAR = 12;
-} /* unnamed namespace */
-
-namespace calendar_dat {
-/** Dates and Delta(AT)s */
-struct change {
-  int iyear, month, delat;
-  /** Combine year and month to form a date-ordered integer */
-  [[nodiscard]] int ordered_int() const noexcept {
-    return MONTHS_IN_YEAR * iyear + month;
+/** @brief Scalar (branchless) compare-and-count for elements [i, n) */
+template <bool WithExtra>
+void dat_batch_scalar(const dso::LeapSecondTable &s, const int *mjd,
+                      int *out, int *extra, std::size_t i,
+                      std::size_t n) noexcept {
+  const int base = s.changes().front().delat;
+  const int *__restrict__ thr = s.step_mjd().data();
+  const int *__restrict__ step = s.step_dat().data();
+  const std::size_t nthr = s.step_mjd().size();
+  for (; i < n; i++) {
+    int d = base, e = 0;
+    for (std::size_t j = 0; j < nthr; j++) {
+      d += (mjd[i] > thr[j]) * step[j];
+      if constexpr (WithExtra)
+        e += (mjd[i] == thr[j]) * step[j];
+    }
+    out[i] = d;
+    if constexpr (WithExtra)
+      extra[i] = e;
   }
-};
-constexpr const std::array<change, 28> changes = {
-    {{1972, 1, 10}, {1972, 7, 11}, {1973, 1, 12}, {1974, 1, 13}, {1975, 1, 14},
-     {1976, 1, 15}, {1977, 1, 16}, {1978, 1, 17}, {1979, 1, 18}, {1980, 1, 19},
-     {1981, 7, 20}, {1982, 7, 21}, {1983, 7, 22}, {1985, 7, 23}, {1988, 1, 24},
-     {1990, 1, 25}, {1991, 1, 26}, {1992, 7, 27}, {1993, 7, 28}, {1994, 7, 29},
-     {1996, 1, 30}, {1997, 7, 31}, {1999, 1, 32}, {2006, 1, 33}, {2009, 1, 34},
-     {2012, 7, 35}, {2015, 7, 36}, {2017, 1, 37}}};
-static_assert(changes.size() == dso::TOTAL_LEAP_SEC_INSERTION_DATES,
-              "Invalid number of leap second insertion days!");
-} /* namespace calendar_dat */
-
-namespace mjd_dat {
-/** Dates and Delta(AT)s */
-struct change {
-  int mjd, delat;
-};
-/** @brief MJDs where the leap seconds have changed. */
-constexpr const std::array<change, 28> changes = {
-    {{41317L, 10}, {41499L, 11}, {41683L, 12}, {42048L, 13}, {42413L, 14},
-     {42778L, 15}, {43144L, 16}, {43509L, 17}, {43874L, 18}, {44239L, 19},
-     {44786L, 20}, {45151L, 21}, {45516L, 22}, {46247L, 23}, {47161L, 24},
-     {47892L, 25}, {48257L, 26}, {48804L, 27}, {49169L, 28}, {49534L, 29},
-     {50083L, 30}, {50630L, 31}, {51179L, 32}, {53736L, 33}, {54832L, 34},
-     {56109L, 35}, {57204L, 36}, {57754L, 37}}};
-static_assert(changes.size() == dso::TOTAL_LEAP_SEC_INSERTION_DATES,
-              "Invalid number of leap second insertion days!");
-} /* namespace mjd_dat */
-
-int dso::dat(const dso::ymd_date &ymd) noexcept {
-  return dso::dat(ymd.yr(), ymd.mn());
 }
 
-int dso::dat(dso::year iy, dso::month im) noexcept {
-  assert(iy >= dso::year(1972));
-
-  /* Combine year and month to form a date-ordered integer... */
-  int m = MONTHS_IN_YEAR * iy.as_underlying_type() + im.as_underlying_type();
-
-  /* ...and use it to find the preceding table entry. */
-  auto it = std::find_if(
-      calendar_dat::changes.rbegin(), calendar_dat::changes.rend(),
-      [&](const calendar_dat::change &c) { return m >= c.ordered_int(); });
+template <bool WithExtra>
+void dat_batch_impl(const int *mjd, int *out, int *extra,
+                    std::size_t n) noexcept {
+  /* the table is immutable and never freed; no allocation here */
+  const dso::LeapSecondTable &s = *dso::leap_seconds::current();
+  [[maybe_unused]] const int *thr = s.step_mjd().data();
+  [[maybe_unused]] const int *step = s.step_dat().data();
+  [[maybe_unused]] const std::size_t nthr = s.step_mjd().size();
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  const __m256i base = _mm256_set1_epi32(s.changes().front().delat);
+  for (; i + 8 <= n; i += 8) {
+    const __m256i m =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mjd + i));
+    __m256i d = base;
+    [[maybe_unused]] __m256i e = _mm256_setzero_si256();
+    for (std::size_t j = 0; j < nthr; j++) {
+      const __m256i t = _mm256_set1_epi32(thr[j]);
+      const __m256i st = _mm256_set1_epi32(step[j]);
+      d = _mm256_add_epi32(d, _mm256_and_si256(_mm256_cmpgt_epi32(m, t), st));
+      if constexpr (WithExtra)
+        e = _mm256_add_epi32(e,
+                             _mm256_and_si256(_mm256_cmpeq_epi32(m, t), st));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), d);
+    if constexpr (WithExtra)
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(extra + i), e);
+  }
+#elif defined(__SSE2__)
+  const __m128i base = _mm_set1_epi32(s.changes().front().delat);
+  for (; i + 4 <= n; i += 4) {
+    const __m128i m =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(mjd + i));
+    __m128i d = base;
+    [[maybe_unused]] __m128i e = _mm_setzero_si128();
+    for (std::size_t j = 0; j < nthr; j++) {
+      const __m128i t = _mm_set1_epi32(thr[j]);
+      const __m128i st = _mm_set1_epi32(step[j]);
+      d = _mm_add_epi32(d, _mm_and_si128(_mm_cmpgt_epi32(m, t), st));
+      if constexpr (WithExtra)
+        e = _mm_add_epi32(e, _mm_and_si128(_mm_cmpeq_epi32(m, t), st));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), d);
+    if constexpr (WithExtra)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(extra + i), e);
+  }
+#endif
 
-  /* Get the Delta(AT). */
-  return it == (calendar_dat::changes.rend())
-             ? (calendar_dat::changes.begin()->delat)
-             : (it->delat);
+  /* remaining elements (or all, if no SIMD available) */
+  dat_batch_scalar<WithExtra>(s, mjd, out, extra, i, n);
 }
+} /* unnamed namespace */
 
-int dso::dat(dso::modified_julian_day mjd) noexcept {
-
-  /* find the preceding table entry. */
-  auto it = std::find_if(mjd_dat::changes.rbegin(), mjd_dat::changes.rend(),
-                         [&](const mjd_dat::change &c) {
-                           return mjd >= dso::modified_julian_day(c.mjd);
-                         });
-
-  /* Get the Delta(AT). */
-  return it == (mjd_dat::changes.rend()) ? (mjd_dat::changes.begin()->delat)
-                                         : (it->delat);
+void dso::dat_batch(const int *mjd, int *out, std::size_t n) noexcept {
+  dat_batch_impl<false>(mjd, out, nullptr, n);
 }
 
-int dso::dat(dso::modified_julian_day mjd, int &extra_sec_in_day) noexcept {
-  assert(mjd >= modified_julian_day(41317));
-  extra_sec_in_day = 0;
-
-  /* find the preceding table entry. */
-  auto it = std::find_if(mjd_dat::changes.rbegin(), mjd_dat::changes.rend(),
-                         [&](const mjd_dat::change &c) {
-                           return mjd >= dso::modified_julian_day(c.mjd);
-                         });
-
-  /* extra seconds in day */
-  extra_sec_in_day = 0;
-
-  /* check to see if given MJD is a leap-second day (i.e. has more seconds) */
-  if (it != mjd_dat::changes.rend() && it != mjd_dat::changes.rbegin()) {
-    /* given MJD is on a leap-insertion date (i.e. day prior to next leap) */
-    if (mjd == dso::modified_julian_day((it - 1)->mjd - 1)) {
-      /* DAT at next period */
-      int next_leap = (it - 1)->delat;
-      extra_sec_in_day = next_leap - it->delat;
-    }
-  }
-
-  /* Get the Delta(AT). */
-  return it->delat;
+void dso::dat_batch(const int *mjd, int *out, int *extra,
+                    std::size_t n) noexcept {
+  dat_batch_impl<true>(mjd, out, extra, n);
 }
@@ -0,0 +1,444 @@
+#include "date_batch.hpp"
+#include "date_integral_types.hpp"
+#include <algorithm>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#if defined(__AVX512F__)
+/** Vectorized primitives on 16 32-bit integer lanes (AVX-512). Note that we
+ * use the zero-masking versions of shifts and multiplications (with all
+ * lanes selected), since the non-masked ones trigger (false)
+ * maybe-uninitialized warnings on some compilers.
+ */
+struct simd {
+  using V = __m512i;
+  static constexpr std::size_t width = 16;
+  static constexpr __mmask16 all32 = 0xFFFF;
+  static constexpr __mmask8 all64 = 0xFF;
+  static V load(const int *p) noexcept { return _mm512_loadu_si512(p); }
+  static void store(int *p, V a) noexcept { _mm512_storeu_si512(p, a); }
+  static V set1(int a) noexcept { return _mm512_set1_epi32(a); }
+  static V add(V a, V b) noexcept { return _mm512_add_epi32(a, b); }
+  static V sub(V a, V b) noexcept { return _mm512_sub_epi32(a, b); }
+  static V mullo(V a, int b) noexcept {
+    return _mm512_mullo_epi32(a, _mm512_set1_epi32(b));
+  }
+  template <int S> static V slli(V a) noexcept {
+    return _mm512_maskz_slli_epi32(all32, a, S);
+  }
+  template <int S> static V srli(V a) noexcept {
+    return _mm512_maskz_srli_epi32(all32, a, S);
+  }
+  /** true if all lanes are in the range [lo, hi] */
+  static bool in_range(V a, int lo, int hi) noexcept {
+    return (_mm512_cmpge_epi32_mask(a, set1(lo)) &
+            _mm512_cmple_epi32_mask(a, set1(hi))) == all32;
+  }
+  /** (unsigned) floor(a * M / 2^K), with K >= 32 */
+  template <unsigned M, int K> static V mulshift(V a) noexcept {
+    static_assert(K >= 32 && K < 64);
+    const V m = _mm512_set1_epi32(static_cast<int>(M));
+    const V even = _mm512_maskz_srli_epi64(
+        all64, _mm512_maskz_mul_epu32(all64, a, m), K);
+    const V ahi = _mm512_maskz_srli_epi64(all64, a, 32);
+    const V odd = _mm512_maskz_slli_epi64(
+        all64,
+        _mm512_maskz_srli_epi64(all64, _mm512_maskz_mul_epu32(all64, ahi, m),
+                                K),
+        32);
+    return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+  }
+  /* lane-wise predicates, as bitmasks */
+  using M = __mmask16;
+  static M between(V a, V lo, V hi) noexcept {
+    return _mm512_cmpge_epi32_mask(a, lo) & _mm512_cmple_epi32_mask(a, hi);
+  }
+  static M between(V a, int lo, int hi) noexcept {
+    return between(a, set1(lo), set1(hi));
+  }
+  static M eq(V a, int b) noexcept {
+    return _mm512_cmpeq_epi32_mask(a, set1(b));
+  }
+  static M mand(M a, M b) noexcept { return a & b; }
+  /** (not a) and b */
+  static M mandnot(M a, M b) noexcept { return static_cast<M>(~a & b); }
+  static unsigned bits(M a) noexcept { return a; }
+  static V band(V a, int b) noexcept { return _mm512_and_si512(a, set1(b)); }
+  /** select b where the mask is set, a otherwise */
+  static V blend(M m, V a, V b) noexcept {
+    return _mm512_mask_blend_epi32(m, a, b);
+  }
+  static V zero_unless(M m, V a) noexcept {
+    return _mm512_maskz_mov_epi32(m, a);
+  }
+}; /* simd */
+#elif defined(__AVX2__)
+/** Vectorized primitives on 8 32-bit integer lanes (AVX2) */
+struct simd {
+  using V = __m256i;
+  static constexpr std::size_t width = 8;
+  static V load(const int *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(int *p, V a) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a);
+  }
+  static V set1(int a) noexcept { return _mm256_set1_epi32(a); }
+  static V add(V a, V b) noexcept { return _mm256_add_epi32(a, b); }
+  static V sub(V a, V b) noexcept { return _mm256_sub_epi32(a, b); }
+  static V mullo(V a, int b) noexcept {
+    return _mm256_mullo_epi32(a, _mm256_set1_epi32(b));
+  }
+  template <int S> static V slli(V a) noexcept {
+    return _mm256_slli_epi32(a, S);
+  }
+  template <int S> static V srli(V a) noexcept {
+    return _mm256_srli_epi32(a, S);
+  }
+  /** true if all lanes are in the range [lo, hi] */
+  static bool in_range(V a, int lo, int hi) noexcept {
+    const V ok = _mm256_and_si256(_mm256_cmpgt_epi32(a, set1(lo - 1)),
+                                  _mm256_cmpgt_epi32(set1(hi + 1), a));
+    return _mm256_movemask_epi8(ok) == -1;
+  }
+  /** (unsigned) floor(a * M / 2^K), with K >= 32 */
+  template <unsigned M, int K> static V mulshift(V a) noexcept {
+    static_assert(K >= 32 && K < 64);
+    const V m = _mm256_set1_epi32(static_cast<int>(M));
+    const V even = _mm256_srli_epi64(_mm256_mul_epu32(a, m), K);
+    const V odd = _mm256_slli_epi64(
+        _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), m), K),
+        32);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+  }
+  /* lane-wise predicates, as vectors with all bits set/cleared */
+  using M = __m256i;
+  static M between(V a, V lo, V hi) noexcept {
+    return _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpgt_epi32(lo, a),
+                                               _mm256_cmpgt_epi32(a, hi)),
+                               _mm256_set1_epi32(-1));
+  }
+  static M between(V a, int lo, int hi) noexcept {
+    return between(a, set1(lo), set1(hi));
+  }
+  static M eq(V a, int b) noexcept { return _mm256_cmpeq_epi32(a, set1(b)); }
+  static M mand(M a, M b) noexcept { return _mm256_and_si256(a, b); }
+  /** (not a) and b */
+  static M mandnot(M a, M b) noexcept { return _mm256_andnot_si256(a, b); }
+  static unsigned bits(M a) noexcept {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(a));
+  }
+  static V band(V a, int b) noexcept { return _mm256_and_si256(a, set1(b)); }
+  /** select b where the mask is set, a otherwise */
+  static V blend(M m, V a, V b) noexcept {
+    return _mm256_blendv_epi8(a, b, m);
+  }
+  static V zero_unless(M m, V a) noexcept { return _mm256_and_si256(m, a); }
+}; /* simd */
+#endif
+
+/** @brief Scalar transformation of elements [i, n) */
+void mjd2ymd_scalar(const int *mjd, int *iyear, int *imon, int *idom,
+                    std::size_t i, std::size_t n) noexcept {
+  for (; i < n; i++) {
+    const auto ymd = dso::core::mjd2ymd(mjd[i]);
+    iyear[i] = ymd.yr().as_underlying_type();
+    imon[i] = ymd.mn().as_underlying_type();
+    idom[i] = ymd.dm().as_underlying_type();
+  }
+}
+
+/** @brief Scalar transformation of elements [i, n) */
+void mjd2ydoy_scalar(const int *mjd, int *iyear, int *idoy, std::size_t i,
+                     std::size_t n) noexcept {
+  for (; i < n; i++) {
+    const auto ydoy = dso::modified_julian_day(mjd[i]).to_ydoy();
+    iyear[i] = ydoy.yr().as_underlying_type();
+    idoy[i] = ydoy.dy().as_underlying_type();
+  }
+}
+
+/** Shift of years (12 400-year cycles) used in the batch calendar to MJD
+ * conversions, so that all years in [BATCH_CAL_YEAR_MIN, BATCH_CAL_YEAR_MAX]
+ * are mapped to non-negative values.
+ */
+constexpr const int YEAR_SHIFT = 4800;
+/** MJD of 0000/03/01 is -678881, plus the YEAR_SHIFT in days */
+constexpr const int MJD_SHIFT = 678'881 + 146'097 * (YEAR_SHIFT / 400);
+
+/** @brief Check (without throwing) if a calendar date is valid. */
+bool ymd_valid(int iy, int im, int id) noexcept {
+  return (iy >= dso::BATCH_CAL_YEAR_MIN && iy <= dso::BATCH_CAL_YEAR_MAX) &&
+         (im >= 1 && im <= 12) &&
+         (id >= 1 &&
+          id <= dso::core::mtab[im - 1] + (im == 2 && dso::core::is_leap(iy)));
+}
+
+/** @brief Check (without throwing) if a year/day of year date is valid. */
+bool ydoy_valid(int iy, int idoy) noexcept {
+  return (iy >= dso::BATCH_CAL_YEAR_MIN && iy <= dso::BATCH_CAL_YEAR_MAX) &&
+         (idoy >= 1 && idoy <= 365 + dso::core::is_leap(iy));
+}
+
+/** @brief Scalar validation/transformation of elements [i, n); returns the
+ * number of invalid dates.
+ */
+std::size_t ymd2mjd_scalar(const int *iyear, const int *imon, const int *idom,
+                           int *mjd, std::uint64_t *valid, std::size_t i,
+                           std::size_t n) noexcept {
+  std::size_t invalid = 0;
+  for (; i < n; i++) {
+    const bool ok = ymd_valid(iyear[i], imon[i], idom[i]);
+    mjd[i] = ok ? static_cast<int>(
+                      dso::core::ymd2mjd_sofa(iyear[i], imon[i], idom[i]))
+                : 0;
+    valid[i / 64] |= static_cast<std::uint64_t>(ok) << (i % 64);
+    invalid += !ok;
+  }
+  return invalid;
+}
+
+/** @brief Scalar validation/transformation of elements [i, n); returns the
+ * number of invalid dates.
+ */
+std::size_t ydoy2mjd_scalar(const int *iyear, const int *idoy, int *mjd,
+                            std::uint64_t *valid, std::size_t i,
+                            std::size_t n) noexcept {
+  std::size_t invalid = 0;
+  for (; i < n; i++) {
+    const bool ok = ydoy_valid(iyear[i], idoy[i]);
+    mjd[i] =
+        ok ? static_cast<int>(dso::core::ymd2mjd_sofa(iyear[i], 1, 1)) +
+                 idoy[i] - 1
+           : 0;
+    valid[i / 64] |= static_cast<std::uint64_t>(ok) << (i % 64);
+    invalid += !ok;
+  }
+  return invalid;
+}
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+/** @brief Leap year flags, for (shifted, non-negative) years. */
+simd::M leap_years(simd::V yy) noexcept {
+  /* yy / 100 */
+  const simd::V c = simd::mulshift<42949673u, 32>(yy);
+  const simd::M century = simd::eq(simd::sub(yy, simd::mullo(c, 100)), 0);
+  /* century years are leap only if divisible by 400 */
+  const simd::M century_non_leap =
+      simd::mandnot(simd::eq(simd::band(c, 3), 0), century);
+  return simd::mandnot(century_non_leap, simd::eq(simd::band(yy, 3), 0));
+}
+
+/** @brief Days from (shifted) 0000/03/01 to the start of the (shifted,
+ * non-negative) computational year y, i.e. 365y + y/4 - y/100 + y/400.
+ */
+simd::V year_days(simd::V y) noexcept {
+  const simd::V c = simd::mulshift<42949673u, 32>(y);
+  return simd::add(simd::sub(simd::add(simd::mullo(y, 365), simd::srli<2>(y)),
+                             c),
+                   simd::srli<2>(c));
+}
+
+/** @brief Vectorized validation and transformation of calendar dates to
+ * MJDs (Euclidean affine functions, all in 32-bit integer arithmetic).
+ */
+std::size_t ymd2mjd_simd(const int *iyear, const int *imon, const int *idom,
+                         int *mjd, std::uint64_t *valid, std::size_t n,
+                         std::size_t &invalid) noexcept {
+  using V = simd::V;
+  std::size_t i = 0;
+  for (; i + simd::width <= n; i += simd::width) {
+    const V y = simd::load(iyear + i);
+    const V m = simd::load(imon + i);
+    const V d = simd::load(idom + i);
+    const V yy = simd::add(y, simd::set1(YEAR_SHIFT));
+    /* days in month: 30 + ((m + m/8) & 1), or 28/29 for February */
+    const V mlen = simd::blend(
+        simd::eq(m, 2),
+        simd::add(simd::set1(30), simd::band(simd::add(m, simd::srli<3>(m)), 1)),
+        simd::blend(leap_years(yy), simd::set1(28), simd::set1(29)));
+    const simd::M ok = simd::mand(
+        simd::mand(
+            simd::between(y, dso::BATCH_CAL_YEAR_MIN, dso::BATCH_CAL_YEAR_MAX),
+            simd::between(m, 1, 12)),
+        simd::between(d, simd::set1(1), mlen));
+    /* map to computational calendar (year starting at March) */
+    const V j = simd::zero_unless(simd::between(m, 1, 2), simd::set1(1));
+    const V ys = simd::sub(yy, j);
+    const V ms = simd::add(m, simd::mullo(j, 12));
+    /* days at the start of year and month, plus day of month */
+    const V days = simd::add(
+        simd::add(year_days(ys),
+                  simd::srli<5>(simd::sub(simd::mullo(ms, 979),
+                                          simd::set1(2919)))),
+        d);
+    simd::store(mjd + i,
+                simd::zero_unless(
+                    ok, simd::sub(days, simd::set1(MJD_SHIFT + 1))));
+    const unsigned b = simd::bits(ok);
+    valid[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64);
+    invalid += simd::width - __builtin_popcount(b);
+  }
+  return i;
+}
+
+/** @brief Vectorized validation and transformation of year/day of year
+ * dates to MJDs.
+ */
+std::size_t ydoy2mjd_simd(const int *iyear, const int *idoy, int *mjd,
+                          std::uint64_t *valid, std::size_t n,
+                          std::size_t &invalid) noexcept {
+  using V = simd::V;
+  std::size_t i = 0;
+  for (; i + simd::width <= n; i += simd::width) {
+    const V y = simd::load(iyear + i);
+    const V d = simd::load(idoy + i);
+    const V yy = simd::add(y, simd::set1(YEAR_SHIFT));
+    const V ylen =
+        simd::blend(leap_years(yy), simd::set1(365), simd::set1(366));
+    const simd::M ok = simd::mand(
+        simd::between(y, dso::BATCH_CAL_YEAR_MIN, dso::BATCH_CAL_YEAR_MAX),
+        simd::between(d, simd::set1(1), ylen));
+    /* January 1st is day 306 of the previous computational year */
+    const V days = simd::add(year_days(simd::sub(yy, simd::set1(1))), d);
+    simd::store(mjd + i,
+                simd::zero_unless(
+                    ok, simd::sub(days, simd::set1(MJD_SHIFT + 1 - 306))));
+    const unsigned b = simd::bits(ok);
+    valid[i / 64] |= static_cast<std::uint64_t>(b) << (i % 64);
+    invalid += simd::width - __builtin_popcount(b);
+  }
+  return i;
+}
+
+/** @brief Vectorized version of core::mjd2ymd (Fliegel & Van Flandern).
+ *
+ * All divisions by constants are performed via multiply-shift; the
+ * multipliers/shifts are exact for the intermediate values occuring for MJDs
+ * in [BATCH_MJD2YMD_MIN, BATCH_MJD2YMD_MAX] (where all intermediate values
+ * are non-negative, hence truncating and floor division agree).
+ */
+std::size_t mjd2ymd_simd(const int *mjd, int *iyear, int *imon, int *idom,
+                         std::size_t n) noexcept {
+  using V = simd::V;
+  std::size_t i = 0;
+  for (; i + simd::width <= n; i += simd::width) {
+    const V x = simd::load(mjd + i);
+    if (!simd::in_range(x, dso::BATCH_MJD2YMD_MIN, dso::BATCH_MJD2YMD_MAX)) {
+      mjd2ymd_scalar(mjd, iyear, imon, idom, i, i + simd::width);
+      continue;
+    }
+    /* l = mjd + 68569 + 2400001; n = 4l / 146097 */
+    V l = simd::add(x, simd::set1(68569 + 2400000 + 1));
+    const V nc = simd::mulshift<963315389u, 47>(simd::slli<2>(l));
+    /* l -= (146097n + 3) / 4 */
+    l = simd::sub(
+        l, simd::srli<2>(simd::add(simd::mullo(nc, 146097), simd::set1(3))));
+    /* i = 4000(l + 1) / 1461001 */
+    const V ic = simd::mulshift<96329495u, 47>(
+        simd::mullo(simd::add(l, simd::set1(1)), 4000));
+    /* l -= 1461i / 4 - 31 */
+    l = simd::sub(l, simd::sub(simd::srli<2>(simd::mullo(ic, 1461)),
+                               simd::set1(31)));
+    /* k = 80l / 2447 */
+    const V k = simd::mulshift<1755198u, 32>(simd::mullo(l, 80));
+    /* dom = l - 2447k / 80 */
+    const V dom =
+        simd::sub(l, simd::mulshift<53687092u, 32>(simd::mullo(k, 2447)));
+    /* l = k / 11 */
+    l = simd::mulshift<390451573u, 32>(k);
+    /* month = k + 2 - 12l; year = 100(n - 49) + i + l */
+    const V mon = simd::sub(simd::add(k, simd::set1(2)), simd::mullo(l, 12));
+    const V yr = simd::add(
+        simd::add(simd::mullo(simd::sub(nc, simd::set1(49)), 100), ic), l);
+    simd::store(iyear + i, yr);
+    simd::store(imon + i, mon);
+    simd::store(idom + i, dom);
+  }
+  return i;
+}
+
+/** @brief Vectorized version of modified_julian_day::to_ydoy (Remondi).
+ *
+ * Multiply-shift sequences are exact for MJDs in [BATCH_MJD2YDOY_MIN,
+ * BATCH_MJD2YDOY_MAX].
+ */
+std::size_t mjd2ydoy_simd(const int *mjd, int *iyear, int *idoy,
+                          std::size_t n) noexcept {
+  using V = simd::V;
+  std::size_t i = 0;
+  for (; i + simd::width <= n; i += simd::width) {
+    const V x = simd::load(mjd + i);
+    if (!simd::in_range(x, dso::BATCH_MJD2YDOY_MIN,
+                        dso::BATCH_MJD2YDOY_MAX)) {
+      mjd2ydoy_scalar(mjd, iyear, idoy, i, i + simd::width);
+      continue;
+    }
+    /* days from 1901/01/01 and number of four-year periods */
+    const V days = simd::sub(x, simd::set1(dso::JAN11901));
+    const V num_four_yrs = simd::mulshift<376287347u, 39>(days);
+    const V days_left = simd::sub(days, simd::mullo(num_four_yrs, 1461));
+    /* delta_yrs = days_left / 365 - days_left / 1460 */
+    const V delta_yrs = simd::sub(simd::mulshift<11767034u, 32>(days_left),
+                                  simd::mulshift<2941759u, 32>(days_left));
+    const V yr =
+        simd::add(simd::add(simd::set1(1901), simd::slli<2>(num_four_yrs)),
+                  delta_yrs);
+    const V doy = simd::add(
+        simd::sub(days_left, simd::mullo(delta_yrs, 365)), simd::set1(1));
+    simd::store(iyear + i, yr);
+    simd::store(idoy + i, doy);
+  }
+  return i;
+}
+#endif
+
+} /* unnamed namespace */
+
+void dso::mjd2ymd_batch(const int *mjd, int *iyear, int *imon, int *idom,
+                        std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__AVX512F__) || defined(__AVX2__)
+  i = mjd2ymd_simd(mjd, iyear, imon, idom, n);
+#endif
+  /* remaining elements (or all, if no SIMD available) */
+  mjd2ymd_scalar(mjd, iyear, imon, idom, i, n);
+}
+
+void dso::mjd2ydoy_batch(const int *mjd, int *iyear, int *idoy,
+                         std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__AVX512F__) || defined(__AVX2__)
+  i = mjd2ydoy_simd(mjd, iyear, idoy, n);
+#endif
+  /* remaining elements (or all, if no SIMD available) */
+  mjd2ydoy_scalar(mjd, iyear, idoy, i, n);
+}
+
+std::size_t dso::ymd_to_mjd_batch(const int *iyear, const int *imon,
+                                  const int *idom, int *mjd,
+                                  std::uint64_t *valid,
+                                  std::size_t n) noexcept {
+  std::fill(valid, valid + batch_mask_words(n), std::uint64_t(0));
+  std::size_t i = 0, invalid = 0;
+#if defined(__AVX512F__) || defined(__AVX2__)
+  i = ymd2mjd_simd(iyear, imon, idom, mjd, valid, n, invalid);
+#endif
+  /* remaining elements (or all, if no SIMD available) */
+  return invalid + ymd2mjd_scalar(iyear, imon, idom, mjd, valid, i, n);
+}
+
+std::size_t dso::ydoy_to_mjd_batch(const int *iyear, const int *idoy,
+                                   int *mjd, std::uint64_t *valid,
+                                   std::size_t n) noexcept {
+  std::fill(valid, valid + batch_mask_words(n), std::uint64_t(0));
+  std::size_t i = 0, invalid = 0;
+#if defined(__AVX512F__) || defined(__AVX2__)
+  i = ydoy2mjd_simd(iyear, idoy, mjd, valid, n, invalid);
+#endif
+  /* remaining elements (or all, if no SIMD available) */
+  return invalid + ydoy2mjd_scalar(iyear, idoy, mjd, valid, i, n);
+}
@@ -0,0 +1,4 @@
+/* In header-only mode, the definitions are already (inline) in the headers */
+#ifndef DATETIME_HEADER_ONLY
+#include "core/date_integral_types_impl.hpp"
+#endif
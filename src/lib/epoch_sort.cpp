@@ -0,0 +1,104 @@
+#include "epoch_sort.hpp"
+#include "core/parallel_chunks.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using dso::core::epoch_sort_item;
+
+/** Number of bits/buckets per radix pass; the histograms of 11-bit digits
+ * still fit in L1 cache, and 64-bit keys need (at most) 6 passes.
+ */
+constexpr const int RADIX_BITS = 11;
+constexpr const std::size_t RADIX = std::size_t(1) << RADIX_BITS;
+
+/** Key of a radix sort element */
+inline std::uint64_t key_of(std::uint64_t k) noexcept { return k; }
+inline std::uint64_t key_of(const epoch_sort_item &it) noexcept {
+  return it.key;
+}
+
+/** @brief One (stable) counting-sort pass, from src to dst, on the digit
+ * of the keys starting at bit shift.
+ *
+ * Each of the p chunks of the input counts its own digits; chunk t then
+ * scatters its items after the items of the same digit of chunks [0, t), so
+ * that the pass is stable.
+ *
+ * @return dst, or src if all items have the same digit (i.e. nothing was
+ *         moved)
+ */
+template <typename T>
+T *radix_pass(T *src, T *dst, std::size_t n, unsigned p,
+              std::vector<std::size_t> &hist, int shift) {
+  const auto digit = [shift](const T &x) noexcept {
+    return static_cast<std::size_t>((key_of(x) >> shift) & (RADIX - 1));
+  };
+  dso::core::parallel_chunks(
+      n, p, [&](unsigned t, std::size_t b, std::size_t e) {
+        std::size_t *h = hist.data() + t * RADIX;
+        std::fill(h, h + RADIX, 0);
+        for (std::size_t i = b; i < e; i++)
+          ++h[digit(src[i])];
+      });
+
+  /* skip the pass if all items have the same digit */
+  for (std::size_t d = 0; d < RADIX; d++) {
+    std::size_t count = 0;
+    for (unsigned t = 0; t < p; t++)
+      count += hist[t * RADIX + d];
+    if (count == n)
+      return src;
+    if (count)
+      break;
+  }
+
+  /* exclusive prefix sum, in (digit, chunk) order */
+  std::size_t sum = 0;
+  for (std::size_t d = 0; d < RADIX; d++) {
+    for (unsigned t = 0; t < p; t++) {
+      const std::size_t c = hist[t * RADIX + d];
+      hist[t * RADIX + d] = sum;
+      sum += c;
+    }
+  }
+
+  dso::core::parallel_chunks(
+      n, p, [&](unsigned t, std::size_t b, std::size_t e) {
+        std::size_t *h = hist.data() + t * RADIX;
+        for (std::size_t i = b; i < e; i++)
+          dst[h[digit(src[i])]++] = src[i];
+      });
+  return dst;
+}
+
+/** @brief LSD radix sort on the bits least significant bits of the keys */
+template <typename T>
+T *lsd_sort(T *items, T *buf, std::size_t n, int bits,
+            unsigned num_threads) {
+  const unsigned p = dso::core::num_chunks(n, num_threads);
+  std::vector<std::size_t> hist(p * RADIX);
+  T *src = items;
+  T *dst = buf;
+  for (int shift = 0; shift < bits; shift += RADIX_BITS) {
+    if (radix_pass(src, dst, n, p, hist, shift) == dst)
+      std::swap(src, dst);
+  }
+  return src;
+}
+
+} /* unnamed namespace */
+
+std::uint64_t *dso::core::radix_sort_keys(std::uint64_t *keys,
+                                          std::uint64_t *buf, std::size_t n,
+                                          int bits, unsigned num_threads) {
+  return lsd_sort(keys, buf, n, bits, num_threads);
+}
+
+dso::core::epoch_sort_item *
+dso::core::radix_sort_items(epoch_sort_item *items, epoch_sort_item *buf,
+                            std::size_t n, int bits, unsigned num_threads) {
+  return lsd_sort(items, buf, n, bits, num_threads);
+}
@@ -0,0 +1,344 @@
+#include "leap_seconds.hpp"
+#include "date_integral_types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace {
+/** just so we do not have magic numbers */
+constexpr const int MONTHS_IN_YEAR = 12;
+/** MJD of 1972/01/01; UTC uses integral offsets from TAI since then */
+constexpr const int JAN11972 = 41317;
+
+/** Tables that have been installed (current and superseded ones). These are
+ * never freed, so that snapshots handed out by leap_seconds::current() never
+ * dangle.
+ */
+std::vector<const dso::LeapSecondTable *> tables;
+/** Filename of the last file loaded via leap_seconds::load */
+std::string source_fn;
+/** Guards the above */
+std::mutex writer_mtx;
+
+/** @brief Parse an IERS Leap_Second.dat file.
+ *
+ * Header lines start with '#'; the expiry date is given in a line of type:
+ * "#  File expires on 28 June 2026". Data lines are of type:
+ * "    41317.0    1  1 1972       10" (i.e. MJD, day, month, year, ΔAT).
+ */
+int parse_iers(std::ifstream &fin,
+               std::vector<dso::LeapSecondTable::change> &changes) {
+  constexpr const char *expires = "File expires on";
+  int expiry_mjd = 0;
+  std::string line;
+  while (std::getline(fin, line)) {
+    const char *str = line.c_str();
+    if (line[0] == '#') {
+      if (const char *c = std::strstr(str, expires); c) {
+        int id, iy;
+        char mstr[16];
+        if (std::sscanf(c + std::strlen(expires), "%d %15s %d", &id, mstr,
+                        &iy) != 3)
+          return -1;
+        expiry_mjd = dso::core::cal2mjd(
+            iy, dso::month(mstr).as_underlying_type(), id);
+      }
+    } else {
+      double mjd;
+      int id, im, iy, delat;
+      const int nr =
+          std::sscanf(str, "%lf %d %d %d %d", &mjd, &id, &im, &iy, &delat);
+      if (nr == 5) {
+        if (mjd != std::floor(mjd) ||
+            dso::core::cal2mjd(iy, im, id) != static_cast<long>(mjd))
+          return -1;
+        changes.push_back({static_cast<int>(mjd), delat});
+      } else if (nr > 0) {
+        return -1;
+      }
+    }
+  }
+  return expiry_mjd;
+}
+
+/** @brief Parse a USNO tai-utc.dat file.
+ *
+ * Data lines are of type:
+ * " 1972 JAN  1 =JD 2441317.5  TAI-UTC=  10.0       S + (MJD - 41317.) X 0.0
+ * S". Only entries after 1972/01/01 with a zero rate are considered. Since no
+ * expiry date is given, we use the MJD of the last change.
+ */
+int parse_usno(std::ifstream &fin,
+               std::vector<dso::LeapSecondTable::change> &changes) {
+  std::string line;
+  while (std::getline(fin, line)) {
+    const char *jd = std::strstr(line.c_str(), "=JD");
+    const char *dat = std::strstr(line.c_str(), "TAI-UTC=");
+    const char *rate = std::strstr(line.c_str(), " X ");
+    if (!jd && !dat)
+      continue;
+    double fjd, fdat, frate;
+    if (!jd || !dat || !rate || std::sscanf(jd + 3, "%lf", &fjd) != 1 ||
+        std::sscanf(dat + 8, "%lf", &fdat) != 1 ||
+        std::sscanf(rate + 3, "%lf", &frate) != 1)
+      return -1;
+    const double fmjd = fjd - dso::MJD0_JD;
+    if (fmjd >= JAN11972 && frate == 0e0) {
+      if (fmjd != std::floor(fmjd) || fdat != std::floor(fdat))
+        return -1;
+      changes.push_back({static_cast<int>(fmjd), static_cast<int>(fdat)});
+    }
+  }
+  return changes.empty() ? -1 : changes.back().mjd;
+}
+} /* unnamed namespace */
+
+dso::LeapSecondTable::LeapSecondTable(std::vector<change> changes,
+                                      int expiry_mjd)
+    : m_changes(std::move(changes)), m_expiry_mjd(expiry_mjd) {
+  if (m_changes.empty()) {
+    fprintf(stderr, "[ERROR] Empty leap second table (traceback: %s)\n",
+            __func__);
+    throw std::invalid_argument("[ERROR] Empty leap second table\n");
+  }
+  m_months.reserve(m_changes.size());
+  for (auto it = m_changes.cbegin(); it != m_changes.cend(); ++it) {
+    const auto ymd = core::mjd2ymd(it->mjd);
+    if ((it != m_changes.cbegin() &&
+         (it->mjd <= (it - 1)->mjd || it->delat == (it - 1)->delat)) ||
+        ymd.dm() != day_of_month(1) ||
+        it->delat < std::numeric_limits<std::int8_t>::min() ||
+        it->delat > std::numeric_limits<std::int8_t>::max()) {
+      fprintf(stderr,
+              "[ERROR] Invalid leap second table entry at MJD %d; changes "
+              "must be ordered, change ΔAT and occur at the first day of a "
+              "month (traceback: %s)\n",
+              it->mjd, __func__);
+      throw std::invalid_argument("[ERROR] Invalid leap second table\n");
+    }
+    m_months.push_back(MONTHS_IN_YEAR * ymd.yr().as_underlying_type() +
+                       ymd.mn().as_underlying_type());
+  }
+
+  /* compare-and-count form, for batch lookups */
+  m_step_mjd.reserve(m_changes.size() - 1);
+  m_step_dat.reserve(m_changes.size() - 1);
+  for (auto it = m_changes.cbegin() + 1; it != m_changes.cend(); ++it) {
+    m_step_mjd.push_back(it->mjd - 1);
+    m_step_dat.push_back(it->delat - (it - 1)->delat);
+  }
+
+  /* dense tables span [first change, expiry] (at least up to last change) */
+  m_dense_mjd = m_changes.front().mjd;
+  m_dense_month = m_months.front();
+  const int last_mjd = std::max(m_expiry_mjd, m_changes.back().mjd);
+  const auto last_ymd = core::mjd2ymd(last_mjd);
+  const int last_month = MONTHS_IN_YEAR * last_ymd.yr().as_underlying_type() +
+                         last_ymd.mn().as_underlying_type();
+
+  m_dense.reserve(last_mjd - m_dense_mjd + 1);
+  for (int mjd = m_dense_mjd; mjd <= last_mjd; mjd++) {
+    int extra;
+    const int delat = search_dat(mjd, extra);
+    m_dense.push_back({static_cast<std::int8_t>(delat),
+                       static_cast<std::int8_t>(extra)});
+  }
+
+  m_dense_calendar.reserve(last_month - m_dense_month + 1);
+  for (int m = m_dense_month; m <= last_month; m++) {
+    m_dense_calendar.push_back(static_cast<std::int8_t>(search_dat_calendar(
+        (m - 1) / MONTHS_IN_YEAR, (m - 1) % MONTHS_IN_YEAR + 1)));
+  }
+}
+
+const dso::LeapSecondTable &dso::LeapSecondTable::builtin() noexcept {
+  static const LeapSecondTable table(
+      std::vector<change>(core::builtin_leap_seconds.cbegin(),
+                          core::builtin_leap_seconds.cend()),
+      core::BUILTIN_LEAP_SECONDS_EXPIRY_MJD);
+  return table;
+}
+
+dso::LeapSecondTable dso::LeapSecondTable::from_file(const char *fn) {
+  std::ifstream fin(fn);
+  if (!fin.is_open()) {
+    fprintf(stderr,
+            "[ERROR] Failed opening leap second file %s (traceback: %s)\n", fn,
+            __func__);
+    throw std::runtime_error("[ERROR] Failed opening leap second file\n");
+  }
+
+  /* USNO files have no comment lines; IERS files always start with one */
+  const bool is_iers = (fin.peek() == '#');
+
+  std::vector<change> changes;
+  int expiry_mjd = -1;
+  try {
+    expiry_mjd = is_iers ? parse_iers(fin, changes) : parse_usno(fin, changes);
+  } catch (std::exception &) {
+    expiry_mjd = -1;
+  }
+  if (expiry_mjd < 0 || changes.empty()) {
+    fprintf(stderr,
+            "[ERROR] Failed parsing leap second file %s (traceback: %s)\n", fn,
+            __func__);
+    throw std::runtime_error("[ERROR] Failed parsing leap second file\n");
+  }
+
+  try {
+    return LeapSecondTable(std::move(changes), expiry_mjd);
+  } catch (std::invalid_argument &) {
+    fprintf(stderr,
+            "[ERROR] Invalid leap second table in file %s (traceback: %s)\n",
+            fn, __func__);
+    throw std::runtime_error("[ERROR] Failed parsing leap second file\n");
+  }
+}
+
+int dso::LeapSecondTable::search_dat(int mjd) const noexcept {
+  /* find the preceding table entry. */
+  auto it = std::find_if(m_changes.crbegin(), m_changes.crend(),
+                         [=](const change &c) { return mjd >= c.mjd; });
+
+  /* Get the Delta(AT). */
+  return it == m_changes.crend() ? m_changes.front().delat : it->delat;
+}
+
+int dso::LeapSecondTable::search_dat(int mjd,
+                                      int &extra_sec_in_day) const noexcept {
+  /* find the preceding table entry. */
+  auto it = std::find_if(m_changes.crbegin(), m_changes.crend(),
+                         [=](const change &c) { return mjd >= c.mjd; });
+
+  /* extra seconds in day */
+  extra_sec_in_day = 0;
+
+  if (it == m_changes.crend())
+    return m_changes.front().delat;
+
+  /* given MJD is on a leap-insertion date (i.e. day prior to next leap) */
+  if (it != m_changes.crbegin() && mjd == (it - 1)->mjd - 1)
+    extra_sec_in_day = (it - 1)->delat - it->delat;
+
+  /* Get the Delta(AT). */
+  return it->delat;
+}
+
+int dso::LeapSecondTable::search_dat_calendar(int iy,
+                                               int im) const noexcept {
+  /* Combine year and month to form a date-ordered integer... */
+  const int m = MONTHS_IN_YEAR * iy + im;
+
+  /* ...and use it to find the preceding table entry. */
+  auto it = std::find_if(m_months.crbegin(), m_months.crend(),
+                         [=](int om) { return m >= om; });
+
+  /* Get the Delta(AT). */
+  return it == m_months.crend()
+             ? m_changes.front().delat
+             : m_changes[std::distance(it, m_months.crend()) - 1].delat;
+}
+
+int dso::LeapSecondTable::search_is_leap_insertion_day(
+    int mjd) const noexcept {
+  for (auto it = m_changes.crbegin(); it != m_changes.crend(); ++it) {
+    if (mjd == it->mjd - 1)
+      return 1;
+    if (mjd > it->mjd - 1)
+      return 0;
+  }
+  return 0;
+}
+
+bool dso::LeapSecondTable::operator==(
+    const LeapSecondTable &other) const noexcept {
+  return std::equal(m_changes.cbegin(), m_changes.cend(),
+                    other.m_changes.cbegin(), other.m_changes.cend(),
+                    [](const change &a, const change &b) {
+                      return a.mjd == b.mjd && a.delat == b.delat;
+                    });
+}
+
+void dso::LeapCursor::set_segment() noexcept {
+  const auto &changes = m_table->changes();
+  const int size = static_cast<int>(changes.size());
+  if (m_idx < 0) {
+    m_first = std::numeric_limits<int>::min();
+    m_delat = changes.front().delat;
+  } else {
+    m_first = changes[m_idx].mjd;
+    m_delat = changes[m_idx].delat;
+  }
+  if (m_idx + 1 < size) {
+    m_last = changes[m_idx + 1].mjd - 1;
+    /* no extra seconds prior to the first change */
+    m_extra = (m_idx < 0) ? 0 : changes[m_idx + 1].delat - m_delat;
+  } else {
+    m_last = std::numeric_limits<int>::max();
+    m_extra = 0;
+  }
+}
+
+void dso::LeapCursor::seek(int mjd) noexcept {
+  const auto &changes = m_table->changes();
+  const int size = static_cast<int>(changes.size());
+  while (m_idx + 1 < size && mjd >= changes[m_idx + 1].mjd)
+    ++m_idx;
+  while (m_idx >= 0 && mjd < changes[m_idx].mjd)
+    --m_idx;
+  set_segment();
+}
+
+std::atomic<const dso::LeapSecondTable *> dso::leap_seconds::detail::installed{
+    nullptr};
+
+const dso::LeapSecondTable *
+dso::leap_seconds::detail::install_builtin() noexcept {
+  const LeapSecondTable *expected = nullptr;
+  const LeapSecondTable *builtin = &LeapSecondTable::builtin();
+  /* on failure, expected holds the table installed meanwhile */
+  if (installed.compare_exchange_strong(expected, builtin,
+                                        std::memory_order_acq_rel))
+    return builtin;
+  return expected;
+}
+
+const dso::LeapSecondTable *
+dso::leap_seconds::install(LeapSecondTable table) {
+  std::lock_guard<std::mutex> lock(writer_mtx);
+  tables.push_back(new LeapSecondTable(std::move(table)));
+  detail::installed.store(tables.back(), std::memory_order_release);
+  return tables.back();
+}
+
+const dso::LeapSecondTable *dso::leap_seconds::load(const char *fn) {
+  /* parse first, so that the current table is untouched on failure */
+  auto table = LeapSecondTable::from_file(fn);
+  const auto *t = install(std::move(table));
+  std::lock_guard<std::mutex> lock(writer_mtx);
+  source_fn = fn;
+  return t;
+}
+
+bool dso::leap_seconds::reload() {
+  std::string fn;
+  {
+    std::lock_guard<std::mutex> lock(writer_mtx);
+    fn = source_fn;
+  }
+  if (fn.empty())
+    return false;
+
+  auto table = LeapSecondTable::from_file(fn.c_str());
+  const auto *t = current();
+  if (table == *t && table.expiry_mjd() == t->expiry_mjd())
+    return false;
+  install(std::move(table));
+  return true;
+}
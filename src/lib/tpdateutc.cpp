@@ -15,3 +15,16 @@ dso::TwoPartDateUTC::operator-(const dso::TwoPartDateUTC &d) const noexcept {
   }
   return TwoPartDate(days, FractionalSeconds{sec});
 }
+
+dso::TwoPartDate
+dso::TwoPartDateUTC::diff(const dso::TwoPartDateUTC &d,
+                          dso::LeapCursor &cursor) const noexcept {
+  int days = imjd() - d.imjd();
+  FDOUBLE sec = seconds().seconds() - d.seconds().seconds();
+  if (days) {
+    const int dat2 = cursor.dat(d.imjd());
+    const int dat1 = cursor.dat(imjd());
+    sec += (dat1 - dat2);
+  }
+  return TwoPartDate(days, FractionalSeconds{sec});
+}
@@ -1,13 +1,140 @@
+#include "core/parallel_chunks.hpp"
 #include "tpdate.hpp"
 
+namespace {
+/* out[i] = C::convert(in[i], ΔAT) for i in [b, e), where ΔAT is for the
+ * (integral) UTC MJD C::key(in[i]). ΔAT is resolved via a LeapCursor, so the
+ * leap second table is only searched when crossing into another ΔAT
+ * segment. */
+template <typename C, typename In, typename Out>
+void leap_pass(const dso::LeapSecondTable *table, const In *in, Out *out,
+               std::size_t b, std::size_t e) noexcept {
+  dso::LeapCursor cursor(table);
+  for (std::size_t i = b; i < e; i++)
+    out[i] = C::convert(in[i], cursor.dat(C::key(in[i])));
+}
+
+/* leap_pass over [0, n), split among (at most) num_threads threads */
+template <typename C, typename In, typename Out>
+void parallel_leap_pass(const In *in, std::size_t n, Out *out,
+                        unsigned num_threads) {
+  const dso::LeapSecondTable *table = dso::leap_seconds::current();
+  dso::core::parallel_chunks(
+      n, dso::core::num_chunks(n, num_threads, dso::core::LEAP_BATCH_GRAIN),
+      [&](unsigned, std::size_t b, std::size_t e) {
+        leap_pass<C>(table, in, out, b, e);
+      });
+}
+
+/* conversions, given ΔAT; these are the same expressions as the ones of the
+ * (scalar) member functions, hence results are identical */
+struct utc2tai_conv {
+  static int key(const dso::TwoPartDateUTC &d) noexcept {
+    return d.imjd();
+  }
+  static dso::TwoPartDate convert(const dso::TwoPartDateUTC &d,
+                                  int delat) noexcept {
+    return dso::TwoPartDate(d.imjd(),
+                            dso::FractionalSeconds{d.seconds().seconds() +
+                                                   delat});
+  }
+}; /* utc2tai_conv */
+
+struct utc2tt_conv {
+  static int key(const dso::TwoPartDateUTC &d) noexcept {
+    return d.imjd();
+  }
+  static dso::TwoPartDate convert(const dso::TwoPartDateUTC &d,
+                                  int delat) noexcept {
+    constexpr const double dtat = dso::TT_MINUS_TAI;
+    return dso::TwoPartDate(
+        d.imjd(),
+        dso::FractionalSeconds{d.seconds().seconds() + (delat + dtat)});
+  }
+}; /* utc2tt_conv */
+
+struct tai2utc_conv {
+  static int key(const dso::TwoPartDate &d) noexcept {
+    return d.imjd();
+  }
+  static dso::TwoPartDateUTC convert(const dso::TwoPartDate &d,
+                                     int delat) noexcept {
+    return dso::TwoPartDateUTC(
+        d.imjd(),
+        dso::FractionalSeconds{d.seconds().seconds() - (double)delat});
+  }
+}; /* tai2utc_conv */
+
+struct gps2utc_conv {
+  static int key(const dso::TwoPartDate &d) noexcept {
+    return d.gps2tai().imjd();
+  }
+  static dso::TwoPartDateUTC convert(const dso::TwoPartDate &d,
+                                     int delat) noexcept {
+    return tai2utc_conv::convert(d.gps2tai(), delat);
+  }
+}; /* gps2utc_conv */
+} /* unnamed namespace */
+
 dso::TwoPartDate dso::TwoPartDateUTC::utc2tai() const noexcept {
   FDOUBLE taisec = 0e0;
   int taimjd = this->utc2tai(taisec);
   return dso::TwoPartDate(taimjd, dso::FractionalSeconds{taisec});
 }
 
+dso::TwoPartDate
+dso::TwoPartDateUTC::utc2tai(dso::LeapCursor &cursor) const noexcept {
+  FDOUBLE taisec = 0e0;
+  int taimjd = this->utc2tai(taisec, cursor);
+  return dso::TwoPartDate(taimjd, dso::FractionalSeconds{taisec});
+}
+
 dso::TwoPartDate dso::TwoPartDateUTC::utc2tt() const noexcept {
   FDOUBLE ttsec = 0e0;
-  int ttmjd = this->utc2tai(ttsec);
+  int ttmjd = this->utc2tt(ttsec);
   return dso::TwoPartDate(ttmjd, dso::FractionalSeconds{ttsec});
 }
+
+void dso::utc2tai_batch(const dso::TwoPartDateUTC *utc, std::size_t n,
+                        dso::TwoPartDate *out) noexcept {
+  leap_pass<utc2tai_conv>(leap_seconds::current(), utc, out, 0, n);
+}
+
+void dso::utc2tt_batch(const dso::TwoPartDateUTC *utc, std::size_t n,
+                       dso::TwoPartDate *out) noexcept {
+  leap_pass<utc2tt_conv>(leap_seconds::current(), utc, out, 0, n);
+}
+
+void dso::tai2utc_batch(const dso::TwoPartDate *tai, std::size_t n,
+                        dso::TwoPartDateUTC *out) noexcept {
+  leap_pass<tai2utc_conv>(leap_seconds::current(), tai, out, 0, n);
+}
+
+void dso::gps2utc_batch(const dso::TwoPartDate *gps, std::size_t n,
+                        dso::TwoPartDateUTC *out) noexcept {
+  leap_pass<gps2utc_conv>(leap_seconds::current(), gps, out, 0, n);
+}
+
+void dso::parallel_utc2tai_batch(const dso::TwoPartDateUTC *utc,
+                                 std::size_t n, dso::TwoPartDate *out,
+                                 unsigned num_threads) {
+  parallel_leap_pass<utc2tai_conv>(utc, n, out, num_threads);
+}
+
+void dso::parallel_utc2tt_batch(const dso::TwoPartDateUTC *utc,
+                                std::size_t n, dso::TwoPartDate *out,
+                                unsigned num_threads) {
+  parallel_leap_pass<utc2tt_conv>(utc, n, out, num_threads);
+}
+
+void dso::parallel_tai2utc_batch(const dso::TwoPartDate *tai, std::size_t n,
+                                 dso::TwoPartDateUTC *out,
+                                 unsigned num_threads) {
+  parallel_leap_pass<tai2utc_conv>(tai, n, out, num_threads);
+}
+
+void dso::parallel_gps2utc_batch(const dso::TwoPartDate *gps, std::size_t n,
+                                 dso::TwoPartDateUTC *out,
+                                 unsigned num_threads) {
+  parallel_leap_pass<gps2utc_conv>(gps, n, out, num_threads);
+}
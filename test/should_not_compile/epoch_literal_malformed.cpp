@@ -0,0 +1,10 @@
+#include "calendar.hpp"
+
+using namespace dso;
+using namespace dso::literals;
+
+int main() {
+  // should not compile because there is no month 13
+  constexpr auto t = "2017-13-01T00:00:00"_tai_ns;
+  return t.imjd().as_underlying_type() > 0;
+}
@@ -0,0 +1,88 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+constexpr const long num_tests = 10'000'000;
+
+/* Throughput of the SOFA/Fliegel & Van Flandern vs the Euclidean affine
+ * calendar algorithms. If called with any argument, an exhaustive
+ * verification over the whole range of modified_julian_day is performed
+ * first.
+ */
+int main(int argc, [[maybe_unused]] char *argv[]) {
+  if (argc > 1) {
+    long bad = 0;
+    for (long mjd = INT_MIN; mjd <= INT_MAX; ++mjd) {
+      int y, m, d, y2, m2, d2;
+      dso::core::mjd2ymd_eaf(mjd, y, m, d);
+      bad += (dso::core::ymd2mjd_eaf(y, m, d) != mjd);
+      if (mjd >= -2400001) {
+        dso::core::mjd2ymd_fvf(mjd, y2, m2, d2);
+        bad += (y != y2 || m != m2 || d != d2);
+        bad += (dso::core::ymd2mjd_sofa(y, m, d) != mjd);
+      }
+    }
+    printf("Exhaustive verification, mismatches: %ld\n", bad);
+  }
+
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(15385, 88000); /* range for MJDs */
+
+  std::vector<int> mjds(num_tests), y(num_tests), m(num_tests), d(num_tests);
+  for (auto &mjd : mjds)
+    mjd = mjdstr(gen);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++)
+      dso::core::mjd2ymd_fvf(mjds[i], y[i], m[i], d[i]);
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    std::cout << "mjd2ymd (Fliegel) : " << duration.count() << "microsec\n";
+    dummy += y[Y] + m[Y] + d[Y];
+
+    start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++)
+      dso::core::mjd2ymd_eaf(mjds[i], y[i], m[i], d[i]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "mjd2ymd (EAF)     : " << duration.count() << "microsec\n";
+    dummy -= y[Y] + m[Y] + d[Y];
+
+    start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++)
+      dummy += dso::core::ymd2mjd_sofa(y[i], m[i], d[i]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "ymd2mjd (SOFA)    : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++)
+      dummy -= dso::core::ymd2mjd_eaf(y[i], m[i], d[i]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "ymd2mjd (EAF)     : " << duration.count() << "microsec\n";
+
+    /* the selected (validating) algorithm */
+    start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++)
+      dummy += dso::core::cal2mjd(y[i], m[i], d[i]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "cal2mjd           : " << duration.count() << "microsec\n";
+    dummy -= mjds[Y];
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
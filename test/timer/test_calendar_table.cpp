@@ -0,0 +1,70 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+constexpr const long num_tests = 10'000'000;
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  /* range for MJDs, i.e. the default calendar table window */
+  std::uniform_int_distribution<> mjdstr(dso::calendar_table::DEFAULT_FIRST_MJD,
+                                         dso::calendar_table::DEFAULT_LAST_MJD);
+
+  std::vector<int> mjds(num_tests);
+  for (auto &mjd : mjds)
+    mjd = mjdstr(gen);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      const auto ymd = dso::core::mjd2ymd(mjd);
+      dummy += ymd.dm().as_underlying_type();
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    std::cout << "core::mjd2ymd       : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      const auto ymd = dso::modified_julian_day(mjd).to_ymd();
+      dummy -= ymd.dm().as_underlying_type();
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "to_ymd (table)      : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      const auto ydoy = dso::modified_julian_day(mjd).to_ydoy();
+      dummy += ydoy.dy().as_underlying_type();
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "to_ydoy (table)     : " << duration.count() << "microsec\n";
+
+    /* disable the table */
+    const auto *t = dso::calendar_table::current();
+    dso::calendar_table::set_window(1, 0);
+    start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      const auto ydoy = dso::modified_julian_day(mjd).to_ydoy();
+      dummy -= ydoy.dy().as_underlying_type();
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "to_ydoy (arithmetic): " << duration.count() << "microsec\n";
+    dso::calendar_table::set_window(t->first_mjd(), t->last_mjd());
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include "calendar.hpp"
+#include "leap_seconds.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+constexpr const long num_tests = 10'000'000;
+
+/* ΔAT and extra seconds in day via a reverse linear search of the changes,
+ * i.e. the algorithm used before the dense table was introduced.
+ */
+int linear_dat(int mjd, int &extra_sec_in_day) noexcept {
+  const auto &changes = dso::LeapSecondTable::builtin().changes();
+  auto it = std::find_if(
+      changes.crbegin(), changes.crend(),
+      [=](const dso::LeapSecondTable::change &c) { return mjd >= c.mjd; });
+  extra_sec_in_day = 0;
+  if (it != changes.crend() && it != changes.crbegin()) {
+    if (mjd == (it - 1)->mjd - 1)
+      extra_sec_in_day = (it - 1)->delat - it->delat;
+  }
+  return it->delat;
+}
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(41317, 61000); /* range for MJDs */
+
+  std::vector<int> mjds(num_tests);
+  std::generate(mjds.begin(), mjds.end(), [&]() { return mjdstr(gen); });
+  const auto *table = dso::leap_seconds::current();
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+    int extra;
+
+    auto start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      dummy += linear_dat(mjd, extra) + extra;
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    std::cout << "Linear search: " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      dummy -= table->dat(mjd, extra) + extra;
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "Dense table  : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (const int mjd : mjds) {
+      dummy += dso::dat(dso::modified_julian_day(mjd), extra) + extra;
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "dso::dat     : " << duration.count() << "microsec\n";
+
+    std::vector<int> out(mjds.size()), extras(mjds.size());
+    start = high_resolution_clock::now();
+    dso::dat_batch(mjds.data(), out.data(), extras.data(), mjds.size());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "dso::dat_batch: " << duration.count() << "microsec\n";
+    dummy += out[Y] + extras[Y];
+
+    /* time-ordered MJDs, via a LeapCursor */
+    std::vector<int> sorted(mjds);
+    std::sort(sorted.begin(), sorted.end());
+    dso::LeapCursor cursor(table);
+    start = high_resolution_clock::now();
+    for (const int mjd : sorted) {
+      dummy -= cursor.dat(mjd, extra) + extra;
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "LeapCursor   : " << duration.count() << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
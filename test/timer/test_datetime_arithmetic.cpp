@@ -0,0 +1,76 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+/* the previous, std::copysign based, normalization of datetime<S> */
+void normalize_copysign(int &mjd, long &sec) noexcept {
+  if (sec >= 0 && sec < ns::max_in_day)
+    return;
+  const int more = std::copysign(sec, 1) / ns::max_in_day;
+  const int days = mjd + std::copysign(more, dso::core::sgn(sec));
+  const long s = std::copysign(sec, 1) - more * ns::max_in_day;
+  mjd = days - 1 * (sec < 0);
+  sec = (ns::max_in_day - s) * (sec < 0) + s * (sec >= 0);
+}
+
+int main() {
+  constexpr const int num = 4'000'000;
+  std::mt19937_64 gen(2016);
+  std::uniform_int_distribution<int> dmjd(44244, 66154);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  std::uniform_int_distribution<long> dadd(-10 * ns::max_in_day,
+                                           10 * ns::max_in_day);
+  std::vector<dso::datetime<ns>> d(num);
+  std::vector<int> mjd(num);
+  std::vector<long> sec(num);
+  std::vector<ns> add(num);
+  for (int i = 0; i < num; i++) {
+    d[i] = dso::datetime<ns>(dso::modified_julian_day(dmjd(gen)),
+                             ns(dsec(gen)));
+    mjd[i] = d[i].imjd().as_underlying_type();
+    sec[i] = d[i].sec().as_underlying_type();
+    add[i] = ns(dadd(gen));
+  }
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++) {
+      sec[i] += add[i].as_underlying_type();
+      normalize_copysign(mjd[i], sec[i]);
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += mjd[num / 2];
+    std::cout << "add + normalize, std::copysign: " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      d[i].add_seconds(add[i]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= d[num / 2].imjd().as_underlying_type();
+    std::cout << "add + normalize, integer only : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int i = 1; i < num; i++)
+      dummy += (d[i] - d[i - 1]).sign();
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "difference (interval)         : " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
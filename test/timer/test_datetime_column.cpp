@@ -0,0 +1,53 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  constexpr const int num = 4'000'000;
+  std::mt19937_64 gen(2015);
+  std::uniform_int_distribution<int> dmjd(44244, 66154);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  std::vector<dso::datetime<ns>> d(num);
+  for (int i = 0; i < num; i++)
+    d[i] = dso::datetime<ns>(dso::modified_julian_day(dmjd(gen)),
+                             ns(dsec(gen)));
+  dso::datetime_column<ns> col(d.data(), d.size());
+  const dso::datetime<ns> ref(dso::modified_julian_day(55555), ns(0));
+  const ns s(19'000'000'000L);
+  std::vector<double> dt(num);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++) {
+      d[i].add_seconds(s);
+      dt[i] = d[i]
+                  .diff<dso::DateTimeDifferenceType::FractionalSeconds>(ref)
+                  .seconds();
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += (long)dt[num / 2];
+    std::cout << "std::vector<datetime<S>>, add + diff: " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    col.add(s);
+    col.diff(ref, dt.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= (long)dt[num / 2];
+    std::cout << "datetime_column<S>      , add + diff: " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
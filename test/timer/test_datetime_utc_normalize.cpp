@@ -0,0 +1,93 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using nsec = dso::nanoseconds;
+
+constexpr const long num_tests = 1'000'000;
+
+/* normalization removing one (UTC) day at a time, i.e. the algorithm used
+ * before the closed-form implementation (forward steps only).
+ */
+void loop_normalize(int &mjd, long &sec) {
+  constexpr const long F = nsec::sec_factor<long>();
+  int extra;
+  dso::dat(dso::modified_julian_day(mjd), extra);
+  while (sec >= nsec::max_in_day + extra * F) {
+    sec -= nsec::max_in_day + extra * F;
+    ++mjd;
+    dso::dat(dso::modified_julian_day(mjd), extra);
+  }
+}
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(45000, 58000); /* range for MJDs */
+  std::uniform_int_distribution<long> secstr(0, nsec::max_in_day - 1);
+  /* steps up to a month and up to three years */
+  std::uniform_int_distribution<long> mstepstr(0, 30 * nsec::max_in_day);
+  std::uniform_int_distribution<long> ystepstr(0, 3 * 365 * nsec::max_in_day);
+
+  std::vector<int> mjds(num_tests);
+  std::vector<long> secs(num_tests), msteps(num_tests), ysteps(num_tests);
+  for (long i = 0; i < num_tests; i++) {
+    mjds[i] = mjdstr(gen);
+    secs[i] = secstr(gen);
+    msteps[i] = mstepstr(gen);
+    ysteps[i] = ystepstr(gen);
+  }
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+    for (const auto *steps : {&msteps, &ysteps}) {
+      const char *label = (steps == &msteps) ? "month" : "3-year";
+
+      /* forward steps, day-by-day loop */
+      auto start = high_resolution_clock::now();
+      for (long i = 0; i < num_tests; i++) {
+        int mjd = mjds[i];
+        long sec = secs[i] + (*steps)[i];
+        loop_normalize(mjd, sec);
+        dummy += mjd + sec;
+      }
+      auto stop = high_resolution_clock::now();
+      auto duration = duration_cast<microseconds>(stop - start);
+      std::cout << "Loop, forward " << label << " steps       : "
+                << duration.count() << "microsec\n";
+
+      /* forward steps, closed-form */
+      start = high_resolution_clock::now();
+      for (long i = 0; i < num_tests; i++) {
+        dso::datetime_utc<nsec> d{dso::modified_julian_day(mjds[i]),
+                                  nsec(secs[i])};
+        d.add_seconds(nsec((*steps)[i]));
+        dummy -= d.imjd().as_underlying_type() + d.sec().as_underlying_type();
+      }
+      stop = high_resolution_clock::now();
+      duration = duration_cast<microseconds>(stop - start);
+      std::cout << "Closed-form, forward " << label << " steps: "
+                << duration.count() << "microsec\n";
+
+      /* backward steps, closed-form */
+      start = high_resolution_clock::now();
+      for (long i = 0; i < num_tests; i++) {
+        dso::datetime_utc<nsec> d{dso::modified_julian_day(mjds[i]),
+                                  nsec(secs[i])};
+        d.add_seconds(nsec(-(*steps)[i]));
+        dummy += d.imjd().as_underlying_type();
+      }
+      stop = high_resolution_clock::now();
+      duration = duration_cast<microseconds>(stop - start);
+      std::cout << "Closed-form, backward " << label << " steps: "
+                << duration.count() << "microsec\n";
+    }
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
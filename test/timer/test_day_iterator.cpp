@@ -0,0 +1,55 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+
+using namespace std::chrono;
+
+int main() {
+  /* a decade of days, repeated */
+  constexpr const int first = 58849; /* 2020/01/01 */
+  constexpr const int last = first + 3653;
+  constexpr const int repeat = 1000;
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int k = 0; k < repeat; k++) {
+      for (int mjd = first; mjd < last; mjd++) {
+        const dso::modified_julian_day d(mjd);
+        const auto ymd = d.to_ymd();
+        const auto ydoy = d.to_ydoy();
+        const dso::datetime<dso::seconds> t(d, dso::seconds(0));
+        dso::seconds sow;
+        const auto w = t.gps_wsow(sow);
+        int extra;
+        dummy += ymd.dm().as_underlying_type() +
+                 ydoy.dy().as_underlying_type() + w.as_underlying_type() +
+                 dso::dat(d, extra) + extra;
+      }
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    std::cout << "Per-day transformations: " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int k = 0; k < repeat; k++) {
+      for (const auto &day : dso::day_range(dso::modified_julian_day(first),
+                                            dso::modified_julian_day(last))) {
+        dummy -= day.dm().as_underlying_type() +
+                 day.dy().as_underlying_type() +
+                 day.gps_wk().as_underlying_type() + day.dat() +
+                 day.extra_seconds();
+      }
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "day_iterator           : " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+using DT = dso::DateTimeDifferenceType;
+
+int main() {
+  constexpr const int num = 4'000'000;
+  std::mt19937_64 gen(2017);
+  std::uniform_int_distribution<int> dmjd(44244, 66154);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  std::vector<dso::datetime<ns>> d(num);
+  std::vector<dso::TwoPartDate> t(num);
+  for (int i = 0; i < num; i++) {
+    d[i] = dso::datetime<ns>(dso::modified_julian_day(dmjd(gen)),
+                             ns(dsec(gen)));
+    t[i] = dso::TwoPartDate(d[i]);
+  }
+  const dso::datetime<ns> ref(dso::modified_julian_day(55555), ns(0));
+  const dso::TwoPartDate tref(ref);
+  std::vector<double> dt(num);
+
+  for (int Y = 0; Y < 5; Y++) {
+    double dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      dt[i] = d[i].diff<DT::FractionalSeconds>(ref).seconds();
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += dt[num / 2];
+    std::cout << "datetime<S>::diff   : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::diff_batch<DT::FractionalSeconds>(d.data(), num, ref, dt.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= dt[num / 2];
+    std::cout << "diff_batch<S>       : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      dt[i] = t[i].diff<DT::FractionalSeconds>(tref).seconds();
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += dt[num / 2];
+    std::cout << "TwoPartDate::diff   : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::diff_batch<DT::FractionalSeconds>(t.data(), num, tref, dt.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= dt[num / 2];
+    std::cout << "diff_batch<TPD>     : " << duration.count() << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%.3f\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  constexpr const int num = 5'000'000;
+  constexpr const int nq = 2'000'000;
+  std::mt19937_64 gen(2020);
+  std::uniform_int_distribution<long> djitter(-1'000'000, 1'000'000);
+  const dso::datetime<ns> t0{dso::modified_julian_day(50000), ns(0)};
+  std::vector<dso::datetime<ns>> d(num);
+  for (int i = 0; i < num; i++) {
+    d[i] = t0;
+    d[i].add_seconds(ns(i * 30'000'000'000L + djitter(gen)));
+  }
+  std::sort(d.begin(), d.end());
+  std::uniform_int_distribution<long> dq(0, num * 30'000'000'000L);
+  std::vector<dso::datetime<ns>> q(nq);
+  for (int i = 0; i < nq; i++) {
+    q[i] = t0;
+    q[i].add_seconds(ns(dq(gen)));
+  }
+  std::vector<dso::datetime<ns>> qs(q);
+  std::sort(qs.begin(), qs.end());
+  const dso::EpochIndex<dso::datetime<ns>> idx(d.data(), d.size());
+  std::vector<std::size_t> out(nq);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < nq; i++)
+      out[i] = std::lower_bound(d.begin(), d.end(), q[i]) - d.begin();
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += out[nq / 2];
+    std::cout << "std::lower_bound        : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int i = 0; i < nq; i++)
+      out[i] = idx.lower_bound(q[i]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= out[nq / 2];
+    std::cout << "EpochIndex::lower_bound : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int i = 0; i < nq; i++)
+      out[i] = std::lower_bound(d.begin(), d.end(), qs[i]) - d.begin();
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += out[nq / 2];
+    std::cout << "std::lower_bound, sorted: " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    idx.ceil_batch(qs.data(), nq, out.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= out[nq / 2];
+    std::cout << "EpochIndex::ceil_batch  : " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  constexpr const int num = 10'000'000;
+  const dso::datetime<ns> t0{dso::modified_julian_day(55555), ns(0)};
+  const ns step(30'000'000'000L);
+  std::vector<dso::datetime<ns>> d(num);
+  std::vector<dso::TwoPartDate> t(num);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    dso::datetime<ns> c(t0);
+    for (int i = 0; i < num; i++) {
+      d[i] = c;
+      c.add_seconds(step);
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += d[num / 2].imjd().as_underlying_type();
+    std::cout << "datetime<S>::add_seconds loop: " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    const dso::epoch_range r(t0, step, num);
+    for (int i = 0; i < num; i++)
+      d[i] = r[i];
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= d[num / 2].imjd().as_underlying_type();
+    std::cout << "epoch_range<datetime<S>>     : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::TwoPartDate tc(t0);
+    for (int i = 0; i < num; i++) {
+      t[i] = tc;
+      tc.add_seconds(dso::FractionalSeconds(30e0));
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += t[num / 2].imjd();
+    std::cout << "TwoPartDate::add_seconds loop: " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    const dso::epoch_range rt(dso::TwoPartDate(t0), step, num);
+    for (int i = 0; i < num; i++)
+      t[i] = rt[i];
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= t[num / 2].imjd();
+    std::cout << "epoch_range<TwoPartDate>     : " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  constexpr const int num = 5'000'000;
+  const ns iv(30'000'000'000L);
+  std::mt19937_64 gen(1);
+  std::uniform_int_distribution<int> mjds(44239, 66154);
+  std::uniform_int_distribution<long> secs(0, ns::max_in_day - 1);
+  std::vector<dso::datetime<ns>> d(num), ds(num);
+  std::vector<ns> dr(num);
+  std::vector<dso::TwoPartDate> t(num), ts(num);
+  std::vector<double> tr(num);
+  for (int i = 0; i < num; i++) {
+    d[i] = dso::datetime<ns>(dso::modified_julian_day(mjds(gen)),
+                             ns(secs(gen)));
+    t[i] = dso::TwoPartDate(d[i]);
+  }
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    /* the manual way: integer division of the seconds of day */
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++) {
+      const long s = d[i].sec().as_underlying_type();
+      long q = s / iv.as_underlying_type();
+      if (2 * (s - q * iv.as_underlying_type()) > iv.as_underlying_type())
+        ++q;
+      ds[i] = dso::datetime<ns>(d[i].imjd(), ns(q * iv.as_underlying_type()));
+      dr[i] = ns(s - q * iv.as_underlying_type());
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += ds[num / 2].sec().as_underlying_type() / 1'000'000'000L;
+    std::cout << "datetime<S> manual      : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::snap_batch(d.data(), num, iv, dso::SnapMode::Nearest, ds.data(),
+                    dr.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= ds[num / 2].sec().as_underlying_type() / 1'000'000'000L;
+    std::cout << "datetime<S> snap_batch  : " << duration.count()
+              << "microsec\n";
+
+    /* the manual way: std::round of seconds of day */
+    start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++) {
+      const double s = t[i].seconds().seconds();
+      const double g = std::round(s / 30e0) * 30e0;
+      ts[i] = dso::TwoPartDate(t[i].imjd(), dso::FractionalSeconds(g));
+      tr[i] = s - g;
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += (long)ts[num / 2].seconds().seconds();
+    std::cout << "TwoPartDate manual      : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::snap_batch(t.data(), num, dso::FractionalSeconds(30e0),
+                    dso::SnapMode::Nearest, ts.data(), tr.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= (long)ts[num / 2].seconds().seconds();
+    std::cout << "TwoPartDate snap_batch  : " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
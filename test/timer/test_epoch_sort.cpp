@@ -0,0 +1,57 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  constexpr const int num = 10'000'000;
+  const unsigned nthreads = std::max(1u, std::thread::hardware_concurrency());
+  std::mt19937_64 gen(2019);
+  std::uniform_int_distribution<int> dmjd(58000, 60000);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  std::vector<dso::datetime<ns>> d(num);
+  for (int i = 0; i < num; i++)
+    d[i] = dso::datetime<ns>(dso::modified_julian_day(dmjd(gen)),
+                             ns(dsec(gen)));
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    std::vector<dso::datetime<ns>> a(d);
+    auto start = high_resolution_clock::now();
+    std::sort(a.begin(), a.end());
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += a[num / 2].imjd().as_underlying_type();
+    std::cout << "std::sort                : " << duration.count()
+              << "microsec\n";
+
+    a = d;
+    start = high_resolution_clock::now();
+    dso::radix_sort(a.data(), a.size());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= a[num / 2].imjd().as_underlying_type();
+    std::cout << "dso::radix_sort          : " << duration.count()
+              << "microsec\n";
+
+    a = d;
+    start = high_resolution_clock::now();
+    dso::parallel_radix_sort(a.data(), a.size(), nthreads);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += a[num / 2].imjd().as_underlying_type();
+    std::cout << "dso::parallel_radix_sort : " << duration.count()
+              << "microsec (" << nthreads << " threads)\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  /* a day of 1Hz observations (per satellite), at random epochs */
+  constexpr const int num = 86400 * 32;
+  std::mt19937_64 gen(2024);
+  std::uniform_int_distribution<long> dweek(2200, 2400);
+  std::uniform_int_distribution<long> dsow(0, 7 * ns::max_in_day - 1);
+  std::vector<long> week(num);
+  std::vector<ns> sow(num);
+  for (int i = 0; i < num; i++) {
+    week[i] = dweek(gen);
+    sow[i] = ns(dsow(gen));
+  }
+  std::vector<dso::datetime<ns>> tai(num);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    /* GPS Time, via datetime<S> */
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++) {
+      tai[i] = dso::datetime<ns>(dso::gps_week(week[i]), sow[i]).gps2tai();
+    }
+    auto stop = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      dummy += tai[i].sec().as_underlying_type() % 7;
+    auto duration = duration_cast<microseconds>(stop - start);
+    std::cout << "GPS, datetime<S>(gps_week, sow): " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::gnss2tai_batch<dso::gnss::gpst>(week.data(), sow.data(), tai.data(),
+                                         num);
+    stop = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      dummy -= tai[i].sec().as_underlying_type() % 7;
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "GPS, gnss2tai_batch            : " << duration.count()
+              << "microsec\n";
+
+    /* GLONASS Time, scalar and batch */
+    start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++) {
+      tai[i] = dso::gnss2tai(
+          dso::gnss_wsow<dso::gnss::glonasst, ns>{week[i], sow[i]});
+    }
+    stop = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      dummy += tai[i].sec().as_underlying_type() % 7;
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "GLONASS, gnss2tai              : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::gnss2tai_batch<dso::gnss::glonasst>(week.data(), sow.data(),
+                                             tai.data(), num);
+    stop = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      dummy -= tai[i].sec().as_underlying_type() % 7;
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "GLONASS, gnss2tai_batch        : " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using ns = dso::nanoseconds;
+
+int main() {
+  constexpr const int num = 1'000'000;
+  std::mt19937_64 gen(2000);
+  std::uniform_int_distribution<int> dmjd(44244, 66154);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  std::vector<dso::datetime<ns>> d0(num);
+  for (int i = 0; i < num; i++)
+    d0[i] = dso::datetime<ns>(dso::modified_julian_day(dmjd(gen)),
+                              ns(dsec(gen)));
+  std::vector<dso::linear_time<ns>> l0(num);
+  for (int i = 0; i < num; i++)
+    l0[i] = dso::linear_time<ns>(d0[i]);
+  std::vector<double> dt(num);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto d = d0;
+    auto start = high_resolution_clock::now();
+    std::sort(d.begin(), d.end());
+    for (int i = 1; i < num; i++)
+      dt[i] = d[i]
+                  .diff<dso::DateTimeDifferenceType::FractionalSeconds>(
+                      d[i - 1])
+                  .seconds();
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += (long)dt[num / 2];
+    std::cout << "datetime<S>   , sort + diff: " << duration.count()
+              << "microsec\n";
+
+    auto l = l0;
+    start = high_resolution_clock::now();
+    std::sort(l.begin(), l.end());
+    for (int i = 1; i < num; i++)
+      dt[i] = l[i].diff_sec(l[i - 1]);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= (long)dt[num / 2];
+    std::cout << "linear_time<S>, sort + diff: " << duration.count()
+              << "microsec\n";
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "calendar.hpp"
+#include "date_batch.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+constexpr const long num_tests = 10'000'000;
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(44244, 66000); /* range for MJDs */
+
+  std::vector<int> mjds(num_tests);
+  for (auto &mjd : mjds)
+    mjd = mjdstr(gen);
+  std::vector<int> y(num_tests), m(num_tests), d(num_tests);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++) {
+      const auto ymd = dso::core::mjd2ymd(mjds[i]);
+      y[i] = ymd.yr().as_underlying_type();
+      m[i] = ymd.mn().as_underlying_type();
+      d[i] = ymd.dm().as_underlying_type();
+    }
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    std::cout << "Scalar mjd2ymd  : " << duration.count() << "microsec\n";
+    dummy += y[Y] + m[Y] + d[Y];
+
+    start = high_resolution_clock::now();
+    dso::mjd2ymd_batch(mjds.data(), y.data(), m.data(), d.data(), num_tests);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "mjd2ymd_batch   : " << duration.count() << "microsec\n";
+    dummy -= y[Y] + m[Y] + d[Y];
+
+    start = high_resolution_clock::now();
+    for (long i = 0; i < num_tests; i++) {
+      const auto ydoy = dso::modified_julian_day(mjds[i]).to_ydoy();
+      y[i] = ydoy.yr().as_underlying_type();
+      d[i] = ydoy.dy().as_underlying_type();
+    }
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "Scalar to_ydoy  : " << duration.count() << "microsec\n";
+    dummy += y[Y] + d[Y];
+
+    start = high_resolution_clock::now();
+    dso::mjd2ydoy_batch(mjds.data(), y.data(), d.data(), num_tests);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    std::cout << "mjd2ydoy_batch  : " << duration.count() << "microsec\n";
+    dummy -= y[Y] + d[Y];
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include "calendar.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+using DT = dso::DateTimeDifferenceType;
+
+/* normalization as previously done by TwoPartDate, i.e. via std::fmod */
+inline void fmod_normalize(int &mjd, double &sec) noexcept {
+  if (sec >= 0e0 && sec < 86400e0)
+    return;
+  double srem = std::fmod(sec, 86400e0);
+  int extradays = sec / 86400e0;
+  if ((srem < 0e0) && (mjd + extradays)) {
+    --extradays;
+    srem += 86400e0;
+  }
+  sec = srem;
+  mjd += extradays;
+}
+
+int main() {
+  /* satellite epochs, propagated with (different) steps that cross day
+   * boundaries often */
+  constexpr const int num = 4096;
+  constexpr const int calls = 2'000;
+  std::mt19937_64 gen(5);
+  std::uniform_int_distribution<int> mjds(58000, 60000);
+  std::uniform_real_distribution<double> secs(0e0, 86400e0);
+  std::uniform_real_distribution<double> steps(-50'000e0, 50'000e0);
+  std::vector<dso::TwoPartDate> t0(num);
+  std::vector<double> step(num);
+  for (int i = 0; i < num; i++) {
+    t0[i] = dso::TwoPartDate(mjds(gen), dso::FractionalSeconds(secs(gen)));
+    step[i] = steps(gen);
+  }
+  const dso::TwoPartDate ref(59000, dso::FractionalSeconds(0e0));
+  std::vector<double> dt(num);
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    std::vector<int> mjd(num);
+    std::vector<double> sec(num);
+    for (int i = 0; i < num; i++) {
+      mjd[i] = t0[i].imjd();
+      sec[i] = t0[i].seconds().seconds();
+    }
+    for (int c = 0; c < calls; c++) {
+      for (int i = 0; i < num; i++) {
+        sec[i] += step[i];
+        fmod_normalize(mjd[i], sec[i]);
+      }
+    }
+    for (int i = 0; i < num; i++)
+      dt[i] = (sec[i] - ref.seconds().seconds()) +
+              (mjd[i] - ref.imjd()) * dso::SEC_PER_DAY;
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += (long)dt[num / 2];
+    std::cout << "std::fmod normalize          : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    std::vector<dso::TwoPartDate> t(t0);
+    for (int c = 0; c < calls; c++) {
+      for (int i = 0; i < num; i++)
+        t[i].add_seconds(dso::FractionalSeconds(step[i]));
+    }
+    for (int i = 0; i < num; i++)
+      dt[i] = t[i].diff<DT::FractionalSeconds>(ref).seconds();
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= (long)dt[num / 2];
+    std::cout << "std::vector<TwoPartDate>     : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::tpdate_column col(t0.data(), num);
+    for (int c = 0; c < calls; c++)
+      col.add_seconds(step.data());
+    col.diff<DT::FractionalSeconds>(ref, dt.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += (long)dt[num / 2];
+    std::cout << "tpdate_column                : " << duration.count()
+              << "microsec\n";
+    dummy -= (long)t[num / 2].diff<DT::FractionalSeconds>(ref).seconds();
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include "calendar.hpp"
+#include "core/int128.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/* Throughput and precision of TwoPartDateT<R>, for R double, long double
+ * and DoubleDouble.
+ *
+ * Throughput: a loop of add_seconds (small steps) and a loop of diffs
+ * between epochs decades apart.
+ * Precision: error after the add_seconds loop, and max error of the diffs,
+ * against exact (integral picosecond) results.
+ */
+
+#ifndef DATETIME_HAS_INT128
+/* reference results are computed with 128-bit integers */
+int main() { return 0; }
+#else
+
+using namespace std::chrono;
+using ps = dso::picoseconds;
+using i128 = dso::core::int128_t;
+
+constexpr const int num = 2'000'000;
+
+/* error of x (seconds) w.r.t. w whole seconds + f picoseconds; computed in
+ * DoubleDouble, so that it resolves errors of DoubleDouble results */
+template <typename R> double error(R x, long w, long f) {
+  dso::DoubleDouble xd;
+  if constexpr (std::is_same_v<R, long double>) {
+    const double hi = static_cast<double>(x);
+    xd = dso::DoubleDouble::sum(hi, static_cast<double>(x - hi));
+  } else {
+    xd = x;
+  }
+  const dso::DoubleDouble e = (xd - static_cast<double>(w)) -
+                              dso::DoubleDouble(static_cast<double>(f)) / 1e12;
+  return std::abs(e.to_double());
+}
+
+template <typename R>
+void run(const char *name, const std::vector<dso::datetime<ps>> &a,
+         const std::vector<dso::datetime<ps>> &b, long &dummy) {
+  using T = dso::TwoPartDateT<R>;
+  std::vector<T> ta(a.size()), tb(b.size());
+  for (std::size_t i = 0; i < a.size(); i++) {
+    ta[i] = T(a[i]);
+    tb[i] = T(b[i]);
+  }
+
+  /* add_seconds; 1 nanosec steps, starting at 00:00:00 */
+  T t(a[0].imjd());
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < num; i++)
+    t.add_seconds(dso::FractionalSeconds(1e-9));
+  auto stop = high_resolution_clock::now();
+  auto duration = duration_cast<microseconds>(stop - start);
+  const double add_err = error(t.seconds_rep(), 0, num * 1000L);
+  dummy += t.imjd();
+  std::cout << name << " add_seconds : " << duration.count() << "microsec"
+            << ", error=" << add_err << " sec\n";
+
+  /* diffs */
+  std::vector<R> d(a.size());
+  start = high_resolution_clock::now();
+  for (std::size_t i = 0; i < a.size(); i++)
+    d[i] = ta[i].diff_seconds(tb[i]);
+  stop = high_resolution_clock::now();
+  duration = duration_cast<microseconds>(stop - start);
+  double max_err = 0e0;
+  for (std::size_t i = 0; i < a.size(); i++) {
+    const i128 x =
+        (static_cast<i128>(a[i].imjd().as_underlying_type()) -
+         b[i].imjd().as_underlying_type()) *
+            ps::max_in_day +
+        (a[i].sec().as_underlying_type() - b[i].sec().as_underlying_type());
+    const double e =
+        error(d[i], static_cast<long>(x / 1'000'000'000'000L),
+              static_cast<long>(x % 1'000'000'000'000L));
+    max_err = (e > max_err) ? e : max_err;
+  }
+  dummy -= static_cast<long>(dso::core::to_double(d[a.size() / 2]));
+  std::cout << name << " diff        : " << duration.count() << "microsec"
+            << ", max error=" << max_err << " sec\n";
+}
+
+int main() {
+  std::mt19937_64 gen(3);
+  /* epochs within ~1980 to ~2040 */
+  std::uniform_int_distribution<int> mjds(44239, 66154);
+  std::uniform_int_distribution<long> secs(0, ps::max_in_day - 1);
+  std::vector<dso::datetime<ps>> a(num), b(num);
+  for (int i = 0; i < num; i++) {
+    a[i] = dso::datetime<ps>(dso::modified_julian_day(mjds(gen)),
+                             ps(secs(gen)));
+    b[i] = dso::datetime<ps>(dso::modified_julian_day(mjds(gen)),
+                             ps(secs(gen)));
+  }
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+    run<double>("double      ", a, b, dummy);
+    run<long double>("long double ", a, b, dummy);
+    run<dso::DoubleDouble>("DoubleDouble", a, b, dummy);
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
+
+#endif
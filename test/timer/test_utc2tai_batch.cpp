@@ -0,0 +1,75 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+int main() {
+  /* time-ordered UTC epochs (e.g. SLR/DORIS records), 1990 to ~2030 */
+  constexpr const int num = 4'000'000;
+  std::mt19937_64 gen(17);
+  std::uniform_int_distribution<int> mjds(47892, 62502);
+  std::uniform_real_distribution<double> secs(0e0, 86400e0);
+  std::vector<dso::TwoPartDateUTC> utc(num);
+  for (auto &e : utc)
+    e = dso::TwoPartDateUTC(mjds(gen), dso::FractionalSeconds(secs(gen)));
+  std::sort(utc.begin(), utc.end());
+  std::vector<dso::TwoPartDate> tai(num);
+  std::vector<dso::TwoPartDateUTC> back(num);
+  const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int Y = 0; Y < 5; Y++) {
+    long dummy = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      tai[i] = utc[i].utc2tai();
+    auto stop = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(stop - start);
+    dummy += tai[num / 2].imjd();
+    std::cout << "TwoPartDateUTC::utc2tai      : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::utc2tai_batch(utc.data(), num, tai.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= tai[num / 2].imjd();
+    std::cout << "utc2tai_batch                : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::parallel_utc2tai_batch(utc.data(), num, tai.data(), threads);
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += tai[num / 2].imjd();
+    std::cout << "parallel_utc2tai_batch (" << threads
+              << ")   : " << duration.count() << "microsec\n";
+
+    start = high_resolution_clock::now();
+    for (int i = 0; i < num; i++)
+      back[i] = tai[i].tai2utc();
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy -= back[num / 2].imjd();
+    std::cout << "TwoPartDate::tai2utc         : " << duration.count()
+              << "microsec\n";
+
+    start = high_resolution_clock::now();
+    dso::tai2utc_batch(tai.data(), num, back.data());
+    stop = high_resolution_clock::now();
+    duration = duration_cast<microseconds>(stop - start);
+    dummy += back[num / 2].imjd();
+    std::cout << "tai2utc_batch                : " << duration.count()
+              << "microsec\n";
+    dummy -= tai[num / 2].imjd();
+
+    printf("Here is smthng irrelevant, dummy=%ld\n", dummy);
+  }
+
+  return 0;
+}
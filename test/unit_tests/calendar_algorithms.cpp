@@ -0,0 +1,79 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <climits>
+#include <random>
+
+using namespace dso;
+
+constexpr const long num_tests = 1'000'000;
+
+/* check all algorithms agree for the given MJD (the SOFA/Fliegel algorithms
+ * are only valid for MJD >= -2400001)
+ */
+void check(long mjd) {
+  int y, m, d;
+  core::mjd2ymd_eaf(mjd, y, m, d);
+  assert(core::ymd2mjd_eaf(y, m, d) == mjd);
+  if (mjd >= -2400001) {
+    int y2, m2, d2;
+    core::mjd2ymd_fvf(mjd, y2, m2, d2);
+    assert(y == y2 && m == m2 && d == d2);
+    assert(core::ymd2mjd_sofa(y, m, d) == mjd);
+    /* the selected algorithms */
+    assert(core::cal2mjd(y, m, d) == mjd);
+    const auto ymd = core::mjd2ymd(mjd);
+    assert(ymd.yr().as_underlying_type() == y);
+    assert(ymd.mn().as_underlying_type() == m);
+    assert(ymd.dm().as_underlying_type() == d);
+  }
+}
+
+/* compile-time evaluation */
+constexpr int eaf_year(long mjd) noexcept {
+  int y = 0, m = 0, d = 0;
+  core::mjd2ymd_eaf(mjd, y, m, d);
+  return y;
+}
+static_assert(core::ymd2mjd_eaf(1858, 11, 17) == 0);
+static_assert(core::ymd2mjd_eaf(2000, 1, 1) == 51544);
+static_assert(core::ymd2mjd_eaf(0, 3, 1) == -678881);
+static_assert(core::ymd2mjd_sofa(2000, 1, 1) == 51544);
+static_assert(core::cal2mjd(2000, 2, 29) == 51603);
+static_assert(eaf_year(51544) == 2000);
+static_assert(eaf_year(51543) == 1999);
+static_assert(core::mjd2ymd(51603).dm().as_underlying_type() == 29);
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+
+  /* every day from JD 0 to (approximately) year 10000 */
+  for (long mjd = -2400001; mjd < 3'000'000; mjd++)
+    check(mjd);
+
+  /* every day around the limits of modified_julian_day */
+  for (long mjd = INT_MIN; mjd < INT_MIN + 100'000L; mjd++)
+    check(mjd);
+  for (long mjd = INT_MAX - 100'000L; mjd <= INT_MAX; mjd++)
+    check(mjd);
+
+  /* random MJDs in the whole range of modified_julian_day */
+  std::uniform_int_distribution<int> mjdstr(INT_MIN, INT_MAX);
+  for (long i = 0; i < num_tests; i++)
+    check(mjdstr(gen));
+
+  /* invalid dates still throw */
+  try {
+    core::cal2mjd(2023, 2, 29);
+    assert(false);
+  } catch (std::out_of_range &) {
+  }
+  try {
+    core::cal2mjd(2024, 13, 1);
+    assert(false);
+  } catch (std::out_of_range &) {
+  }
+
+  return 0;
+}
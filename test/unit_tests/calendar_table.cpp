@@ -0,0 +1,81 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <stdexcept>
+
+using namespace dso;
+
+/* MJD of 2099/12/31 */
+constexpr const int DEC312099 = 88'068;
+
+/* to_ymd and to_ydoy must match the (arithmetic) calendar algorithms. Note
+ * that the arithmetic to_ydoy is only valid within [1901, 2099], while
+ * table records are always valid.
+ */
+void check(int mjd) {
+  const modified_julian_day d(mjd);
+  const auto ref = core::mjd2ymd(mjd);
+  const auto ymd = d.to_ymd();
+  assert(ymd.yr() == ref.yr());
+  assert(ymd.mn() == ref.mn());
+  assert(ymd.dm() == ref.dm());
+  if (!calendar_table::current()->contains(mjd) &&
+      (mjd < JAN11901 || mjd > DEC312099))
+    return;
+  const auto ydoy = d.to_ydoy();
+  const int iy = ref.yr().as_underlying_type();
+  assert(ydoy.yr() == ref.yr());
+  assert(ydoy.dy().as_underlying_type() ==
+         core::month_day[core::is_leap(iy)][ref.mn().as_underlying_type() -
+                                            1] +
+             ref.dm().as_underlying_type());
+}
+
+int main() {
+  /* default table, built on first use */
+  const CalendarTable *t = calendar_table::current();
+  assert(t == calendar_table::current());
+  assert(t->first_mjd() == calendar_table::DEFAULT_FIRST_MJD);
+  assert(t->last_mjd() == calendar_table::DEFAULT_LAST_MJD);
+  assert(!t->contains(calendar_table::DEFAULT_FIRST_MJD - 1));
+  assert(!t->contains(calendar_table::DEFAULT_LAST_MJD + 1));
+  assert(t->contains(calendar_table::DEFAULT_FIRST_MJD));
+  {
+    const auto r = t->record(calendar_table::DEFAULT_LAST_MJD);
+    assert(t->year(r) == 2050 && CalendarTable::month(r) == 12 &&
+           CalendarTable::dom(r) == 31 && CalendarTable::doy(r) == 365);
+  }
+
+  /* every day in (and around) the default window */
+  for (int mjd = calendar_table::DEFAULT_FIRST_MJD - 1000;
+       mjd <= calendar_table::DEFAULT_LAST_MJD + 1000; mjd++)
+    check(mjd);
+
+  /* a custom window, including negative MJDs */
+  const CalendarTable *t2 = calendar_table::set_window(-10'000, 10'000);
+  assert(calendar_table::current() == t2);
+  assert(t2->contains(-10'000) && t2->contains(10'000));
+  for (int mjd = -11'000; mjd <= 11'000; mjd++)
+    check(mjd);
+
+  /* window too large; current table left untouched */
+  try {
+    calendar_table::set_window(0, CalendarTable::MAX_DAYS);
+    assert(false);
+  } catch (std::invalid_argument &) {
+  }
+  assert(calendar_table::current() == t2);
+
+  /* empty window, i.e. no table lookups */
+  const CalendarTable *t3 = calendar_table::set_window(1, 0);
+  assert(!t3->contains(0) && !t3->contains(1));
+  for (int mjd = 44'000; mjd <= 46'000; mjd++)
+    check(mjd);
+
+  /* snapshots taken before remain valid */
+  assert(t->contains(50'000) && t2->contains(0));
+
+  /* compile-time evaluation does not use the table */
+  static_assert(modified_julian_day(51544).to_ymd().yr() == year(2000));
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+constexpr const int MIN_MJD = 41317;
+constexpr const int MAX_MJD = 61406 + 500;
+
+int main() {
+  /* all MJDs in range, in order (size is not a multiple of any SIMD width) */
+  std::vector<int> mjds;
+  for (int mjd = MIN_MJD; mjd < MAX_MJD; mjd++)
+    mjds.push_back(mjd);
+  if (!(mjds.size() % 2))
+    mjds.push_back(MAX_MJD);
+
+  std::vector<int> out(mjds.size()), extra(mjds.size()), out2(mjds.size());
+  dat_batch(mjds.data(), out.data(), extra.data(), mjds.size());
+  dat_batch(mjds.data(), out2.data(), mjds.size());
+  for (std::size_t i = 0; i < mjds.size(); i++) {
+    int e;
+    assert(out[i] == dat(modified_julian_day(mjds[i]), e));
+    assert(extra[i] == e);
+    assert(out2[i] == out[i]);
+  }
+
+  /* random MJDs, random batch sizes */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(MIN_MJD, MAX_MJD);
+  std::uniform_int_distribution<> nstr(0, 37);
+  for (int k = 0; k < 1000; k++) {
+    const std::size_t n = nstr(gen);
+    for (std::size_t i = 0; i < n; i++)
+      mjds[i] = mjdstr(gen);
+    dat_batch(mjds.data(), out.data(), extra.data(), n);
+    for (std::size_t i = 0; i < n; i++) {
+      int e;
+      assert(out[i] == dat(modified_julian_day(mjds[i]), e));
+      assert(extra[i] == e);
+    }
+  }
+
+  return 0;
+}
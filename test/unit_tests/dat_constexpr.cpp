@@ -0,0 +1,39 @@
+#include "calendar.hpp"
+#include <cassert>
+
+using namespace dso;
+
+/* ΔAT values computed at compile-time */
+static_assert(dat(modified_julian_day(41317)) == 10);
+static_assert(dat(modified_julian_day(57753)) == 36);
+static_assert(dat(modified_julian_day(57754)) == 37);
+static_assert(dat(year(2016), month(12)) == 36);
+static_assert(dat(year(2017), month(1)) == 37);
+static_assert(dat(ymd_date(year(1985), month(7), day_of_month(1))) == 23);
+static_assert(dat(datetime<nanoseconds>(year(2017), month(1), day_of_month(1),
+                                        nanoseconds(0))) == 37);
+
+/* a compile-time constant: ΔAT and extra seconds at a leap insertion day */
+constexpr int extra_at(int mjd) {
+  int extra = 0;
+  dat(modified_julian_day(mjd), extra);
+  return extra;
+}
+static_assert(extra_at(57753) == 1);
+static_assert(extra_at(57754) == 0);
+static_assert(extra_at(57752) == 0);
+
+int main() {
+  /* compile-time and run-time values must match */
+  for (int mjd = 41317; mjd < 61406 + 500; mjd++) {
+    int e1, e2;
+    const int d1 = core::builtin_dat(mjd, e1);
+    const int d2 = dat(modified_julian_day(mjd), e2);
+    assert(d1 == d2 && e1 == e2);
+    const auto ymd = core::mjd2ymd(mjd);
+    assert(core::builtin_dat_calendar(ymd.yr().as_underlying_type(),
+                                      ymd.mn().as_underlying_type()) ==
+           dat(ymd.yr(), ymd.mn()));
+  }
+  return 0;
+}
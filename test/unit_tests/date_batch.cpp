@@ -0,0 +1,72 @@
+#include "calendar.hpp"
+#include "date_batch.hpp"
+#include <cassert>
+#include <climits>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+constexpr const long num_tests = 1'000'000;
+
+void check(const std::vector<int> &mjds) {
+  const std::size_t n = mjds.size();
+  std::vector<int> y(n), m(n), d(n), y2(n), doy(n);
+  mjd2ymd_batch(mjds.data(), y.data(), m.data(), d.data(), n);
+  mjd2ydoy_batch(mjds.data(), y2.data(), doy.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    const auto ymd = core::mjd2ymd(mjds[i]);
+    assert(ymd.yr().as_underlying_type() == y[i]);
+    assert(ymd.mn().as_underlying_type() == m[i]);
+    assert(ymd.dm().as_underlying_type() == d[i]);
+    const auto ydoy = modified_julian_day(mjds[i]).to_ydoy();
+    assert(ydoy.yr().as_underlying_type() == y2[i]);
+    assert(ydoy.dy().as_underlying_type() == doy[i]);
+  }
+}
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+
+  /* consecutive days, around the limits of the vectorized ranges */
+  for (int lim : {BATCH_MJD2YMD_MIN, BATCH_MJD2YMD_MAX, BATCH_MJD2YDOY_MIN,
+                  BATCH_MJD2YDOY_MAX, 0, 51544}) {
+    std::vector<int> mjds;
+    for (int mjd = lim - 1000; mjd < lim + 1001; mjd++)
+      mjds.push_back(mjd);
+    check(mjds);
+  }
+
+  /* random MJDs in the modern era, and in the vectorized range */
+  {
+    std::uniform_int_distribution<> mjdstr(15385, 100000);
+    std::vector<int> mjds(num_tests);
+    for (auto &mjd : mjds)
+      mjd = mjdstr(gen);
+    check(mjds);
+  }
+  {
+    std::uniform_int_distribution<> mjdstr(BATCH_MJD2YMD_MIN,
+                                           BATCH_MJD2YMD_MAX);
+    std::vector<int> mjds(num_tests);
+    for (auto &mjd : mjds)
+      mjd = mjdstr(gen);
+    check(mjds);
+  }
+
+  /* random sizes, with a few MJDs out of range */
+  {
+    std::uniform_int_distribution<> mjdstr(-3'000'000, 100000);
+    std::uniform_int_distribution<> nstr(0, 67);
+    for (int k = 0; k < 1000; k++) {
+      std::vector<int> mjds(nstr(gen));
+      for (auto &mjd : mjds)
+        mjd = mjdstr(gen);
+      check(mjds);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include "calendar.hpp"
+#include "date_batch.hpp"
+#include <cassert>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+constexpr const long num_tests = 1'000'000;
+
+/* reference (scalar, throwing) validation and transformation */
+bool ref_ymd(int y, int m, int d, long &mjd) {
+  if (y < BATCH_CAL_YEAR_MIN || y > BATCH_CAL_YEAR_MAX)
+    return false;
+  try {
+    mjd = core::cal2mjd(y, m, d);
+  } catch (std::out_of_range &) {
+    return false;
+  }
+  return true;
+}
+
+bool ref_ydoy(int y, int doy, long &mjd) {
+  if (y < BATCH_CAL_YEAR_MIN || y > BATCH_CAL_YEAR_MAX)
+    return false;
+  if (doy < 1 || doy > 365 + core::is_leap(y))
+    return false;
+  mjd = core::cal2mjd(y, 1, 1) + doy - 1;
+  /* identical to ydoy2mjd within its range of validity */
+  if (y >= 1900 && y <= 2100)
+    assert(mjd == core::ydoy2mjd(y, doy));
+  return true;
+}
+
+void check(const std::vector<int> &y, const std::vector<int> &m,
+           const std::vector<int> &d, const std::vector<int> &doy) {
+  const std::size_t n = y.size();
+  std::vector<int> mjd(n);
+  std::vector<std::uint64_t> valid(batch_mask_words(n));
+
+  std::size_t invalid =
+      ymd_to_mjd_batch(y.data(), m.data(), d.data(), mjd.data(), valid.data(),
+                       n);
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    long ref = 0;
+    const bool ok = ref_ymd(y[i], m[i], d[i], ref);
+    assert(batch_mask_test(valid.data(), i) == ok);
+    assert(mjd[i] == (ok ? ref : 0));
+    count += !ok;
+  }
+  assert(count == invalid);
+
+  invalid = ydoy_to_mjd_batch(y.data(), doy.data(), mjd.data(), valid.data(),
+                              n);
+  count = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    long ref = 0;
+    const bool ok = ref_ydoy(y[i], doy[i], ref);
+    assert(batch_mask_test(valid.data(), i) == ok);
+    assert(mjd[i] == (ok ? ref : 0));
+    count += !ok;
+  }
+  assert(count == invalid);
+}
+
+int main() {
+  /* Generators for random numbers ... */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+
+  /* every day of every year around the year limits and the Gregorian rules
+   * (leap years, centuries, 400-year cycles)
+   */
+  for (int yr : {BATCH_CAL_YEAR_MIN, BATCH_CAL_YEAR_MAX, 1600, 1900, 2000,
+                 2100}) {
+    std::vector<int> y, m, d, doy;
+    for (int iy = yr - 5; iy <= yr + 5; iy++) {
+      for (int im = 0; im <= 13; im++) {
+        for (int id = -1; id <= 32; id++) {
+          y.push_back(iy);
+          m.push_back(im);
+          d.push_back(id);
+          doy.push_back(id * 12 + im);
+        }
+      }
+    }
+    check(y, m, d, doy);
+  }
+
+  /* random dates, mostly valid, with odd sizes */
+  std::uniform_int_distribution<> ystr(-10'000, 10'000);
+  std::uniform_int_distribution<> mstr(-1, 14);
+  std::uniform_int_distribution<> dstr(-1, 33);
+  std::uniform_int_distribution<> doystr(-1, 368);
+  std::uniform_int_distribution<> nstr(0, 131);
+  long tested = 0;
+  while (tested < num_tests) {
+    const int n = nstr(gen);
+    std::vector<int> y(n), m(n), d(n), doy(n);
+    for (int i = 0; i < n; i++) {
+      y[i] = ystr(gen);
+      m[i] = mstr(gen);
+      d[i] = dstr(gen);
+      doy[i] = doystr(gen);
+    }
+    check(y, m, d, doy);
+    tested += n;
+  }
+
+  return 0;
+}
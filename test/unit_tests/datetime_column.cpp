@@ -0,0 +1,118 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace dso;
+using ns = nanoseconds;
+
+int main() {
+  constexpr const int num = 100'001;
+  std::mt19937_64 gen(2015);
+  std::uniform_int_distribution<int> dmjd(44244, 66154);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  std::uniform_int_distribution<long> dadd(-3 * ns::max_in_day,
+                                           3 * ns::max_in_day);
+
+  std::vector<datetime<ns>> d;
+  for (int i = 0; i < num; i++)
+    d.emplace_back(modified_julian_day(dmjd(gen)), ns(dsec(gen)));
+  /* a few duplicate MJDs, for min/max */
+  d[10] = datetime<ns>(modified_julian_day(44244), ns(5));
+  d[20] = datetime<ns>(modified_julian_day(44244), ns(3));
+  d[30] = datetime<ns>(modified_julian_day(44244), ns(3));
+
+  datetime_column<ns> col(d.data(), d.size());
+  const datetime_column<ns> &ccol = col;
+  assert(col.size() == d.size());
+  assert(reinterpret_cast<std::uintptr_t>(col.mjd_data()) %
+             core::COLUMN_ALIGNMENT ==
+         0);
+  assert(reinterpret_cast<std::uintptr_t>(col.sec_data()) %
+             core::COLUMN_ALIGNMENT ==
+         0);
+  for (int i = 0; i < num; i++)
+    assert(ccol[i] == d[i]);
+
+  /* min/max */
+  assert(col.argmin() == 20);
+  assert(col.min() == *std::min_element(d.begin(), d.end()));
+  assert(col.max() == *std::max_element(d.begin(), d.end()));
+  assert(col.argmax() == (std::size_t)(std::max_element(d.begin(), d.end()) -
+                                       d.begin()));
+
+  /* differences to a reference epoch */
+  const datetime<ns> ref(modified_julian_day(55555), ns(123'456'789L));
+  std::vector<double> fdt(num);
+  std::vector<ns> idt(num);
+  col.diff(ref, fdt.data());
+  col.diff(ref, idt.data());
+  for (int i = 0; i < num; i++) {
+    assert(idt[i] == (d[i] - ref).signed_total_sec());
+    const double f =
+        d[i].diff<DateTimeDifferenceType::FractionalSeconds>(ref).seconds();
+    assert(std::abs(fdt[i] - f) < 1e-6);
+  }
+
+  /* filter and select */
+  const datetime<ns> lo(modified_julian_day(50000), ns(0));
+  const datetime<ns> hi(modified_julian_day(60000), ns(ns::max_in_day / 2));
+  std::vector<std::uint64_t> mask(batch_mask_words(num));
+  const std::size_t count = col.filter(lo, hi, mask.data());
+  std::size_t expected = 0;
+  for (int i = 0; i < num; i++) {
+    const bool in = (d[i] >= lo && d[i] < hi);
+    assert(batch_mask_test(mask.data(), i) == in);
+    expected += in;
+  }
+  assert(count == expected);
+  const auto sel = col.select(mask.data());
+  assert(sel.size() == count);
+  for (std::size_t i = 0, j = 0; i < (std::size_t)num; i++)
+    if (batch_mask_test(mask.data(), i))
+      assert(sel[j++] == d[i]);
+
+  /* add the same seconds to all elements */
+  const ns s(dadd(gen));
+  col.add(s);
+  for (int i = 0; i < num; i++) {
+    datetime<ns> t(d[i]);
+    t.add_seconds(s);
+    assert(ccol[i] == t);
+  }
+
+  /* add per-element seconds */
+  std::vector<ns> ds(num);
+  for (int i = 0; i < num; i++)
+    ds[i] = ns(dadd(gen));
+  col = datetime_column<ns>(d.data(), d.size());
+  col.add(ds.data());
+  std::vector<datetime<ns>> back(num);
+  col.to_datetimes(back.data());
+  for (int i = 0; i < num; i++) {
+    datetime<ns> t(d[i]);
+    t.add_seconds(ds[i]);
+    assert(back[i] == t);
+  }
+
+  /* proxies and raw access */
+  col[0] = d[1];
+  assert(col[0].value() == d[1]);
+  col[1] = col[2];
+  assert(static_cast<datetime<ns>>(col[1]) == back[2]);
+  col.sec_data()[3] = -1;
+  col.mjd_data()[3] = 60000;
+  col.normalize();
+  assert(ccol[3] ==
+         datetime<ns>(modified_julian_day(59999), ns(ns::max_in_day - 1)));
+
+  /* empty column */
+  datetime_column<ns> empty;
+  assert(empty.argmin() == 0 && empty.argmax() == 0);
+  empty.push_back(ref);
+  assert(empty.size() == 1 && empty.min() == ref && empty.max() == ref);
+
+  return 0;
+}
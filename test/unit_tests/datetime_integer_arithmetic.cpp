@@ -0,0 +1,95 @@
+#include "calendar.hpp"
+#include "core/int128.hpp"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <random>
+
+/* Arithmetic on datetime<S> and datetime_interval<S> over the whole range
+ * of dso::max_days_allowed<S>(), checked against exact (128-bit) integer
+ * computations.
+ */
+
+#ifndef DATETIME_HAS_INT128
+/* reference results are computed with 128-bit integers */
+int main() { return 0; }
+#else
+
+using namespace dso;
+using i128 = core::int128_t;
+
+template <typename S> void check(int num) {
+  using I = typename S::underlying_type;
+  constexpr const I F = S::max_in_day;
+  /* max days in an interval; also keep MJDs in the range of int */
+  const I D = std::min<I>(max_days_allowed<S>() - 1, INT_MAX / 4);
+  std::mt19937_64 gen(D);
+  std::uniform_int_distribution<I> dmjd(-D / 2, D / 2);
+  std::uniform_int_distribution<I> dsec(0, F - 1);
+  std::uniform_int_distribution<I> ddelta(-D * F, D * F);
+  std::uniform_int_distribution<I> dday(-D, D);
+
+  for (int i = 0; i < num; i++) {
+    const int mjd = static_cast<int>(dmjd(gen));
+    const I sec = dsec(gen);
+    /* every other sample, an exact (negative or positive) number of days */
+    const I delta = (i % 2) ? ddelta(gen) : dday(gen) * F;
+    const datetime<S> d1{modified_julian_day(mjd), S(sec)};
+
+    /* addition, against exact integer computation */
+    datetime<S> d2(d1);
+    d2.add_seconds(S(delta));
+    const i128 total = static_cast<i128>(mjd) * F + sec + delta;
+    i128 days = total / F;
+    i128 rem = total - days * F;
+    if (rem < 0) {
+      rem += F;
+      --days;
+    }
+    assert(d2.imjd().as_underlying_type() == static_cast<int>(days));
+    assert(d2.sec().as_underlying_type() == static_cast<I>(rem));
+
+    /* normalizing constructor */
+    assert(datetime<S>(modified_julian_day(mjd), S(sec + delta)) == d2);
+
+    /* difference, as an interval */
+    const datetime_interval<S> dt = d2 - d1;
+    assert(dt.signed_total_sec().as_underlying_type() == delta);
+    assert(dt.sign() == ((delta < 0) ? -1 : 1));
+    assert(dt.sec() >= S(0) && dt.sec() < S(F));
+    assert(d1 + dt == d2);
+    datetime<S> d3(d1);
+    d3 += dt;
+    assert(d3 == d2);
+    assert((d1 - d2).signed_total_sec().as_underlying_type() == -delta);
+    assert(d2 + (d1 - d2) == d1);
+
+    /* interval from seconds */
+    const datetime_interval<S> dti{S(delta)};
+    assert(dti.signed_total_sec().as_underlying_type() == delta);
+    assert(dti.days() == dt.days() && dti.sec() == dt.sec());
+  }
+
+  /* limits of the range */
+  const datetime<S> d0{modified_julian_day(0), S(0)};
+  for (I delta : {D * F, -D * F, D * F - 1, -D * F + 1, -F, F - 1, I(-1)}) {
+    datetime<S> d(d0);
+    d.add_seconds(S(delta));
+    assert(d.sec() >= S(0) && d.sec() < S(F));
+    assert(static_cast<i128>(d.imjd().as_underlying_type()) * F +
+               d.sec().as_underlying_type() ==
+           static_cast<i128>(delta));
+    assert((d - d0).signed_total_sec().as_underlying_type() == delta);
+  }
+}
+
+int main() {
+  check<seconds>(200'000);
+  check<milliseconds>(200'000);
+  check<microseconds>(200'000);
+  check<nanoseconds>(200'000);
+  check<picoseconds>(200'000);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <stdexcept>
+
+using namespace dso;
+using namespace dso::literals;
+
+/* all of these are evaluated at compile time */
+constexpr auto t1 = "2017-01-01T00:00:00.000000001"_tai_ns;
+static_assert(t1.imjd() == modified_julian_day(57754));
+static_assert(t1.sec() == nanoseconds(1));
+
+constexpr auto t2 = "2017-01-01 12:30:15"_tai_s;
+static_assert(t2.imjd() == modified_julian_day(57754));
+static_assert(t2.sec() == seconds(12 * 3600 + 30 * 60 + 15));
+
+/* date only */
+static_assert("2017-01-01"_tai_ms ==
+              datetime<milliseconds>::non_normalize_construct(
+                  modified_julian_day(57754), milliseconds(0)));
+
+/* fractional seconds; trailing zeros beyond resolution are fine */
+static_assert("2000-01-01T23:59:59.5"_tai_ms.sec() ==
+              milliseconds(86'399'500L));
+static_assert("2000-01-01T23:59:59.123456000"_tai_us.sec() ==
+              microseconds(86'399'123'456L));
+static_assert("2000-01-01T00:00:00.0"_tai_s.sec() == seconds(0));
+
+/* leap year */
+static_assert("2024-02-29T00:00:00"_tai_ns.imjd() ==
+              modified_julian_day(60369));
+
+/* year and day of year */
+constexpr auto d1 = "2024:123:00000"_ydoy;
+static_assert(d1.imjd() == modified_julian_day(60432));
+static_assert(d1.sec() == nanoseconds(0));
+static_assert("2024:366:86399.999999999"_ydoy.sec() ==
+              nanoseconds(nanoseconds::max_in_day - 1));
+static_assert("2024:001"_ydoy.imjd() == modified_julian_day(60310));
+
+/* TwoPartDate */
+constexpr auto tp = "2017-01-01T06:00:00.25"_tpd;
+static_assert(tp.imjd() == 57754);
+static_assert(tp.seconds().seconds() == 21600.25e0);
+constexpr auto tpy = "2024:123:21600.25"_ydoy_tpd;
+static_assert(tpy.imjd() == 60432);
+static_assert(tpy.seconds().seconds() == 21600.25e0);
+
+int main() {
+  /* same as the run-time constructors */
+  assert("2023-07-15T10:20:30.123456789"_tai_ns ==
+         datetime<nanoseconds>(year(2023), month(7), day_of_month(15),
+                               nanoseconds(37'230'123'456'789L)));
+  assert("2023:196:37230.123456789"_ydoy ==
+         datetime<nanoseconds>(year(2023), day_of_year(196),
+                               nanoseconds(37'230'123'456'789L)));
+
+  /* the parsers are usable at run-time, where malformed input throws */
+  const char *bad[] = {"2017-13-01T00:00:00", "2017-02-29T00:00:00",
+                       "2017-01-01T24:00:00", "2017-01-01T00:60:00",
+                       "2017-01-01T00:00:60", "2017-01-01T00:00:00.",
+                       "2017-01-01T00:00:00Z", "2017-1-01",
+                       "2017-01-01X00:00:00",  "2017-01-01T00:00:00.0000000001"};
+  for (const char *s : bad) {
+    std::size_t len = 0;
+    while (s[len])
+      ++len;
+    bool thrown = false;
+    try {
+      core::parse_iso_epoch<nanoseconds>(s, len);
+    } catch (std::invalid_argument &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+  const char *badydoy[] = {"2023:366", "2023:000", "2023:001:86400",
+                           "2023:01", "2023:001:0000"};
+  for (const char *s : badydoy) {
+    std::size_t len = 0;
+    while (s[len])
+      ++len;
+    bool thrown = false;
+    try {
+      core::parse_ydoy_epoch<nanoseconds>(s, len);
+    } catch (std::invalid_argument &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  return 0;
+}
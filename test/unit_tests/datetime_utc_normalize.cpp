@@ -0,0 +1,68 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <random>
+
+using namespace dso;
+using nsec = nanoseconds;
+
+constexpr const long num_tests = 100'000;
+
+/* normalize by removing/adding one (UTC) day at a time */
+void loop_normalize(int &mjd, long &sec) {
+  constexpr const long F = nsec::sec_factor<long>();
+  int extra;
+  dat(modified_julian_day(mjd), extra);
+  while (sec >= nsec::max_in_day + extra * F) {
+    sec -= nsec::max_in_day + extra * F;
+    ++mjd;
+    dat(modified_julian_day(mjd), extra);
+  }
+  while (sec < 0) {
+    --mjd;
+    dat(modified_julian_day(mjd), extra);
+    sec += nsec::max_in_day + extra * F;
+  }
+}
+
+/* normalization at compile-time; 2016/12/31 is a leap insertion day */
+static_assert(datetime_utc<seconds>(modified_julian_day(57753), seconds(86400))
+                  .imjd() == modified_julian_day(57753));
+static_assert(datetime_utc<seconds>(modified_julian_day(57753), seconds(86401))
+                  .sec() == seconds(0));
+
+int main() {
+  /* around a leap second */
+  {
+    datetime_utc<seconds> d(modified_julian_day(57753), seconds(86400));
+    assert(d.imjd() == modified_julian_day(57753) && d.sec() == seconds(86400));
+    d.add_seconds(seconds(1));
+    assert(d.imjd() == modified_julian_day(57754) && d.sec() == seconds(0));
+    d.add_seconds(seconds(-1));
+    assert(d.imjd() == modified_julian_day(57753) && d.sec() == seconds(86400));
+    d.add_seconds(seconds(-86401));
+    assert(d.imjd() == modified_julian_day(57752) && d.sec() == seconds(86399));
+    d.add_seconds(seconds(1 + 86401 + 86400));
+    assert(d.imjd() == modified_julian_day(57755) && d.sec() == seconds(0));
+  }
+
+  /* large random steps, forward and backward */
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(41317 + 1000, 61406);
+  std::uniform_int_distribution<long> secstr(0, nsec::max_in_day - 1);
+  std::uniform_int_distribution<long> stepstr(-900 * nsec::max_in_day,
+                                              900 * nsec::max_in_day);
+  for (long i = 0; i < num_tests; i++) {
+    int mjd = mjdstr(gen);
+    long sec = secstr(gen);
+    const long step = stepstr(gen);
+    datetime_utc<nsec> d{modified_julian_day(mjd), nsec(sec)};
+    d.add_seconds(nsec(step));
+    sec += step;
+    loop_normalize(mjd, sec);
+    assert(d.imjd() == modified_julian_day(mjd));
+    assert(d.sec() == nsec(sec));
+  }
+
+  return 0;
+}
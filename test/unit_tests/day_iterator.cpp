@@ -0,0 +1,80 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+using namespace dso;
+
+int main() {
+  /* every day from 1972/01/01 to 2100/12/31, against the per-day
+   * transformations
+   */
+  const modified_julian_day first(41317);
+  const modified_julian_day last(88434);
+  const day_range days(first, last);
+  assert(days.size() == 88434 - 41317);
+
+  int mjd = first.as_underlying_type();
+  for (const auto &day : days) {
+    const modified_julian_day d(mjd);
+    assert(day.mjd() == d);
+    assert(day.ymd() == d.to_ymd());
+    const auto ymd = d.to_ymd();
+    const int iy = ymd.yr().as_underlying_type();
+    assert(day.dy().as_underlying_type() ==
+           core::month_day[core::is_leap(iy)][ymd.mn().as_underlying_type() -
+                                              1] +
+               ymd.dm().as_underlying_type());
+    int extra;
+    assert(day.dat() == dat(d, extra));
+    assert(day.extra_seconds() == extra);
+    assert(day.is_leap_insertion_day() == d.is_leap_insertion_day());
+    if (mjd >= JAN61980) {
+      const datetime<nanoseconds> t(d, nanoseconds(0));
+      nanoseconds sow;
+      const gps_week w = t.gps_wsow(sow);
+      assert(day.gps_wk() == w);
+      assert(day.gps_dow() ==
+             sow.as_underlying_type() / nanoseconds::max_in_day);
+    }
+    ++mjd;
+  }
+  assert(mjd == last.as_underlying_type());
+
+  /* days before the GPS epoch; day of week stays in [0,6] */
+  {
+    day_iterator it(modified_julian_day(JAN61980 - 8));
+    assert(it->gps_wk() == gps_week(-2) && it->gps_dow() == 6);
+    ++it;
+    assert(it->gps_wk() == gps_week(-1) && it->gps_dow() == 0);
+    std::advance(it, 7);
+    assert(it->gps_wk() == gps_week(0) && it->gps_dow() == 0);
+    assert(it->mjd() == modified_julian_day(JAN61980));
+  }
+
+  /* standard algorithms: leap second insertion days since 1972 */
+  const auto num_leap_days =
+      std::count_if(days.begin(), days.end(), [](const calendar_day &day) {
+        return day.is_leap_insertion_day();
+      });
+  assert(num_leap_days == TOTAL_LEAP_SEC_INSERTION_DATES - 1);
+  const auto it = std::find_if(
+      days.begin(), days.end(),
+      [](const calendar_day &day) { return day.dat() == 37; });
+  assert(it->ymd() == ymd_date(year(2017), month(1), day_of_month(1)));
+  assert(std::distance(days.begin(), days.end()) ==
+         static_cast<long>(days.size()));
+
+  /* post-increment */
+  day_iterator d1(modified_julian_day(51543));
+  const auto d0 = d1++;
+  assert(d0->dy() == day_of_year(365) && d0->yr() == year(1999));
+  assert(d1->dy() == day_of_year(1) && d1->yr() == year(2000));
+  assert(d0 != d1);
+
+  /* empty range */
+  const day_range empty(last, first);
+  assert(empty.size() == 0 && empty.begin() == empty.end());
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include "calendar.hpp"
+#include "core/int128.hpp"
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef DATETIME_HAS_INT128
+/* reference results are computed with 128-bit integers */
+int main() { return 0; }
+#else
+
+using namespace dso;
+using DT = DateTimeDifferenceType;
+
+/* check that a is within one ulp of the (long double) reference */
+bool within_ulp(double a, long double ref) {
+  const double r = static_cast<double>(ref);
+  return std::abs(static_cast<long double>(a) - ref) <=
+         static_cast<long double>(std::nextafter(std::abs(r), INFINITY) -
+                                  std::abs(r));
+}
+
+template <typename S> void check(int mjd_span, int num) {
+  using I = typename S::underlying_type;
+  std::mt19937_64 gen(17);
+  std::uniform_int_distribution<int> dmjd(55555 - mjd_span, 55555 + mjd_span);
+  std::uniform_int_distribution<I> dsec(0, S::max_in_day - 1);
+  std::vector<datetime<S>> d;
+  for (int i = 0; i < num; i++)
+    d.emplace_back(modified_julian_day(dmjd(gen)), S(dsec(gen)));
+  /* the reference itself, and epochs very close to it */
+  const datetime<S> ref(modified_julian_day(55555), S(dsec(gen)));
+  const S one_sec(S::template sec_factor<I>());
+  d.push_back(ref);
+  d.push_back(ref);
+  d.back().add_seconds(one_sec);
+  d.push_back(ref);
+  d.back().add_seconds(S(0) - one_sec);
+
+  const std::size_t n = d.size();
+  std::vector<double> sec(n), days(n), years(n);
+  diff_batch<DT::FractionalSeconds>(d.data(), n, ref, sec.data());
+  diff_batch<DT::FractionalDays>(d.data(), n, ref, days.data());
+  diff_batch<DT::FractionalYears>(d.data(), n, ref, years.data());
+  for (std::size_t i = 0; i < n; i++) {
+    /* exact difference in ticks */
+    const core::int128_t ticks =
+        static_cast<core::int128_t>(d[i].imjd().as_underlying_type() -
+                                    ref.imjd().as_underlying_type()) *
+            S::max_in_day +
+        (d[i].sec().as_underlying_type() - ref.sec().as_underlying_type());
+    const long double lsec =
+        static_cast<long double>(ticks) / S::template sec_factor<long double>();
+    const long double lday =
+        static_cast<long double>(ticks) / static_cast<long double>(S::max_in_day);
+    assert(within_ulp(sec[i], lsec));
+    assert(within_ulp(days[i], lday));
+    assert(std::abs(years[i] - static_cast<double>(lday / 365.25L)) <=
+           2 * std::abs(years[i]) * 2.3e-16);
+    /* against datetime<S>::diff */
+    const double ds = d[i].template diff<DT::FractionalSeconds>(ref).seconds();
+    assert(std::abs(ds - sec[i]) <= 4e-16 * std::abs(ds) + 1e-12);
+    const double dd = d[i].template diff<DT::FractionalDays>(ref).days();
+    assert(std::abs(dd - days[i]) <= 4e-16 * std::abs(dd) + 1e-17);
+  }
+  assert(sec[num] == 0e0 && days[num] == 0e0);
+  assert(sec[num + 1] == 1e0);
+  assert(sec[num + 2] == -1e0);
+}
+
+int main() {
+  check<seconds>(1'000'000, 100'000);
+  check<milliseconds>(1'000'000, 100'000);
+  check<microseconds>(100'000, 100'000);
+  check<nanoseconds>(50'000, 100'000);
+  check<picoseconds>(50, 100'000);
+
+  /* TwoPartDate */
+  {
+    std::mt19937_64 gen(17);
+    std::uniform_int_distribution<int> dmjd(40000, 70000);
+    std::uniform_real_distribution<double> dsec(0e0, 86400e0);
+    const int num = 200'000;
+    std::vector<TwoPartDate> d;
+    for (int i = 0; i < num; i++)
+      d.emplace_back(dmjd(gen), FractionalSeconds(dsec(gen)));
+    const TwoPartDate ref(55555, FractionalSeconds(dsec(gen)));
+    d.push_back(ref);
+    std::vector<double> sec(d.size()), days(d.size());
+    diff_batch<DT::FractionalSeconds>(d.data(), d.size(), ref, sec.data());
+    diff_batch<DT::FractionalDays>(d.data(), d.size(), ref, days.data());
+    for (std::size_t i = 0; i < d.size(); i++) {
+      const long double lsec =
+          static_cast<long double>(d[i].imjd() - ref.imjd()) * 86400.L +
+          (static_cast<long double>(d[i].seconds().seconds()) -
+           static_cast<long double>(ref.seconds().seconds()));
+      assert(within_ulp(sec[i], lsec));
+      assert(within_ulp(days[i], lsec / 86400.L));
+      /* against TwoPartDate::diff */
+      const double ds = d[i].diff<DT::FractionalSeconds>(ref).seconds();
+      assert(std::abs(ds - sec[i]) <= 4e-16 * std::abs(ds) + 1e-11);
+    }
+    assert(sec[num] == 0e0 && days[num] == 0e0);
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace dso;
+using ns = nanoseconds;
+
+/* brute-force nearest, earlier epoch on ties */
+template <typename T, typename Diff>
+std::size_t nearest_ref(const std::vector<T> &a, const T &t, Diff &&diff) {
+  if (a.empty())
+    return EpochIndex<T>::npos;
+  const std::size_t c = std::lower_bound(a.begin(), a.end(), t) - a.begin();
+  if (c == 0)
+    return 0;
+  if (c == a.size())
+    return c - 1;
+  return (diff(t, a[c - 1]) <= diff(a[c], t)) ? c - 1 : c;
+}
+
+double diff_tol(ns tol) { return tol.as_underlying_type() * 1e-9; }
+double diff_tol(FractionalSeconds tol) { return tol.seconds(); }
+
+template <typename T, typename Diff, typename Tol>
+void check(const std::vector<T> &a, const std::vector<T> &q, Tol tol,
+           [[maybe_unused]] Diff &&diff) {
+  const EpochIndex<T> idx(a.data(), a.size());
+  const std::size_t npos = EpochIndex<T>::npos;
+  for (const auto &t : q) {
+    const std::size_t lb = std::lower_bound(a.begin(), a.end(), t) - a.begin();
+    const std::size_t ub = std::upper_bound(a.begin(), a.end(), t) - a.begin();
+    assert(idx.lower_bound(t) == lb);
+    assert(idx.upper_bound(t) == ub);
+    assert(idx.ceil(t) == ((lb < a.size()) ? lb : npos));
+    assert(idx.floor(t) == ((ub > 0) ? ub - 1 : npos));
+    assert(idx.nearest(t) == nearest_ref(a, t, diff));
+    const auto w = idx.window(t, tol);
+    /* all epochs in [first, last) are within the window, the ones just
+     * outside are not (the array is sorted) */
+    const double dt = diff_tol(tol);
+    assert(w.first <= w.second);
+    for (std::size_t i = w.first; i < w.second; i++)
+      assert(std::abs(diff(a[i], t)) <= dt * (1 + 1e-9));
+    if (w.first > 0)
+      assert(diff(t, a[w.first - 1]) > dt * (1 - 1e-9));
+    if (w.second < a.size())
+      assert(diff(a[w.second], t) > dt * (1 - 1e-9));
+  }
+
+  /* batched, sorted and unsorted streams */
+  for (int sorted = 0; sorted < 2; sorted++) {
+    std::vector<T> qs(q);
+    if (sorted)
+      std::sort(qs.begin(), qs.end());
+    std::vector<std::size_t> f(qs.size()), c(qs.size()), nr(qs.size()),
+        w1(qs.size()), w2(qs.size());
+    idx.floor_batch(qs.data(), qs.size(), f.data());
+    idx.ceil_batch(qs.data(), qs.size(), c.data());
+    idx.nearest_batch(qs.data(), qs.size(), nr.data());
+    idx.window_batch(qs.data(), qs.size(), tol, w1.data(), w2.data());
+    for (std::size_t i = 0; i < qs.size(); i++) {
+      assert(f[i] == idx.floor(qs[i]));
+      assert(c[i] == idx.ceil(qs[i]));
+      assert(nr[i] == idx.nearest(qs[i]));
+      const auto w = idx.window(qs[i], tol);
+      assert(w1[i] == w.first && w2[i] == w.second);
+    }
+  }
+}
+
+int main() {
+  std::mt19937_64 gen(2020);
+
+  /* an (almost) uniform 30-sec grid, with gaps and duplicates */
+  std::vector<datetime<ns>> a;
+  datetime<ns> t0{modified_julian_day(59000), ns(0)};
+  std::uniform_int_distribution<int> djitter(-1000, 1000);
+  std::uniform_int_distribution<int> dgap(0, 199);
+  for (int i = 0; i < 20'000; i++) {
+    datetime<ns> t(t0);
+    t.add_seconds(ns(i * 30'000'000'000L + djitter(gen)));
+    const int g = dgap(gen);
+    if (g == 0)
+      continue; /* gap */
+    a.push_back(t);
+    if (g == 1)
+      a.push_back(t); /* duplicate */
+  }
+  /* a long gap, then a denser part */
+  t0 = a.back();
+  for (int i = 0; i < 5'000; i++) {
+    datetime<ns> t(t0);
+    t.add_seconds(ns(86400L * 30 * 1'000'000'000L + i * 1'000'000'000L));
+    a.push_back(t);
+  }
+  std::sort(a.begin(), a.end());
+
+  std::vector<datetime<ns>> q;
+  std::uniform_int_distribution<long> dq(
+      -86400L * 1'000'000'000L,
+      (a.back() - a.front()).signed_total_sec().as_underlying_type() +
+          86400L * 1'000'000'000L);
+  for (int i = 0; i < 2'000; i++) {
+    datetime<ns> t(a.front());
+    t.add_seconds(ns(dq(gen)));
+    q.push_back(t);
+  }
+  /* exact hits */
+  for (int i = 0; i < 500; i++)
+    q.push_back(a[(i * 97) % a.size()]);
+
+  const auto ddiff = [](const datetime<ns> &x, const datetime<ns> &y) {
+    return x.diff<DateTimeDifferenceType::FractionalSeconds>(y).seconds();
+  };
+  check(a, q, ns(500'000'000L), ddiff);
+
+  /* TwoPartDate */
+  std::vector<TwoPartDate> ta, tq;
+  for (const auto &t : a)
+    ta.emplace_back(t);
+  for (const auto &t : q)
+    tq.emplace_back(t);
+  const auto tdiff = [](const TwoPartDate &x, const TwoPartDate &y) {
+    return x.diff<DateTimeDifferenceType::FractionalSeconds>(y).seconds();
+  };
+  check(ta, tq, FractionalSeconds(0.5e0), tdiff);
+
+  /* small and empty arrays */
+  {
+    std::vector<datetime<ns>> e;
+    check(e, q, ns(1), ddiff);
+    std::vector<datetime<ns>> one(1, a[10]);
+    check(one, q, ns(1), ddiff);
+    std::vector<datetime<ns>> few(a.begin(), a.begin() + 5);
+    check(few, q, ns(30'000'000'000L), ddiff);
+  }
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace dso;
+using ns = nanoseconds;
+
+int main() {
+  const datetime<ns> t0{modified_julian_day(59000), ns(86'000'000'000'000L)};
+
+  /* datetime<S>, (start, step, count); against repeated add_seconds */
+  for (long step : {30'000'000'000L, 1L, 86'400'000'000'000L,
+                    123'456'789'012'345L, -30'000'000'000L, -7L}) {
+    const epoch_range r(t0, ns(step), 10'000);
+    assert(r.size() == 10'000);
+    datetime<ns> t(t0);
+    std::size_t i = 0;
+    for (const auto &e : r) {
+      assert(e == t);
+      assert(r[i] == t);
+      t.add_seconds(ns(step));
+      ++i;
+    }
+    assert(i == r.size());
+    assert(r.back() == r[r.size() - 1]);
+  }
+
+  /* large indexes (128-bit products) */
+  {
+    const epoch_range<datetime<picoseconds>, picoseconds> r(
+        datetime<picoseconds>{modified_julian_day(50000), picoseconds(5)},
+        picoseconds(picoseconds::max_in_day - 1), 1'000'000);
+    const auto e = r[999'999];
+    /* 999'999 * (F - 1) = 999'999 * F - 999'999 */
+    const datetime<picoseconds> x{
+        modified_julian_day(50000 + 999'999 - 1),
+        picoseconds(picoseconds::max_in_day + 5 - 999'999)};
+    assert(e == x);
+  }
+
+  /* iterators */
+  {
+    const epoch_range r(t0, ns(1'000'000'000L), 100);
+    auto it = r.begin();
+    assert(std::distance(r.begin(), r.end()) == 100);
+    it += 10;
+    assert(*it == r[10] && it[5] == r[15] && (it - r.begin()) == 10);
+    assert(*(it - 3) == r[7] && *(2 + it) == r[12]);
+    --it;
+    assert(it.index() == 9 && it < r.end() && r.end() > it);
+    std::vector<datetime<ns>> v(r.begin(), r.end());
+    assert(v.size() == 100 && std::is_sorted(v.begin(), v.end()));
+    bool thrown = false;
+    try {
+      r.at(100);
+    } catch (std::out_of_range &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  /* (start, stop, step) */
+  {
+    datetime<ns> t1(t0);
+    t1.add_seconds(ns(3'600'000'000'000L));
+    /* stop is excluded */
+    const epoch_range r1(t0, t1, ns(30'000'000'000L));
+    assert(r1.size() == 120);
+    assert(r1.back() < t1);
+    /* stop not on the grid */
+    t1.add_seconds(ns(1));
+    const epoch_range r2(t0, t1, ns(30'000'000'000L));
+    assert(r2.size() == 121);
+    /* backwards */
+    const epoch_range r3(t1, t0, ns(-30'000'000'000L));
+    assert(r3.size() == 121);
+    assert(r3.back() > t0);
+    /* not reachable */
+    const epoch_range r4(t1, t0, ns(30'000'000'000L));
+    assert(r4.empty() && r4.begin() == r4.end());
+    const epoch_range r5(t0, t0, ns(1));
+    assert(r5.empty());
+    bool thrown = false;
+    try {
+      const epoch_range r6(t0, t1, ns(0));
+    } catch (std::invalid_argument &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  /* TwoPartDate; no accumulated error */
+  {
+    const TwoPartDate s(t0);
+    const epoch_range r(s, ns(30'000'000'000L), 1'000'000);
+    const epoch_range rd(t0, ns(30'000'000'000L), 1'000'000);
+    for (std::size_t i = 0; i < r.size(); i += 997) {
+      const TwoPartDate exact(rd[i]);
+      assert(r[i].imjd() == exact.imjd());
+      assert(std::abs(r[i].seconds().seconds() - exact.seconds().seconds()) <
+             1e-10);
+    }
+    /* stop between grid points */
+    TwoPartDate s1(rd[1000]);
+    s1.add_seconds(FractionalSeconds(-15e0));
+    const epoch_range r2(s, s1, ns(30'000'000'000L));
+    assert(r2.size() == 1000);
+  }
+
+  /* UTC, across the leap second at the end of 2016 */
+  {
+    const datetime_utc<ns> u0(modified_julian_day(57753),
+                              ns(86'390'000'000'000L));
+    const epoch_range r(u0, ns(5'000'000'000L), 6);
+    datetime_utc<ns> t(u0);
+    for (std::size_t i = 0; i < r.size(); i++) {
+      assert(r[i] == t);
+      t.add_seconds(ns(5'000'000'000L));
+    }
+    /* 23:59:50, 23:59:55, 23:59:60, 00:00:04, ... */
+    assert(r[2].imjd() == modified_julian_day(57753) &&
+           r[2].sec() == ns(86'400'000'000'000L));
+    assert(r[3].imjd() == modified_julian_day(57754) &&
+           r[3].sec() == ns(4'000'000'000L));
+    const epoch_range r2(u0, r[5], ns(5'000'000'000L));
+    assert(r2.size() == 5);
+  }
+
+  return 0;
+}
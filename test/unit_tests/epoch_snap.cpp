@@ -0,0 +1,178 @@
+#include "calendar.hpp"
+#include "core/int128.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#ifndef DATETIME_HAS_INT128
+/* reference results are computed with 128-bit integers */
+int main() { return 0; }
+#else
+
+using namespace dso;
+using ns = nanoseconds;
+using i128 = core::int128_t;
+
+/* reference: snap total ticks x to a grid of iv ticks (brute force) */
+i128 ref_snap(i128 x, i128 iv, SnapMode m) {
+  i128 r = x % iv;
+  if (r < 0)
+    r += iv;
+  const i128 f = x - r;
+  if (m == SnapMode::Floor)
+    return f;
+  if (m == SnapMode::Ceil)
+    return r ? f + iv : f;
+  return (r <= iv - r) ? f : f + iv;
+}
+
+template <typename S> i128 ticks(const datetime<S> &t) {
+  return static_cast<i128>(t.imjd().as_underlying_type()) * S::max_in_day +
+         t.sec().as_underlying_type();
+}
+
+/* t - s in fractional seconds */
+double tpd_residual(const TwoPartDate &t, const TwoPartDate &s) {
+  return t.diff<DateTimeDifferenceType::FractionalSeconds>(s).seconds();
+}
+
+int main() {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int> mjds(-1000, 80000);
+  std::uniform_int_distribution<long> secs(0, ns::max_in_day - 1);
+  const SnapMode modes[] = {SnapMode::Floor, SnapMode::Ceil,
+                            SnapMode::Nearest};
+
+  /* datetime<ns>: scalar and batch against the brute-force reference, for
+   * intervals dividing the day, odd ones and ones larger than a day */
+  std::vector<datetime<ns>> t(10'000);
+  for (auto &e : t)
+    e = datetime<ns>(modified_julian_day(mjds(gen)), ns(secs(gen)));
+  t[0] = datetime<ns>(modified_julian_day(59000), ns(0));
+  t[1] = datetime<ns>(modified_julian_day(59000), ns(15'000'000'000L));
+  t[2] = datetime<ns>(modified_julian_day(59000), ns(ns::max_in_day - 1));
+  t[3] = datetime<ns>(modified_julian_day(-5), ns(7));
+  std::vector<datetime<ns>> s(t.size());
+  std::vector<ns> r(t.size());
+  for (long iv : {30'000'000'000L, 1L, 7L, 86'400'000'000'000L,
+                  123'456'789'011L, 3 * 86'400'000'000'000L + 11}) {
+    for (auto m : modes) {
+      snap_batch(t.data(), t.size(), ns(iv), m, s.data(), r.data());
+      for (std::size_t i = 0; i < t.size(); i++) {
+        const i128 x = ref_snap(ticks(t[i]), iv, m);
+        assert(ticks(s[i]) == x);
+        assert(s[i].sec() >= ns(0) && s[i].sec() < ns(ns::max_in_day));
+        assert(snap(t[i], ns(iv), m) == s[i]);
+        assert(r[i].as_underlying_type() == ticks(t[i]) - x);
+      }
+    }
+  }
+
+  /* nearest: ties go to the earlier epoch */
+  assert(snap(t[1], ns(30'000'000'000L)) ==
+         datetime<ns>(modified_julian_day(59000), ns(0)));
+  /* crossing a day boundary */
+  assert(snap(t[2], ns(30'000'000'000L), SnapMode::Ceil) ==
+         datetime<ns>(modified_julian_day(59001), ns(0)));
+
+  /* tolerance; scalar and batch (mask) */
+  {
+    const ns iv(30'000'000'000L);
+    const ns tol(1'000'000'000L);
+    std::vector<std::uint64_t> mask(batch_mask_words(t.size()));
+    const std::size_t count =
+        snap_batch(t.data(), t.size(), iv, SnapMode::Nearest, tol, s.data(),
+                   r.data(), mask.data());
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < t.size(); i++) {
+      datetime<ns> e;
+      const bool ok = snap(t[i], iv, SnapMode::Nearest, tol, e);
+      assert(e == s[i]);
+      assert(ok == batch_mask_test(mask.data(), i));
+      assert(ok == (std::abs(r[i].as_underlying_type()) <=
+                    tol.as_underlying_type()));
+      k += ok;
+    }
+    assert(count == k);
+    assert(k > 0 && k < t.size());
+  }
+
+  /* non-positive interval */
+  bool thrown = false;
+  try {
+    snap(t[0], ns(0));
+  } catch (std::invalid_argument &) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  /* TwoPartDate: against datetime<ns> for intervals that are exact in
+   * double (integral seconds), and by properties for the rest */
+  std::vector<TwoPartDate> tp(t.size());
+  for (std::size_t i = 0; i < t.size(); i++)
+    tp[i] = TwoPartDate(t[i]);
+  /* exact tie (the conversion above is not exact) */
+  tp[1] = TwoPartDate(59000, FractionalSeconds(15e0));
+  std::vector<TwoPartDate> sp(t.size());
+  std::vector<double> rp(t.size());
+  for (long iv : {30L, 1L, 7L, 86'400L, 3 * 86'400L + 11}) {
+    for (auto m : modes) {
+      snap_batch(tp.data(), tp.size(), FractionalSeconds((double)iv), m,
+                 sp.data(), rp.data());
+      for (std::size_t i = 0; i < t.size(); i++) {
+        const auto e = snap(t[i], ns(iv * 1'000'000'000L), m);
+        /* snapped epochs are at integral seconds */
+        if (!(sp[i].seconds().seconds() == (double)(e.sec().as_underlying_type() / 1000000000L))) fprintf(stderr,"iv=%ld m=%d i=%zu t=%d %.17g s=%d %.17g e=%ld\n", iv, (int)m, i, tp[i].imjd(), tp[i].seconds().seconds(), sp[i].imjd(), sp[i].seconds().seconds(), (long)e.sec().as_underlying_type());
+        assert(sp[i].imjd() == e.imjd().as_underlying_type());
+        assert(sp[i].seconds().seconds() ==
+               (double)(e.sec().as_underlying_type() / 1'000'000'000L));
+        assert(snap(tp[i], FractionalSeconds((double)iv), m) == sp[i]);
+        assert(std::abs(rp[i] - tpd_residual(tp[i], sp[i])) < 1e-9);
+      }
+    }
+  }
+  for (double iv : {0.1, 1.5, 0.3, 123.456, 100'000.7}) {
+    for (auto m : modes) {
+      snap_batch(tp.data(), tp.size(), FractionalSeconds(iv), m, sp.data(),
+                 rp.data());
+      for (std::size_t i = 0; i < t.size(); i++) {
+        const double x = rp[i];
+        assert(std::abs(x - tpd_residual(tp[i], sp[i])) < 1e-9);
+        if (m == SnapMode::Floor)
+          assert(x >= 0e0 && x < iv);
+        else if (m == SnapMode::Ceil)
+          assert(x <= 0e0 && x > -iv);
+        else
+          assert(std::abs(x) <= iv / 2 + 1e-9);
+        assert(snap(tp[i], FractionalSeconds(iv), m) == sp[i]);
+        /* snapping a snapped epoch is (almost) a no-op */
+        const auto again = snap(sp[i], FractionalSeconds(iv));
+        assert(std::abs(tpd_residual(again, sp[i])) < 1e-9);
+      }
+    }
+  }
+
+  /* TwoPartDate tolerance */
+  {
+    std::vector<std::uint64_t> mask(batch_mask_words(tp.size()));
+    const std::size_t count = snap_batch(
+        tp.data(), tp.size(), FractionalSeconds(30e0), SnapMode::Floor,
+        FractionalSeconds(5e0), sp.data(), rp.data(), mask.data());
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < tp.size(); i++) {
+      TwoPartDate e;
+      const bool ok = snap(tp[i], FractionalSeconds(30e0), SnapMode::Floor,
+                           FractionalSeconds(5e0), e);
+      assert(e == sp[i] && ok == batch_mask_test(mask.data(), i));
+      k += ok;
+    }
+    assert(count == k && k > 0 && k < tp.size());
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,117 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using namespace dso;
+using ns = nanoseconds;
+
+struct record {
+  datetime<ns> t;
+  int id;
+};
+
+int main() {
+  constexpr const int num = 300'000;
+  std::mt19937_64 gen(2019);
+  std::uniform_int_distribution<int> dmjd(-100, 70000);
+  std::uniform_int_distribution<long> dsec(0, ns::max_in_day - 1);
+  /* few distinct values, so that there are many ties */
+  std::uniform_int_distribution<long> dtie(0, 99);
+
+  std::vector<datetime<ns>> d;
+  std::vector<record> r;
+  for (int i = 0; i < num; i++) {
+    d.emplace_back(modified_julian_day(dmjd(gen)), ns(dsec(gen)));
+    r.push_back({datetime<ns>(modified_julian_day(59000 + dtie(gen) % 3),
+                              ns(dtie(gen) * 30'000'000'000L)),
+                 i});
+  }
+
+  /* datetime<S> arrays */
+  {
+    std::vector<datetime<ns>> ref(d);
+    std::sort(ref.begin(), ref.end());
+    std::vector<datetime<ns>> a(d), b(d);
+    radix_sort(a.data(), a.size());
+    parallel_radix_sort(b.data(), b.size(), 4);
+    assert(a == ref);
+    assert(b == ref);
+  }
+
+  /* records, by key; the sort must be stable */
+  {
+    const auto key = [](const record &x) { return x.t; };
+    std::vector<record> ref(r);
+    std::stable_sort(ref.begin(), ref.end(),
+                     [](const record &x, const record &y) { return x.t < y.t; });
+    std::vector<record> a(r), b(r);
+    radix_sort(a.data(), a.size(), key);
+    parallel_radix_sort(b.data(), b.size(), key, 3);
+    for (int i = 0; i < num; i++) {
+      assert(a[i].t == ref[i].t && a[i].id == ref[i].id);
+      assert(b[i].t == ref[i].t && b[i].id == ref[i].id);
+    }
+  }
+
+  /* TwoPartDate */
+  {
+    std::uniform_real_distribution<double> dfsec(0e0, 86400e0);
+    std::vector<TwoPartDate> t;
+    for (int i = 0; i < num; i++)
+      t.emplace_back(dmjd(gen), FractionalSeconds(dfsec(gen)));
+    t[7] = TwoPartDate(44244, FractionalSeconds(0e0));
+    std::vector<TwoPartDate> ref(t), a(t), b(t);
+    std::sort(ref.begin(), ref.end());
+    radix_sort(a.data(), a.size());
+    parallel_radix_sort(b.data(), b.size(), 4);
+    for (int i = 0; i < num; i++)
+      assert(a[i] == ref[i] && b[i] == ref[i]);
+  }
+
+  /* trivial inputs */
+  {
+    datetime<ns> one{modified_julian_day(1), ns(1)};
+    radix_sort(&one, 1);
+    radix_sort(&one, 0);
+    assert(one == datetime<ns>(modified_julian_day(1), ns(1)));
+    std::vector<datetime<ns>> same(1000, one);
+    parallel_radix_sort(same.data(), same.size(), 8);
+    assert(std::all_of(same.begin(), same.end(),
+                       [&](const datetime<ns> &x) { return x == one; }));
+  }
+
+  /* k-way merge of sorted streams */
+  {
+    const int k = 37;
+    std::vector<std::vector<record>> streams(k);
+    for (int i = 0; i < num; i++)
+      streams[(r[i].id * 7) % k].push_back(r[i]);
+    streams[5].clear();
+    std::vector<const record *> ptrs;
+    std::vector<std::size_t> sizes;
+    std::vector<record> ref;
+    for (auto &s : streams) {
+      std::stable_sort(s.begin(), s.end(), [](const record &x, const record &y) {
+        return x.t < y.t;
+      });
+      ptrs.push_back(s.data());
+      sizes.push_back(s.size());
+      ref.insert(ref.end(), s.begin(), s.end());
+    }
+    /* concatenated in stream order, hence stable sorting gives the merge */
+    std::stable_sort(ref.begin(), ref.end(),
+                     [](const record &x, const record &y) { return x.t < y.t; });
+    const auto key = [](const record &x) { return x.t; };
+    std::vector<record> a(ref.size()), b(ref.size());
+    merge_sorted(ptrs.data(), sizes.data(), k, a.data(), key);
+    parallel_merge_sorted(ptrs.data(), sizes.data(), k, b.data(), key, 4);
+    for (std::size_t i = 0; i < ref.size(); i++) {
+      assert(a[i].t == ref[i].t && a[i].id == ref[i].id);
+      assert(b[i].t == ref[i].t && b[i].id == ref[i].id);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+constexpr const long WEEK_NS = 7L * nanoseconds::max_in_day;
+
+/* GPS week 0 starts at TAI 1980/01/06 00:00:19 */
+static_assert(gnss2tai(gnss_wsow<gnss::gpst, seconds>{0, seconds(0)}) ==
+              datetime<seconds>(modified_julian_day(44244), seconds(19)));
+static_assert(tai2gnss<gnss::bdt>(datetime<seconds>(modified_julian_day(53736),
+                                                    seconds(33)))
+                  .week == 0);
+
+template <class Sys>
+void check_batch(const std::vector<datetime<nanoseconds>> &tai) {
+  const std::size_t n = tai.size();
+  std::vector<long> wk(n);
+  std::vector<nanoseconds> sow(n);
+  std::vector<datetime<nanoseconds>> back(n);
+  tai2gnss_batch<Sys>(tai.data(), wk.data(), sow.data(), n);
+  gnss2tai_batch<Sys>(wk.data(), sow.data(), back.data(), n);
+  std::vector<TwoPartDate> ttai(n), tback(n);
+  std::vector<long> twk(n);
+  std::vector<double> tsow(n);
+  for (std::size_t i = 0; i < n; i++)
+    ttai[i] = TwoPartDate(tai[i]);
+  tai2gnss_batch<Sys>(ttai.data(), twk.data(), tsow.data(), n);
+  gnss2tai_batch<Sys>(twk.data(), tsow.data(), tback.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    const auto w = tai2gnss<Sys>(tai[i]);
+    assert(w.week == wk[i] && w.sow == sow[i]);
+    assert(gnss2tai(w) == back[i]);
+    const auto tw = tai2gnss<Sys>(ttai[i]);
+    assert(tw.week == twk[i] && tw.sow.seconds() == tsow[i]);
+    const TwoPartDate t = gnss2tai(tw);
+    assert(t.imjd() == tback[i].imjd() &&
+           t.seconds().seconds() == tback[i].seconds().seconds());
+    /* fractional and integral versions agree */
+    assert(tw.week == w.week);
+    assert(std::abs(tw.sow.seconds() -
+                    to_fractional_seconds<nanoseconds>(w.sow).seconds()) <
+           1e-6);
+  }
+}
+
+int main() {
+  std::mt19937_64 gen(1980);
+  std::uniform_int_distribution<int> dmjd(44'300, 70'000);
+  std::uniform_int_distribution<long> dsec(0, nanoseconds::max_in_day - 1);
+
+  std::vector<datetime<nanoseconds>> epochs;
+  for (int i = 0; i < 200'000; i++) {
+    const datetime<nanoseconds> tai(modified_julian_day(dmjd(gen)),
+                                    nanoseconds(dsec(gen)));
+    epochs.push_back(tai);
+
+    /* GPS Time, against datetime<S>::gps_wsow */
+    nanoseconds gsow;
+    const long gwk = tai.tai2gps().gps_wsow(gsow).as_underlying_type();
+    const auto gps = tai2gnss<gnss::gpst>(tai);
+    assert(gps.week == gwk && gps.sow == gsow);
+    assert(gnss2tai(gps) == tai);
+    assert(gnss2tai(gps) ==
+           datetime<nanoseconds>(gps_week(gwk), gsow).gps2tai());
+
+    /* QZSS Time is aligned to GPS Time */
+    const auto qzs = tai2gnss<gnss::qzsst>(tai);
+    assert(qzs.week == gwk && qzs.sow == gsow);
+    assert(gnss2tai(qzs) == tai);
+
+    /* Galileo weeks start at GPS week 1024 */
+    const auto gal = tai2gnss<gnss::gst>(tai);
+    assert(gal.week == gwk - 1024 && gal.sow == gsow);
+    assert(gnss2tai(gal) == tai);
+
+    /* BeiDou Time is GPS Time - 14 [sec], weeks start at GPS week 1356 */
+    const auto bds = tai2gnss<gnss::bdt>(tai);
+    assert(bds.sow.as_underlying_type() >= 0 &&
+           bds.sow.as_underlying_type() < WEEK_NS);
+    assert(bds.week * WEEK_NS + bds.sow.as_underlying_type() ==
+           (gwk - 1356) * WEEK_NS + gsow.as_underlying_type() -
+               14'000'000'000L);
+    assert(gnss2tai(bds) == tai);
+
+    /* GLONASS Time is UTC + 3h */
+    const auto glo = tai2gnss<gnss::glonasst>(tai);
+    int extra;
+    const long fac = nanoseconds::sec_factor<long>();
+    long utcsec = tai.sec().as_underlying_type() -
+                  dat(tai.imjd(), extra) * fac;
+    long mjd = tai.imjd().as_underlying_type();
+    if (utcsec < 0) {
+      --mjd;
+      utcsec += nanoseconds::max_in_day -
+                (dat(modified_julian_day(mjd)) - dat(tai.imjd())) * fac;
+    }
+    if (utcsec < nanoseconds::max_in_day) {
+      const long glons =
+          (mjd - 44244) * nanoseconds::max_in_day + utcsec + 10800 * fac;
+      assert(glo.week * WEEK_NS + glo.sow.as_underlying_type() == glons);
+      assert(gnss2tai(glo) == tai);
+    }
+
+    /* fractional seconds */
+    const TwoPartDate ttai(tai);
+    const auto tgps = tai2gnss<gnss::gpst>(ttai);
+    assert(tgps.week == gwk);
+    assert(std::abs(tgps.sow.seconds() -
+                    to_fractional_seconds<nanoseconds>(gsow).seconds()) <
+           1e-6);
+    const TwoPartDate tback = gnss2tai(tgps);
+    assert(std::abs(tback.diff<DateTimeDifferenceType::FractionalSeconds>(ttai)
+                        .seconds()) < 1e-6);
+  }
+
+  /* GLONASS Time across the leap second inserted at 2016/12/31 */
+  {
+    using glo = gnss::glonasst;
+    const long fac = nanoseconds::sec_factor<long>();
+    /* UTC 2016/12/31 23:59:59 = 2017/01/01 02:59:59 GLONASS */
+    const datetime<nanoseconds> t1(modified_julian_day(57754),
+                                   nanoseconds(35 * fac));
+    const auto g1 = tai2gnss<glo>(t1);
+    assert((g1.week * WEEK_NS + g1.sow.as_underlying_type()) ==
+           (57754L - 44244) * nanoseconds::max_in_day + (3 * 3600 - 1) * fac);
+    assert(gnss2tai(g1) == t1);
+    /* UTC 2016/12/31 23:59:60.5 is mapped to 2017/01/01 03:00:00 */
+    const datetime<nanoseconds> t2(modified_julian_day(57754),
+                                   nanoseconds(36 * fac + fac / 2));
+    const auto g2 = tai2gnss<glo>(t2);
+    assert((g2.week * WEEK_NS + g2.sow.as_underlying_type()) ==
+           (57754L - 44244) * nanoseconds::max_in_day + 3 * 3600 * fac);
+    /* UTC 2017/01/01 00:00:00 */
+    const datetime<nanoseconds> t3(modified_julian_day(57754),
+                                   nanoseconds(37 * fac));
+    const auto g3 = tai2gnss<glo>(t3);
+    assert(g3.week == g2.week && g3.sow == g2.sow);
+    assert(gnss2tai(g3) == t3);
+    /* the same, using fractional seconds */
+    const auto f2 = tai2gnss<glo>(TwoPartDate(t2));
+    assert(f2.week == g2.week &&
+           f2.sow.seconds() ==
+               to_fractional_seconds<nanoseconds>(g2.sow).seconds());
+    const TwoPartDate f1 = gnss2tai(tai2gnss<glo>(TwoPartDate(t1)));
+    assert(f1.imjd() == 57754 && std::abs(f1.seconds().seconds() - 35) < 1e-9);
+  }
+
+  /* negative seconds of week are accepted */
+  assert(gnss2tai(gnss_wsow<gnss::gpst, seconds>{1, seconds(-1)}) ==
+         gnss2tai(gnss_wsow<gnss::gpst, seconds>{0, seconds(604799)}));
+
+  /* batch versions are identical to the scalar ones */
+  check_batch<gnss::gpst>(epochs);
+  check_batch<gnss::gst>(epochs);
+  check_batch<gnss::bdt>(epochs);
+  check_batch<gnss::qzsst>(epochs);
+  check_batch<gnss::glonasst>(epochs);
+
+  return 0;
+}
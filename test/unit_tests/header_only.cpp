@@ -0,0 +1,54 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+using namespace dso;
+
+#ifdef DATETIME_HEADER_ONLY
+/* in header-only mode, the calendar core can be evaluated at compile-time */
+static_assert(month("feb") == month(2));
+static_assert(month("SEPTEMBER") == month(9));
+static_assert(month(3).short_name()[0] == 'M');
+static_assert(ydoy_date(year(2024), day_of_year(60)).to_ymd().dm() ==
+              day_of_month(29));
+static_assert(ymd_date(year(2023), month(3), day_of_month(1)).to_ydoy().dy() ==
+              day_of_year(60));
+static_assert(ymd_date(ydoy_date(year(2024), day_of_year(366))).mn() ==
+              month(12));
+static_assert(modified_julian_day(60000).to_ydoy().dy() == day_of_year(56));
+static_assert(dat(modified_julian_day(60000)) == 37);
+#endif
+
+int main() {
+  /* month names, case-insensitive */
+  assert(month("Jan") == month(1));
+  assert(month("jAN") == month(1));
+  assert(month("december") == month(12));
+  assert(!std::strcmp(month(5).long_name(), "May"));
+  for (const char *str : {"", "Ja", "Janu", "Jann", "Januaryy"}) {
+    try {
+      month m(str);
+      assert(false);
+    } catch (std::invalid_argument &) {
+    }
+  }
+
+  /* ymd <-> ydoy, for every day of a leap and a non-leap year */
+  for (int iy : {2023, 2024}) {
+    for (int idoy = 1; idoy <= 365 + core::is_leap(iy); idoy++) {
+      const ydoy_date ydoy{year(iy), day_of_year(idoy)};
+      const ymd_date ymd(ydoy);
+      assert(ymd == ydoy.to_ymd());
+      assert(ymd.to_ydoy() == ydoy);
+      assert(modified_julian_day(ymd).to_ydoy() == ydoy);
+    }
+  }
+  try {
+    ymd_date ymd(ydoy_date(year(2023), day_of_year(366)));
+    assert(false);
+  } catch (std::invalid_argument &) {
+  }
+
+  return 0;
+}
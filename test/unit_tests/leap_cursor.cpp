@@ -0,0 +1,94 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+constexpr const int MIN_MJD = 41317;
+constexpr const int MAX_MJD = 61406 + 100;
+constexpr const long num_tests = 100'000;
+
+int main() {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> mjdstr(MIN_MJD, MAX_MJD);
+  /* leave room for negative steps */
+  std::uniform_int_distribution<> mjdstr2(MIN_MJD + 5, MAX_MJD);
+  std::uniform_real_distribution<double> secstr(0e0, 86400e0);
+  std::uniform_real_distribution<double> stepstr(-3 * 86400e0, 10 * 86400e0);
+
+  /* ΔAT via cursor for every MJD, forward and backward */
+  {
+    LeapCursor cursor;
+    for (int mjd = MIN_MJD; mjd <= MAX_MJD; mjd++) {
+      int e1, e2;
+      assert(cursor.dat(mjd, e1) == dat(modified_julian_day(mjd), e2));
+      assert(e1 == e2);
+    }
+    for (int mjd = MAX_MJD; mjd >= MIN_MJD; mjd--) {
+      int e1, e2;
+      assert(cursor.dat(mjd, e1) == dat(modified_julian_day(mjd), e2));
+      assert(e1 == e2);
+      assert(cursor.dat(mjd) == dat(modified_julian_day(mjd)));
+    }
+  }
+
+  /* random (non-monotonic) MJDs */
+  {
+    LeapCursor cursor;
+    for (long i = 0; i < num_tests; i++) {
+      const int mjd = mjdstr(gen);
+      int e1, e2;
+      assert(cursor.dat(mjd, e1) == dat(modified_julian_day(mjd), e2));
+      assert(e1 == e2);
+    }
+  }
+
+  /* TwoPartDateUTC: utc2tai, diff and add_seconds via cursor */
+  {
+    std::vector<int> mjds(num_tests);
+    std::generate(mjds.begin(), mjds.end(), [&]() { return mjdstr2(gen); });
+    std::sort(mjds.begin(), mjds.end());
+    LeapCursor cursor;
+    TwoPartDateUTC prev(mjds[0], FractionalSeconds(secstr(gen)));
+    for (const int mjd : mjds) {
+      const TwoPartDateUTC d(mjd, FractionalSeconds(secstr(gen)));
+      const auto tai1 = d.utc2tai(cursor);
+      const auto tai2 = d.utc2tai();
+      assert(tai1.imjd() == tai2.imjd());
+      assert(tai1.seconds().seconds() == tai2.seconds().seconds());
+
+      const auto diff1 = d.diff(prev, cursor);
+      const auto diff2 = d - prev;
+      assert(diff1.imjd() == diff2.imjd());
+      assert(diff1.seconds().seconds() == diff2.seconds().seconds());
+
+      auto d1 = d;
+      auto d2 = d;
+      const double step = stepstr(gen);
+      d1.add_seconds(FractionalSeconds(step), cursor);
+      d2.add_seconds(FractionalSeconds(step));
+      assert(d1 == d2);
+      prev = d;
+    }
+  }
+
+  /* datetime_utc: normalize via cursor */
+  {
+    LeapCursor cursor;
+    std::uniform_int_distribution<long> nsecstr(0, 10 * nanoseconds::max_in_day);
+    for (long i = 0; i < num_tests; i++) {
+      datetime_utc<nanoseconds> d1(modified_julian_day(mjdstr(gen)),
+                                   nanoseconds(nsecstr(gen)));
+      auto d2 = d1;
+      const nanoseconds step(nsecstr(gen));
+      d1.add_seconds(step, cursor);
+      d2.add_seconds(step);
+      assert(d1 == d2);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include "calendar.hpp"
+#include "leap_seconds.hpp"
+#include <cassert>
+#include <cstdio>
+
+using namespace dso;
+
+constexpr const char *iers_fn = "leap_second_table_iers.dat";
+constexpr const char *usno_fn = "leap_second_table_usno.dat";
+
+/* write an IERS Leap_Second.dat file; optionally add a (fictitious) leap
+ * second at 2027/01/01 (MJD 61406)
+ */
+void write_iers(bool add_2027) {
+  FILE *fp = std::fopen(iers_fn, "w");
+  assert(fp);
+  std::fprintf(fp, "#  Value of TAI-UTC in second valid beetween the initial "
+                   "value until the epoch given on the next line.\n");
+  std::fprintf(fp, "#  File expires on %s\n",
+               add_2027 ? "28 June 2027" : "28 June 2026");
+  std::fprintf(fp, "#\n#    MJD        Date        TAI-UTC (s)\n"
+                   "#           day month year\n"
+                   "#    ---    --------------   ------\n#\n");
+  for (const auto &c : LeapSecondTable::builtin().changes()) {
+    const auto ymd = core::mjd2ymd(c.mjd);
+    std::fprintf(fp, "    %d.0    %d %2d %d       %d\n", c.mjd,
+                 ymd.dm().as_underlying_type(), ymd.mn().as_underlying_type(),
+                 ymd.yr().as_underlying_type(), c.delat);
+  }
+  if (add_2027)
+    std::fprintf(fp, "    61406.0    1  1 2027       38\n");
+  std::fclose(fp);
+}
+
+/* write a USNO tai-utc.dat file (including some pre-1972 entries) */
+void write_usno() {
+  FILE *fp = std::fopen(usno_fn, "w");
+  assert(fp);
+  std::fprintf(fp, " 1968 FEB  1 =JD 2439887.5  TAI-UTC=   4.2131700 S + "
+                   "(MJD - 39126.) X 0.002592 S\n");
+  for (const auto &c : LeapSecondTable::builtin().changes()) {
+    const auto ymd = core::mjd2ymd(c.mjd);
+    std::fprintf(fp,
+                 " %d %s %2d =JD %.1f  TAI-UTC=  %d.0       S + (MJD - "
+                 "41317.) X 0.0      S\n",
+                 ymd.yr().as_underlying_type(), ymd.mn().short_name(),
+                 ymd.dm().as_underlying_type(), c.mjd + MJD0_JD, c.delat);
+  }
+  std::fclose(fp);
+}
+
+int main() {
+  /* the built-in table is used by default */
+  assert(leap_seconds::current() == &LeapSecondTable::builtin());
+  assert(dat(modified_julian_day(61406)) == 37);
+
+  /* the built-in table should match the (constexpr) leap insertion days */
+  for (int mjd = 41317 - 5; mjd < 61406 + 5; mjd++) {
+    assert(LeapSecondTable::builtin().is_leap_insertion_day(mjd) ==
+           core::builtin_is_leap_insertion_day(mjd));
+  }
+
+  /* the dense table should match a search of the changes, in and out of its
+   * range */
+  {
+    const auto &ch = LeapSecondTable::builtin().changes();
+    for (int mjd = 41317; mjd < core::BUILTIN_LEAP_SECONDS_EXPIRY_MJD + 500;
+         mjd++) {
+      int delat = ch.front().delat, extra = 0;
+      for (std::size_t i = 0; i < ch.size(); i++) {
+        if (mjd >= ch[i].mjd)
+          delat = ch[i].delat;
+        if (mjd == ch[i].mjd - 1)
+          extra = ch[i].delat - ch[i - 1].delat;
+      }
+      int e;
+      assert(LeapSecondTable::builtin().dat(mjd, e) == delat && e == extra);
+      assert(LeapSecondTable::builtin().dat(mjd) == delat);
+    }
+  }
+
+  /* calendar and MJD ΔAT should agree */
+  for (int mjd = 41317; mjd < 61406 + 5; mjd++) {
+    const auto ymd = modified_julian_day(mjd).to_ymd();
+    assert(dat(modified_julian_day(mjd)) == dat(ymd.yr(), ymd.mn()));
+  }
+
+  /* parse the USNO file; should match the built-in table */
+  write_usno();
+  {
+    auto t = LeapSecondTable::from_file(usno_fn);
+    assert(t == LeapSecondTable::builtin());
+    assert(t.expiry_mjd() == 57754);
+  }
+
+  /* load an IERS file; should match the built-in table */
+  write_iers(false);
+  const auto *t0 = leap_seconds::load(iers_fn);
+  assert(*t0 == LeapSecondTable::builtin());
+  assert(t0->expiry_mjd() == core::BUILTIN_LEAP_SECONDS_EXPIRY_MJD);
+  assert(leap_seconds::current() == t0);
+
+  /* nothing changed in the file; no reload */
+  assert(!leap_seconds::reload());
+  assert(leap_seconds::current() == t0);
+
+  /* file is updated with a new leap second; reload */
+  write_iers(true);
+  assert(leap_seconds::reload());
+  const auto *t1 = leap_seconds::current();
+  assert(t1 != t0);
+  assert(t1->expiry_mjd() == core::cal2mjd(2027, 6, 28));
+
+  /* the old snapshot is still valid */
+  assert(t0->dat(61406) == 37);
+
+  /* all ΔAT computations now use the new table */
+  int extra;
+  assert(dat(modified_julian_day(61406)) == 38);
+  assert(dat(modified_julian_day(61405)) == 37);
+  assert(dat(modified_julian_day(61405), extra) == 37 && extra == 1);
+  assert(dat(modified_julian_day(61404), extra) == 37 && extra == 0);
+  assert(dat(year(2027), month(1)) == 38);
+  assert(dat(year(2026), month(12)) == 37);
+  assert(modified_julian_day(61405).is_leap_insertion_day());
+  assert(!modified_julian_day(61406).is_leap_insertion_day());
+
+  /* compile-time computations still use the built-in table */
+  static_assert(!modified_julian_day(61405).is_leap_insertion_day());
+  static_assert(modified_julian_day(57753).is_leap_insertion_day());
+
+  /* invalid tables are rejected; the current table is kept */
+  try {
+    LeapSecondTable t({{41317, 10}, {41500, 11}}, 41600);
+    assert(false);
+  } catch (std::invalid_argument &) {
+    ;
+  }
+  try {
+    leap_seconds::load("no_such_leap_second_file.dat");
+    assert(false);
+  } catch (std::runtime_error &) {
+    ;
+  }
+  assert(leap_seconds::current() == t1);
+
+  /* revert to the built-in table */
+  leap_seconds::install(LeapSecondTable::builtin());
+  assert(dat(modified_julian_day(61406)) == 37);
+
+  std::remove(iers_fn);
+  std::remove(usno_fn);
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+static_assert(sizeof(linear_time<seconds>::tick_type) == 8);
+static_assert(sizeof(linear_time<nanoseconds>::tick_type) == 8);
+#ifdef DATETIME_HAS_INT128
+static_assert(sizeof(linear_time<picoseconds>::tick_type) == 16);
+#endif
+
+/* the epoch */
+static_assert(linear_time<seconds>(datetime<seconds>(modified_julian_day(51544),
+                                                     seconds(0)))
+                  .ticks() == 0);
+static_assert(linear_time<seconds>(-1).to_datetime() ==
+              datetime<seconds>(modified_julian_day(51543), seconds(86399)));
+
+template <typename S> void check(int mjd_min, int mjd_max, int num) {
+  std::mt19937_64 gen(2000);
+  std::uniform_int_distribution<int> dmjd(mjd_min, mjd_max);
+  std::uniform_int_distribution<typename S::underlying_type> dsec(
+      0, S::max_in_day - 1);
+  std::uniform_int_distribution<typename S::underlying_type> dadd(
+      -3 * S::max_in_day, 3 * S::max_in_day);
+
+  std::vector<datetime<S>> d;
+  std::vector<linear_time<S>> l;
+  for (int i = 0; i < num; i++) {
+    const datetime<S> t(modified_julian_day(dmjd(gen)), S(dsec(gen)));
+    const linear_time<S> lt(t);
+    /* lossless round trip */
+    assert(lt.to_datetime() == t);
+    assert(linear_time<S>(lt.to_datetime()) == lt);
+    /* addition, against datetime<S> */
+    const S s(dadd(gen));
+    datetime<S> t2(t);
+    t2.add_seconds(s);
+    assert((lt + s).to_datetime() == t2);
+    assert(((lt + s) - s) == lt);
+    linear_time<S> lt2(lt);
+    lt2 += s;
+    assert(lt2 == lt + s);
+    lt2 -= s;
+    assert(lt2 == lt);
+    /* difference, in ticks */
+    assert(static_cast<typename S::underlying_type>((lt + s) - lt) ==
+           s.as_underlying_type());
+    d.push_back(t);
+    l.push_back(lt);
+  }
+
+  /* comparisons agree with datetime<S> */
+  for (int i = 1; i < num; i++) {
+    assert((d[i] < d[i - 1]) == (l[i] < l[i - 1]));
+    assert((d[i] <= d[i - 1]) == (l[i] <= l[i - 1]));
+    assert((d[i] > d[i - 1]) == (l[i] > l[i - 1]));
+    assert((d[i] >= d[i - 1]) == (l[i] >= l[i - 1]));
+    assert((d[i] == d[i - 1]) == (l[i] == l[i - 1]));
+    assert((d[i] != d[i - 1]) == (l[i] != l[i - 1]));
+  }
+
+  /* sorting */
+  std::sort(d.begin(), d.end());
+  std::sort(l.begin(), l.end());
+  for (int i = 0; i < num; i++)
+    assert(l[i].to_datetime() == d[i]);
+}
+
+int main() {
+  check<seconds>(-1'000'000, 1'000'000, 100'000);
+  check<milliseconds>(-1'000'000, 1'000'000, 100'000);
+  check<microseconds>(-100'000, 100'000, 100'000);
+  /* ~+/-270 years around 2000 */
+  check<nanoseconds>(51544 - 100'000, 51544 + 100'000, 100'000);
+#ifdef DATETIME_HAS_INT128
+  /* picoseconds; limited by datetime<picoseconds>::max_days_allowed */
+  check<picoseconds>(51544 - 100, 51544 + 100, 100'000);
+
+  /* picoseconds far from the epoch (128-bit ticks) */
+  const datetime<picoseconds> t(modified_julian_day(88069),
+                                picoseconds(86399'999'999'999'999L));
+  const linear_time<picoseconds> lt(t);
+  assert(lt.to_datetime() == t);
+  assert(lt.ticks() > std::numeric_limits<std::int64_t>::max());
+  assert((lt + picoseconds(1)).to_datetime() ==
+         datetime<picoseconds>(modified_julian_day(88070), picoseconds(0)));
+#endif
+
+  /* differences in fractional seconds */
+  const linear_time<nanoseconds> a(
+      datetime<nanoseconds>(modified_julian_day(60000), nanoseconds(1)));
+  const linear_time<nanoseconds> b(
+      datetime<nanoseconds>(modified_julian_day(59999), nanoseconds(0)));
+  assert(a.diff_sec(b) == 86400.000000001);
+  assert(b.diff_sec(a) == -86400.000000001);
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include "calendar.hpp"
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace dso;
+using DT = DateTimeDifferenceType;
+
+int main() {
+  std::mt19937_64 gen(11);
+  std::uniform_int_distribution<int> mjds(40000, 70000);
+  std::uniform_real_distribution<double> secs(0e0, 86400e0);
+  std::uniform_real_distribution<double> steps(-3 * 86400e0, 3 * 86400e0);
+  constexpr const std::size_t n = 5'000;
+
+  std::vector<TwoPartDate> t(n);
+  for (auto &e : t)
+    e = TwoPartDate(mjds(gen), FractionalSeconds(secs(gen)));
+  /* near day boundaries */
+  t[0] = TwoPartDate(59000, FractionalSeconds(0e0));
+  t[1] = TwoPartDate(59000, FractionalSeconds(std::nextafter(86400e0, 0e0)));
+  t[2] = TwoPartDate(59000, FractionalSeconds(1e-12));
+
+  tpdate_column col(t.data(), n);
+  assert(col.size() == n);
+  for (std::size_t i = 0; i < n; i++)
+    assert(col[i].value() == t[i]);
+
+  /* add_seconds: same step, per-element steps; bit-identical to scalar */
+  for (double s : {30e0, -30e0, 86400e0, -86400e0, 1e-9, -1e-9, 1e-12,
+                   -1e-12, 123456.789, -3 * 86400e0 - 0.5}) {
+    col.add_seconds(FractionalSeconds(s));
+    for (std::size_t i = 0; i < n; i++) {
+      t[i].add_seconds(FractionalSeconds(s));
+      assert(col[i].value() == t[i]);
+      assert(col.sec_data()[i] >= 0e0 && col.sec_data()[i] < 86400e0);
+    }
+  }
+  std::vector<double> ds(n);
+  for (int k = 0; k < 10; k++) {
+    for (auto &e : ds)
+      e = steps(gen);
+    ds[0] = -t[0].seconds().seconds() - 1e-300;
+    col.add_seconds(ds.data());
+    for (std::size_t i = 0; i < n; i++) {
+      t[i].add_seconds(FractionalSeconds(ds[i]));
+      assert(col[i].value() == t[i]);
+    }
+  }
+
+  /* normalize raw (out of range) values; intervals keep negative seconds
+   * only if the whole days sum to zero */
+  {
+    tpdate_column c(n);
+    for (std::size_t i = 0; i < n; i++) {
+      c.mjd_data()[i] = (i % 3) ? mjds(gen) : 0;
+      c.sec_data()[i] = steps(gen);
+    }
+    c.mjd_data()[0] = 0;
+    c.sec_data()[0] = -0.5;
+    c.mjd_data()[1] = 1;
+    c.sec_data()[1] = -0.5;
+    c.mjd_data()[2] = 2;
+    c.sec_data()[2] = -1e-20;
+    std::vector<TwoPartDate> r(n);
+    for (std::size_t i = 0; i < n; i++)
+      r[i] =
+          TwoPartDate(c.mjd_data()[i], FractionalSeconds(c.sec_data()[i]));
+    c.normalize();
+    for (std::size_t i = 0; i < n; i++)
+      assert(c[i].value() == r[i]);
+    const tpdate_column &cc = c;
+    assert(cc[0].imjd() == 0 && cc[0].seconds().seconds() == -0.5);
+    assert(cc[1].imjd() == 0 && cc[1].seconds().seconds() == 86399.5);
+    /* rounds up to 86400; wraps to the next day */
+    assert(cc[2].imjd() == 2 && cc[2].seconds().seconds() == 0e0);
+  }
+
+  /* diffs; bit-identical to scalar */
+  {
+    const TwoPartDate ref(51544, FractionalSeconds(43200e0));
+    std::vector<double> d(n);
+    col.diff<DT::FractionalSeconds>(ref, d.data());
+    for (std::size_t i = 0; i < n; i++)
+      assert(d[i] == t[i].diff<DT::FractionalSeconds>(ref).seconds());
+    col.diff<DT::FractionalDays>(ref, d.data());
+    for (std::size_t i = 0; i < n; i++)
+      assert(d[i] == t[i].diff<DT::FractionalDays>(ref).days());
+    col.diff<DT::FractionalYears>(ref, d.data());
+    for (std::size_t i = 0; i < n; i++)
+      assert(d[i] == t[i].diff<DT::FractionalYears>(ref).years());
+    tpdate_column other(n, ref);
+    other.add_seconds(ds.data());
+    col.diff<DT::FractionalSeconds>(other, d.data());
+    for (std::size_t i = 0; i < n; i++)
+      assert(d[i] == t[i].diff<DT::FractionalSeconds>(other[i]).seconds());
+  }
+
+  /* container basics */
+  {
+    tpdate_column c;
+    assert(c.empty());
+    c.push_back(t[5]);
+    c.push_back(t[6]);
+    c[0] = c[1];
+    assert(c.size() == 2 && c[0].value() == t[6]);
+    std::vector<TwoPartDate> back(2);
+    c.to_dates(back.data());
+    assert(back[1] == t[6]);
+    c.clear();
+    assert(c.empty());
+  }
+
+  return 0;
+}
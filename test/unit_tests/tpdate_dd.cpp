@@ -0,0 +1,134 @@
+#include "calendar.hpp"
+#include "core/int128.hpp"
+#include <cassert>
+#include <cmath>
+#include <random>
+
+#ifndef DATETIME_HAS_INT128
+/* reference results are computed with 128-bit integers */
+int main() { return 0; }
+#else
+
+using namespace dso;
+using ps = picoseconds;
+using i128 = core::int128_t;
+
+/* total picoseconds of a datetime<ps> */
+i128 ticks(const datetime<ps> &t) {
+  return static_cast<i128>(t.imjd().as_underlying_type()) * ps::max_in_day +
+         t.sec().as_underlying_type();
+}
+
+/* |x - (w + f * 1e-12)| in seconds, for a difference of w whole seconds and
+ * f picoseconds */
+double error(const DoubleDouble &x, long w, long f) {
+  const DoubleDouble e = (x - static_cast<double>(w)) -
+                         DoubleDouble(static_cast<double>(f)) / 1e12;
+  return std::abs(e.to_double());
+}
+
+int main() {
+  /* DoubleDouble basics */
+  {
+    const DoubleDouble a = DoubleDouble::sum(1e0, 1e-20);
+    assert(a.hi() == 1e0 && a.lo() == 1e-20);
+    assert((a - 1e0).to_double() == 1e-20);
+    assert(a > 1e0 && DoubleDouble(1e0) < a && a != DoubleDouble(1e0));
+    const DoubleDouble third = DoubleDouble(1e0) / 3e0;
+    assert(std::abs((third * 3e0 - 1e0).to_double()) < 1e-30);
+    int q;
+    const DoubleDouble r =
+        core::fmod_quo(DoubleDouble::sum(3 * 86400e0, 1e-20), 86400e0, q);
+    assert(q == 3 && r.hi() == 1e-20);
+    const DoubleDouble rn =
+        core::fmod_quo(DoubleDouble::sum(-86400e0, -1e-20), 86400e0, q);
+    assert(q == -1 && rn.hi() == -1e-20);
+  }
+
+  std::mt19937_64 gen(7);
+  std::uniform_int_distribution<int> mjds(40000, 70000);
+  std::uniform_int_distribution<long> secs(0, ps::max_in_day - 1);
+
+  /* diff_seconds against exact differences (in picoseconds), for epochs
+   * decades apart */
+  for (int i = 0; i < 10'000; i++) {
+    const datetime<ps> a(modified_julian_day(mjds(gen)), ps(secs(gen)));
+    const datetime<ps> b(modified_julian_day(mjds(gen)), ps(secs(gen)));
+    const TwoPartDateDD ta(a), tb(b);
+    const i128 d = ticks(a) - ticks(b);
+    const long w = static_cast<long>(d / 1'000'000'000'000L);
+    const long f = static_cast<long>(d % 1'000'000'000'000L);
+    assert(error(ta.diff_seconds(tb), w, f) < 1e-18);
+    /* rounded to double; same as the double version, up to its resolution */
+    const TwoPartDate pa(a), pb(b);
+    assert(std::abs(
+               ta.diff<DateTimeDifferenceType::FractionalSeconds>(tb)
+                   .seconds() -
+               pa.diff<DateTimeDifferenceType::FractionalSeconds>(pb)
+                   .seconds()) < 1e-6);
+    /* operator- and operator+ */
+    const TwoPartDateDD dt = ta - tb;
+    const TwoPartDateDD back = tb + dt;
+    assert(back.imjd() == ta.imjd());
+    assert(std::abs((back.seconds_rep() - ta.seconds_rep()).to_double()) <
+           1e-18);
+    /* normalization of intervals is the same as for the double version */
+    const TwoPartDate pdt = pa - pb;
+    assert(dt.imjd() == pdt.imjd() ||
+           std::abs(dt.seconds().seconds() - pdt.seconds().seconds()) >
+               86399e0);
+  }
+
+  /* add_seconds: many (tiny) steps, error-free to sub-picosecond */
+  {
+    const datetime<nanoseconds> t0(modified_julian_day(59000),
+                                   nanoseconds(86'399'999'000'000L));
+    TwoPartDateDD t(t0);
+    TwoPartDate td(t0);
+    constexpr const long n = 2'000'000;
+    for (long i = 0; i < n; i++) {
+      t.add_seconds(FractionalSeconds(1e-9));
+      td.add_seconds(FractionalSeconds(1e-9));
+    }
+    /* crossed a day; now at 1e-3 sec */
+    assert(t.imjd() == 59001 && td.imjd() == 59001);
+    const double err_dd = error(t.seconds_rep(), 0, 1'000'000'000L);
+    const double err_d = error(td.seconds().seconds(), 0, 1'000'000'000L);
+    assert(err_dd < 1e-15);
+    assert(err_dd < err_d);
+    t.add_seconds(FractionalSeconds(-86400e0 * 3));
+    assert(t.imjd() == 58998);
+    assert(error(t.seconds_rep(), 0, 1'000'000'000L) < 1e-15);
+  }
+
+  /* round trip through a datetime<ps> and other epochs/accessors */
+  {
+    const datetime<ps> a(modified_julian_day(60000),
+                         ps(43'200'000'000'000'001L));
+    const TwoPartDateDD t(a);
+    assert(t.imjd() == 60000 && t.seconds().seconds() == 43200e0);
+    assert(error(t.seconds_rep(), 43200, 1) < 1e-24);
+    assert(t.as_mjd() == TwoPartDate(a).as_mjd());
+    assert(std::abs(t.jcenturies_sinceJ2000() -
+                    TwoPartDate(a).jcenturies_sinceJ2000()) < 1e-15);
+    const auto tt = t.tai2tt();
+    assert(std::abs(tt.diff_seconds(t).to_double() - TT_MINUS_TAI) < 1e-20);
+    assert(std::abs(tt.tt2tai().diff_seconds(t).to_double()) < 1e-20);
+  }
+
+  /* long double */
+  {
+    const datetime<nanoseconds> a(modified_julian_day(60000),
+                                  nanoseconds(1'000'000'001L));
+    TwoPartDateLD t(a);
+    assert(t.imjd() == 60000);
+    t.add_seconds(FractionalSeconds(-2e0));
+    assert(t.imjd() == 59999);
+    assert(std::abs(static_cast<double>(t.seconds_rep() - 86399.000000001L)) <
+           1e-12);
+  }
+
+  return 0;
+}
+
+#endif
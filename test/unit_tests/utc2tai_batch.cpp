@@ -0,0 +1,85 @@
+#include "calendar.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace dso;
+
+int main() {
+  std::mt19937_64 gen(13);
+  /* 1972 to ~2030 */
+  std::uniform_int_distribution<int> mjds(41317, 62502);
+  std::uniform_real_distribution<double> secs(0e0, 86400e0);
+  constexpr const std::size_t n = 100'000;
+
+  std::vector<TwoPartDateUTC> utc(n);
+  for (auto &e : utc)
+    e = TwoPartDateUTC(mjds(gen), FractionalSeconds(secs(gen)));
+  /* around a leap second; 2016/12/31 (MJD 57753) is 86401 sec long */
+  utc[0] = TwoPartDateUTC(57753, FractionalSeconds(86399.5e0));
+  utc[1] = TwoPartDateUTC(57753, FractionalSeconds(86400.5e0));
+  utc[2] = TwoPartDateUTC(57754, FractionalSeconds(0e0));
+  utc[3] = TwoPartDateUTC(57754, FractionalSeconds(0.5e0));
+
+  /* random and time-ordered input */
+  for (int order = 0; order < 2; order++) {
+    if (order)
+      std::sort(utc.begin(), utc.end());
+
+    std::vector<TwoPartDate> tai(n), tt(n), ptai(n), ptt(n);
+    utc2tai_batch(utc.data(), n, tai.data());
+    utc2tt_batch(utc.data(), n, tt.data());
+    parallel_utc2tai_batch(utc.data(), n, ptai.data(), 4);
+    parallel_utc2tt_batch(utc.data(), n, ptt.data(), 4);
+    for (std::size_t i = 0; i < n; i++) {
+      assert(tai[i] == utc[i].utc2tai());
+      assert(tt[i] == utc[i].utc2tt());
+      assert(ptai[i] == tai[i] && ptt[i] == tt[i]);
+      /* TT = TAI + 32.184 sec */
+      assert(std::abs(tt[i].diff<DateTimeDifferenceType::FractionalSeconds>(
+                          tai[i])
+                          .seconds() -
+                      TT_MINUS_TAI) < 1e-9);
+    }
+
+    std::vector<TwoPartDateUTC> back(n), pback(n);
+    tai2utc_batch(tai.data(), n, back.data());
+    parallel_tai2utc_batch(tai.data(), n, pback.data(), 4);
+    for (std::size_t i = 0; i < n; i++) {
+      assert(back[i] == tai[i].tai2utc());
+      assert(pback[i] == back[i]);
+      assert(back[i].imjd() == utc[i].imjd());
+      assert(std::abs(back[i].seconds().seconds() -
+                      utc[i].seconds().seconds()) < 1e-9);
+    }
+
+    std::vector<TwoPartDate> gps(n);
+    for (std::size_t i = 0; i < n; i++)
+      gps[i] = tai[i].tai2gps();
+    gps2utc_batch(gps.data(), n, back.data());
+    parallel_gps2utc_batch(gps.data(), n, pback.data(), 3);
+    for (std::size_t i = 0; i < n; i++) {
+      assert(back[i] == gps[i].gps2utc());
+      assert(pback[i] == back[i]);
+    }
+  }
+
+  /* the leap second */
+  {
+    TwoPartDate tai[2];
+    const TwoPartDateUTC u[2] = {
+        TwoPartDateUTC(57753, FractionalSeconds(86400.5e0)),
+        TwoPartDateUTC(57754, FractionalSeconds(0.5e0))};
+    utc2tai_batch(u, 2, tai);
+    assert(tai[0].imjd() == 57754 && tai[0].seconds().seconds() == 36.5e0);
+    assert(tai[1].imjd() == 57754 && tai[1].seconds().seconds() == 37.5e0);
+  }
+
+  /* empty input */
+  utc2tai_batch(nullptr, 0, nullptr);
+  parallel_tai2utc_batch(nullptr, 0, nullptr, 4);
+
+  return 0;
+}